@@ -4,10 +4,11 @@ const common = require('../common.js');
 
 const bench = common.createBenchmark(main, {
   len: [64, 1024],
+  op: ['decode', 'encode'],
   n: [1e6]
 });
 
-function main({ len, n }) {
+function main({ len, op, n }) {
   const buf = Buffer.alloc(len);
 
   for (let i = 0; i < buf.length; i++)
@@ -17,8 +18,13 @@ function main({ len, n }) {
 
   bench.start();
 
-  for (let i = 0; i < n; i += 1)
-    Buffer.from(hex, 'hex');
+  if (op === 'decode') {
+    for (let i = 0; i < n; i += 1)
+      Buffer.from(hex, 'hex');
+  } else {
+    for (let i = 0; i < n; i += 1)
+      buf.toString('hex');
+  }
 
   bench.end(n);
 }
@@ -21,10 +21,11 @@ const bench = common.createBenchmark(main, {
   search: searchStrings,
   encoding: ['utf8', 'ucs2'],
   type: ['buffer', 'string'],
+  method: ['indexOf', 'lastIndexOf'],
   n: [5e4]
 });
 
-function main({ n, search, encoding, type }) {
+function main({ n, search, encoding, type, method }) {
   let aliceBuffer = fs.readFileSync(
     path.resolve(__dirname, '../fixtures/alice.html')
   );
@@ -41,9 +42,11 @@ function main({ n, search, encoding, type }) {
     search = Buffer.from(Buffer.from(search).toString(), encoding);
   }
 
+  const byteOffset = method === 'indexOf' ? 0 : aliceBuffer.length;
+
   bench.start();
   for (let i = 0; i < n; i++) {
-    aliceBuffer.indexOf(search, 0, encoding);
+    aliceBuffer[method](search, byteOffset, encoding);
   }
   bench.end(n);
 }
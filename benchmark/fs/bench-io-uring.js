@@ -0,0 +1,56 @@
+// Compare asynchronous fs requests that go through io_uring with those that
+// go through the libuv threadpool. Where io_uring is not available, both
+// configurations use the threadpool.
+'use strict';
+
+const common = require('../common.js');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  io: ['threadpool', 'io_uring'],
+  op: ['read', 'write', 'stat', 'open-close'],
+  concurrent: [1, 16, 128],
+  n: [1e5],
+}, { flags: ['--expose-internals'] });
+
+function main({ io, op, concurrent, n }) {
+  common.binding('fs').useIoUring(io === 'io_uring');
+
+  tmpdir.refresh();
+  const filename = path.join(tmpdir.path, 'bench-io-uring');
+  fs.writeFileSync(filename, Buffer.alloc(64 * 1024, 'x'));
+  const fd = fs.openSync(filename, 'r+');
+  const buffer = Buffer.alloc(4096);
+
+  const ops = {
+    'read': (cb) => fs.read(fd, buffer, 0, buffer.length, 0, cb),
+    'write': (cb) => fs.write(fd, buffer, 0, buffer.length, 0, cb),
+    'stat': (cb) => fs.stat(filename, cb),
+    'open-close': (cb) => fs.open(filename, 'r', (err, fd) => {
+      if (err) return cb(err);
+      fs.close(fd, cb);
+    }),
+  };
+  const fn = ops[op];
+
+  let started = 0;
+  let finished = 0;
+  function next(err) {
+    if (err) throw err;
+    if (++finished === n) {
+      bench.end(n);
+      fs.closeSync(fd);
+      return;
+    }
+    if (started < n) {
+      started++;
+      fn(next);
+    }
+  }
+
+  bench.start();
+  for (; started < Math.min(concurrent, n); started++)
+    fn(next);
+}
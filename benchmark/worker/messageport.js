@@ -3,7 +3,7 @@
 const common = require('../common.js');
 const { MessageChannel } = require('worker_threads');
 const bench = common.createBenchmark(main, {
-  payload: ['string', 'object'],
+  payload: ['string', 'object', 'array', 'nested'],
   n: [1e6]
 });
 
@@ -18,6 +18,12 @@ function main(conf) {
     case 'object':
       payload = { action: 'pewpewpew', powerLevel: 9001 };
       break;
+    case 'array':
+      payload = ['pewpewpew', 9001, true];
+      break;
+    case 'nested':
+      payload = { action: 'pewpewpew', powerLevel: 9001, stats: [1, 2, 3] };
+      break;
     default:
       throw new Error('Unsupported payload type');
   }
@@ -0,0 +1,90 @@
+// Compile WebAssembly modules in several Workers at once. Compilation runs as
+// background tasks on the platform's worker threads, which all Workers share.
+'use strict';
+
+const common = require('../common.js');
+const { Worker } = require('worker_threads');
+
+const bench = common.createBenchmark(main, {
+  workers: [1, 4, 16],
+  functions: [100, 1000],
+  n: [64]
+});
+
+function leb128(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value !== 0)
+      byte |= 0x80;
+    bytes.push(byte);
+  } while (value !== 0);
+  return bytes;
+}
+
+function section(id, contents) {
+  return [id, ...leb128(contents.length), ...contents];
+}
+
+// A module with `count` functions of the type (i32) -> i32, each of which
+// adds a few dozen constants to its argument.
+function makeModule(count) {
+  const body = [0x00, 0x20, 0x00];  // No locals; local.get 0.
+  for (let i = 0; i < 50; i++)
+    body.push(0x41, ...leb128(i), 0x6a);  // i32.const i; i32.add.
+  body.push(0x0b);  // end.
+
+  const functions = [...leb128(count)];
+  const code = [...leb128(count)];
+  for (let i = 0; i < count; i++) {
+    functions.push(0x00);
+    code.push(...leb128(body.length), ...body);
+  }
+
+  return new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(0x01, [0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f]),
+    ...section(0x03, functions),
+    ...section(0x0a, code),
+  ]);
+}
+
+const workerSource = `
+  const { parentPort, workerData: { bytes, n } } = require('worker_threads');
+  parentPort.once('message', async () => {
+    for (let i = 0; i < n; i++)
+      await WebAssembly.compile(bytes);
+    parentPort.postMessage('done');
+  });
+`;
+
+function main({ workers, functions, n }) {
+  const bytes = makeModule(functions);
+  const perWorker = Math.ceil(n / workers);
+  let started = 0;
+  let done = 0;
+
+  const threads = [];
+  for (let i = 0; i < workers; i++) {
+    const worker = new Worker(workerSource, {
+      eval: true,
+      workerData: { bytes, n: perWorker }
+    });
+    threads.push(worker);
+    worker.on('online', () => {
+      if (++started !== workers)
+        return;
+      bench.start();
+      for (const thread of threads)
+        thread.postMessage('start');
+    });
+    worker.on('message', () => {
+      if (++done === workers) {
+        bench.end(perWorker * workers);
+        for (const thread of threads)
+          thread.terminate();
+      }
+    });
+  }
+}
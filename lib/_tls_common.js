@@ -24,8 +24,11 @@
 const {
   ArrayIsArray,
   ObjectCreate,
+  Promise,
 } = primordials;
 
+const { AsyncWrap, Providers } = internalBinding('async_wrap');
+const { Buffer } = require('buffer');
 const { parseCertString } = require('internal/tls');
 const { isArrayBufferView } = require('internal/util/types');
 const tls = require('tls');
@@ -91,15 +94,19 @@ function validateKeyOrCertOption(name, value) {
 exports.SecureContext = SecureContext;
 
 
-exports.createSecureContext = function createSecureContext(options) {
-  if (!options) options = {};
-
+function newSecureContext(options) {
   let secureOptions = options.secureOptions;
   if (options.honorCipherOrder)
     secureOptions |= SSL_OP_CIPHER_SERVER_PREFERENCE;
 
-  const c = new SecureContext(options.secureProtocol, secureOptions,
-                              options.minVersion, options.maxVersion);
+  return new SecureContext(options.secureProtocol, secureOptions,
+                           options.minVersion, options.maxVersion);
+}
+
+exports.createSecureContext = function createSecureContext(options) {
+  if (!options) options = {};
+
+  const c = newSecureContext(options);
 
   // Add CA before the cert to be able to load cert's issuer in C++ code.
   const { ca } = options;
@@ -117,6 +124,40 @@ exports.createSecureContext = function createSecureContext(options) {
     c.context.addRootCerts();
   }
 
+  return configSecureContext(c, options);
+};
+
+// Same as createSecureContext(), except that the CA certificates are parsed
+// and the certificate store is built on the threadpool.
+exports.createSecureContextAsync = async function createSecureContextAsync(
+  options) {
+  if (!options) options = {};
+
+  const c = newSecureContext(options);
+
+  let cas;
+  const { ca } = options;
+  if (ca) {
+    cas = ArrayIsArray(ca) ? ca : [ca];
+    cas = cas.map((val) => {
+      validateKeyOrCertOption('ca', val);
+      return typeof val === 'string' ? Buffer.from(val) : val;
+    });
+  }
+
+  await new Promise((resolve, reject) => {
+    const wrap = new AsyncWrap(Providers.CERTSTOREREQUEST);
+    wrap.ondone = (err) => {
+      if (err) reject(err);
+      else resolve();
+    };
+    c.context.loadCACerts(cas, wrap);
+  });
+
+  return configSecureContext(c, options);
+};
+
+function configSecureContext(c, options) {
   const { cert } = options;
   if (cert) {
     if (ArrayIsArray(cert)) {
@@ -295,7 +336,7 @@ exports.createSecureContext = function createSecureContext(options) {
   }
 
   return c;
-};
+}
 
 // Translate some fields from the handle's C-friendly format into more idiomatic
 // javascript object representations before passing them back to the user.  Can
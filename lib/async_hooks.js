@@ -3,6 +3,7 @@
 const {
   NumberIsSafeInteger,
   ReflectApply,
+  SafeMap,
   Symbol,
 } = primordials;
 
@@ -27,6 +28,10 @@ const {
   enableHooks,
   disableHooks,
   executionAsyncResource,
+  enableContextFrames,
+  getContextFrame,
+  setContextFrame,
+  captureContextFrame,
   // Internal Embedder API
   newAsyncId,
   getDefaultTriggerAsyncId,
@@ -159,6 +164,7 @@ class AsyncResource {
     const asyncId = newAsyncId();
     this[async_id_symbol] = asyncId;
     this[trigger_async_id_symbol] = triggerAsyncId;
+    captureContextFrame(this);
 
     if (initHooksExist()) {
       if (enabledHooksExist() && type.length === 0) {
@@ -209,16 +215,22 @@ class AsyncResource {
   }
 }
 
-const storageList = [];
-const storageHook = createHook({
-  init(asyncId, type, triggerAsyncId, resource) {
-    const currentResource = executionAsyncResource();
-    // Value of currentResource is always a non null object
-    for (let i = 0; i < storageList.length; ++i) {
-      storageList[i]._propagate(resource, currentResource);
-    }
-  }
-});
+// AsyncLocalStorage keeps its stores in async context frames, which are
+// propagated natively, so it does not need an init hook. A frame is an
+// immutable Map from the kResourceStore of each instance to its store.
+function setStore(frame, key, store) {
+  const newFrame = new SafeMap(frame);
+  newFrame.set(key, store);
+  return newFrame;
+}
+
+function deleteStore(frame, key) {
+  if (frame === undefined || !frame.has(key))
+    return frame;
+  const newFrame = new SafeMap(frame);
+  newFrame.delete(key);
+  return newFrame;
+}
 
 class AsyncLocalStorage {
   constructor() {
@@ -229,40 +241,27 @@ class AsyncLocalStorage {
   disable() {
     if (this.enabled) {
       this.enabled = false;
-      // If this.enabled, the instance must be in storageList
-      storageList.splice(storageList.indexOf(this), 1);
-      if (storageList.length === 0) {
-        storageHook.disable();
-      }
-    }
-  }
-
-  // Propagate the context from a parent resource to a child one
-  _propagate(resource, triggerResource) {
-    const store = triggerResource[this.kResourceStore];
-    if (this.enabled) {
-      resource[this.kResourceStore] = store;
+      // Stores that were propagated until now must not show up again if this
+      // instance is enabled later.
+      this.kResourceStore = Symbol('kResourceStore');
     }
   }
 
   enterWith(store) {
     if (!this.enabled) {
       this.enabled = true;
-      storageList.push(this);
-      storageHook.enable();
+      enableContextFrames();
     }
-    const resource = executionAsyncResource();
-    resource[this.kResourceStore] = store;
+    setContextFrame(setStore(getContextFrame(), this.kResourceStore, store));
   }
 
   runSyncAndReturn(store, callback, ...args) {
-    const resource = executionAsyncResource();
-    const outerStore = resource[this.kResourceStore];
+    const outerFrame = getContextFrame();
     this.enterWith(store);
     try {
       return callback(...args);
     } finally {
-      resource[this.kResourceStore] = outerStore;
+      setContextFrame(outerFrame);
     }
   }
 
@@ -270,36 +269,39 @@ class AsyncLocalStorage {
     if (!this.enabled) {
       return callback(...args);
     }
-    this.enabled = false;
+    const outerFrame = getContextFrame();
+    setContextFrame(deleteStore(outerFrame, this.kResourceStore));
     try {
       return callback(...args);
     } finally {
-      this.enabled = true;
+      setContextFrame(outerFrame);
     }
   }
 
   getStore() {
-    const resource = executionAsyncResource();
     if (this.enabled) {
-      return resource[this.kResourceStore];
+      const frame = getContextFrame();
+      if (frame !== undefined) {
+        return frame.get(this.kResourceStore);
+      }
     }
   }
 
   run(store, callback, ...args) {
-    const resource = executionAsyncResource();
-    const outerStore = resource[this.kResourceStore];
+    const outerFrame = getContextFrame();
     this.enterWith(store);
     process.nextTick(callback, ...args);
-    resource[this.kResourceStore] = outerStore;
+    setContextFrame(outerFrame);
   }
 
   exit(callback, ...args) {
     if (!this.enabled) {
       return process.nextTick(callback, ...args);
     }
-    this.enabled = false;
+    const outerFrame = getContextFrame();
+    setContextFrame(deleteStore(outerFrame, this.kResourceStore));
     process.nextTick(callback, ...args);
-    this.enabled = true;
+    setContextFrame(outerFrame);
   }
 }
 
@@ -72,9 +72,12 @@ const { FSReqCallback, statValues } = binding;
 const { toPathIfFileURL } = require('internal/url');
 const internalUtil = require('internal/util');
 const {
+  bufferToString,
   copyObject,
   Dirent,
+  getCopyTreeOptions,
   getDirents,
+  getMapFileAdvice,
   getOptions,
   getValidatedPath,
   getValidMode,
@@ -88,6 +91,7 @@ const {
   stringToSymlinkType,
   toUnixTimestamp,
   validateBufferArray,
+  validateCopyTreePaths,
   validateOffsetLengthRead,
   validateOffsetLengthWrite,
   validatePath,
@@ -98,7 +102,8 @@ const {
 const {
   Dir,
   opendir,
-  opendirSync
+  opendirSync,
+  walk
 } = require('internal/fs/dir');
 const {
   CHAR_FORWARD_SLASH,
@@ -109,7 +114,8 @@ const {
   parseFileMode,
   validateBuffer,
   validateInteger,
-  validateInt32
+  validateInt32,
+  validateUint32
 } = require('internal/validators');
 // 2 ** 32 - 1
 const kMaxUserId = 4294967295;
@@ -133,6 +139,7 @@ let FileWriteStream;
 
 const isWindows = process.platform === 'win32';
 const isOSX = process.platform === 'darwin';
+const isLinux = process.platform === 'linux';
 
 
 function showTruncateDeprecation() {
@@ -253,7 +260,7 @@ function existsSync(path) {
   return ctx.errno === undefined;
 }
 
-function readFileAfterOpen(err, fd) {
+function readFileAfterJob(err, result) {
   const context = this.context;
 
   if (err) {
@@ -261,12 +268,17 @@ function readFileAfterOpen(err, fd) {
     return;
   }
 
-  context.fd = fd;
+  if (typeof result !== 'number') {
+    context.callback(null, result);
+    return;
+  }
+
+  context.fd = result;
 
   const req = new FSReqCallback();
   req.oncomplete = readFileAfterStat;
   req.context = context;
-  binding.fstat(fd, false, req);
+  binding.fstat(result, false, req);
 }
 
 function readFileAfterStat(err, stats) {
@@ -304,21 +316,21 @@ function readFile(path, options, callback) {
 
   const req = new FSReqCallback();
   req.context = context;
-  req.oncomplete = readFileAfterOpen;
+  req.oncomplete = readFileAfterJob;
 
+  // Small regular files are read by a single native job, which hands
+  // everything else back to ReadFileContext as an open file descriptor.
   if (context.isUserFd) {
-    process.nextTick(function tick() {
-      req.oncomplete(null, path);
-    });
+    binding.readFile(path, 0, options.encoding, req);
     return;
   }
 
   path = getValidatedPath(path);
   const flagsNumber = stringToFlags(options.flags);
-  binding.open(pathModule.toNamespacedPath(path),
-               flagsNumber,
-               0o666,
-               req);
+  binding.readFile(pathModule.toNamespacedPath(path),
+                   flagsNumber,
+                   options.encoding,
+                   req);
 }
 
 function tryStatSync(fd, isUserFd) {
@@ -405,7 +417,7 @@ function readFileSync(path, options) {
     buffer = buffer.slice(0, pos);
   }
 
-  if (options.encoding) buffer = buffer.toString(options.encoding);
+  if (options.encoding) buffer = bufferToString(buffer, options.encoding);
   return buffer;
 }
 
@@ -648,6 +660,47 @@ function writeSync(fd, buffer, offset, length, position) {
   return result;
 }
 
+// usage:
+// fs.readv(fd, buffers[, position], callback);
+function readv(fd, buffers, position, callback) {
+  function wrapper(err, read) {
+    callback(err, read || 0, buffers);
+  }
+
+  validateInt32(fd, 'fd', 0);
+  validateBufferArray(buffers);
+
+  const req = new FSReqCallback();
+  req.oncomplete = wrapper;
+
+  callback = maybeCallback(callback || position);
+
+  if (typeof position !== 'number')
+    position = null;
+
+  return binding.readBuffers(fd, buffers, position, req);
+}
+
+ObjectDefineProperty(readv, internalUtil.customPromisifyArgs, {
+  value: ['bytesRead', 'buffers'],
+  enumerable: false
+});
+
+function readvSync(fd, buffers, position) {
+  validateInt32(fd, 'fd', 0);
+  validateBufferArray(buffers);
+
+  const ctx = {};
+
+  if (typeof position !== 'number')
+    position = null;
+
+  const result = binding.readBuffers(fd, buffers, position, undefined, ctx);
+
+  handleErrorFromBinding(ctx);
+  return result;
+}
+
 // usage:
 // fs.writev(fd, buffers[, position], callback);
 function writev(fd, buffers, position, callback) {
@@ -689,6 +742,30 @@ function writevSync(fd, buffers, position) {
   return result;
 }
 
+function mapFile(path, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  }
+  callback = makeCallback(callback);
+  path = getValidatedPath(path);
+  const advice = getMapFileAdvice(options);
+
+  const req = new FSReqCallback();
+  req.oncomplete = callback;
+  binding.mapFile(pathModule.toNamespacedPath(path), advice, req);
+}
+
+function mapFileSync(path, options) {
+  path = getValidatedPath(path);
+  const advice = getMapFileAdvice(options);
+  const ctx = { path };
+  const result = binding.mapFile(pathModule.toNamespacedPath(path), advice,
+                                 undefined, ctx);
+  handleErrorFromBinding(ctx);
+  return result;
+}
+
 function rename(oldPath, newPath, callback) {
   callback = makeCallback(callback);
   oldPath = getValidatedPath(oldPath, 'oldPath');
@@ -1407,6 +1484,37 @@ function watch(filename, options, listener) {
   return watcher;
 }
 
+function watchBatched(filename, options, listener) {
+  if (typeof options === 'function') {
+    listener = options;
+  }
+  options = getOptions(options, {});
+
+  // Don't make changes directly on options object
+  options = copyObject(options);
+
+  if (options.persistent === undefined) options.persistent = true;
+  if (options.recursive === undefined) options.recursive = false;
+  if (options.delay === undefined) options.delay = 50;
+  if (options.recursive && !(isLinux || isOSX || isWindows))
+    throw new ERR_FEATURE_UNAVAILABLE_ON_PLATFORM('watch recursively');
+  validateUint32(options.delay, 'options.delay');
+  if (!watchers)
+    watchers = require('internal/fs/watchers');
+  const watcher = new watchers.FSBatchWatcher();
+  watcher[watchers.kFSWatchStart](filename,
+                                  options.persistent,
+                                  options.recursive,
+                                  options.delay,
+                                  options.encoding);
+
+  if (listener) {
+    watcher.addListener('change', listener);
+  }
+
+  return watcher;
+}
+
 
 const statWatchers = new Map();
 
@@ -1860,6 +1968,41 @@ function copyFileSync(src, dest, mode) {
   handleErrorFromBinding(ctx);
 }
 
+function copyTree(src, dest, options, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = undefined;
+  } else if (typeof callback !== 'function') {
+    throw new ERR_INVALID_CALLBACK(callback);
+  }
+
+  src = getValidatedPath(src, 'src');
+  dest = getValidatedPath(dest, 'dest');
+  validateCopyTreePaths(src, dest);
+  const { mode, concurrency } = getCopyTreeOptions(options);
+
+  const req = new FSReqCallback();
+  req.oncomplete = makeCallback(callback);
+  binding.copyTree(pathModule.toNamespacedPath(src),
+                   pathModule.toNamespacedPath(dest),
+                   mode, concurrency, req);
+}
+
+
+function copyTreeSync(src, dest, options) {
+  src = getValidatedPath(src, 'src');
+  dest = getValidatedPath(dest, 'dest');
+  validateCopyTreePaths(src, dest);
+  const { mode, concurrency } = getCopyTreeOptions(options);
+
+  const ctx = {};
+  const result = binding.copyTree(pathModule.toNamespacedPath(src),
+                                  pathModule.toNamespacedPath(dest),
+                                  mode, concurrency, undefined, ctx);
+  handleErrorFromBinding(ctx);
+  return result;
+}
+
 function lazyLoadStreams() {
   if (!ReadStream) {
     ({ ReadStream, WriteStream } = require('internal/fs/streams'));
@@ -1890,6 +2033,8 @@ module.exports = fs = {
   closeSync,
   copyFile,
   copyFileSync,
+  copyTree,
+  copyTreeSync,
   createReadStream,
   createWriteStream,
   exists,
@@ -1916,6 +2061,8 @@ module.exports = fs = {
   linkSync,
   lstat,
   lstatSync,
+  mapFile,
+  mapFileSync,
   mkdir,
   mkdirSync,
   mkdtemp,
@@ -1928,6 +2075,8 @@ module.exports = fs = {
   readdirSync,
   read,
   readSync,
+  readv,
+  readvSync,
   readFile,
   readFileSync,
   readlink,
@@ -1949,7 +2098,9 @@ module.exports = fs = {
   unlinkSync,
   utimes,
   utimesSync,
+  walk,
   watch,
+  watchBatched,
   watchFile,
   writeFile,
   writeFileSync,
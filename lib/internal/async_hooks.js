@@ -32,11 +32,19 @@ const async_wrap = internalBinding('async_wrap');
  * popAsyncContext() call removes two doubles from it.
  * It has a fixed size, so if that is exceeded, calls to the native
  * side are used instead in pushAsyncContext() and popAsyncContext().
+ *
+ * async_context_frames is an Array that holds the current async context frame
+ * at index 0. pushAsyncContext() stores the frame that was current before it
+ * at the index that follows the new stack length, and popAsyncContext()
+ * restores it from there. Resources carry the frame that was current when they
+ * were created as resource[async_context_frame_symbol].
  */
 const {
   async_hook_fields,
   async_id_fields,
   execution_async_resources,
+  async_context_frames,
+  async_context_frame_symbol,
   owner_symbol
 } = async_wrap;
 // Store the pair executionAsyncId and triggerAsyncId in a std::stack on
@@ -84,7 +92,8 @@ const { enqueueMicrotask } = internalBinding('task_queue');
 // for a given step, that step can bail out early.
 const { kInit, kBefore, kAfter, kDestroy, kTotals, kPromiseResolve,
         kCheck, kExecutionAsyncId, kAsyncIdCounter, kTriggerAsyncId,
-        kDefaultTriggerAsyncId, kStackLength } = async_wrap.constants;
+        kDefaultTriggerAsyncId, kStackLength,
+        kUsesContextFrames } = async_wrap.constants;
 
 // Used in AsyncHook and AsyncResource.
 const async_id_symbol = Symbol('asyncId');
@@ -378,6 +387,10 @@ function clearAsyncIdStack() {
   async_id_fields[kTriggerAsyncId] = 0;
   async_hook_fields[kStackLength] = 0;
   execution_async_resources.splice(0, execution_async_resources.length);
+  if (async_context_frames.length > 1) {
+    async_context_frames[0] = async_context_frames[1];
+    async_context_frames.length = 1;
+  }
 }
 
 
@@ -389,6 +402,10 @@ function hasAsyncIdStack() {
 // This is the equivalent of the native push_async_ids() call.
 function pushAsyncContext(asyncId, triggerAsyncId, resource) {
   const offset = async_hook_fields[kStackLength];
+  if (async_hook_fields[kUsesContextFrames] > 0) {
+    async_context_frames[offset + 1] = async_context_frames[0];
+    async_context_frames[0] = resource[async_context_frame_symbol];
+  }
   if (offset * 2 >= async_wrap.async_ids_stack.length)
     return pushAsyncContext_(asyncId, triggerAsyncId, resource);
   async_wrap.async_ids_stack[offset * 2] = async_id_fields[kExecutionAsyncId];
@@ -411,6 +428,8 @@ function popAsyncContext(asyncId) {
   }
 
   const offset = stackLength - 1;
+  if (async_hook_fields[kUsesContextFrames] > 0)
+    leaveContextFrame(offset);
   async_id_fields[kExecutionAsyncId] = async_wrap.async_ids_stack[2 * offset];
   async_id_fields[kTriggerAsyncId] = async_wrap.async_ids_stack[2 * offset + 1];
   execution_async_resources.pop();
@@ -419,6 +438,43 @@ function popAsyncContext(asyncId) {
 }
 
 
+// Write the current frame back to the resource, so that entering a frame from
+// one of its callbacks carries over to the next ones, and make the frame that
+// was current before pushAsyncContext() current again. That is undefined if
+// frames were only enabled after the push.
+function leaveContextFrame(offset) {
+  const resource = execution_async_resources[offset];
+  const frame = async_context_frames[0];
+  if (resource != null && resource[async_context_frame_symbol] !== frame)
+    resource[async_context_frame_symbol] = frame;
+  async_context_frames[0] = async_context_frames[offset + 1];
+  async_context_frames.length = offset + 1;
+}
+
+
+// Async context frames are opaque values that follow the asynchronous control
+// flow. Nothing is recorded for them until enableContextFrames() is called.
+function enableContextFrames() {
+  if (async_hook_fields[kUsesContextFrames] === 0)
+    async_wrap.enableContextFrames();
+}
+
+function getContextFrame() {
+  return async_context_frames[0];
+}
+
+function setContextFrame(frame) {
+  async_context_frames[0] = frame;
+}
+
+// Called for resources that are created in JS, to make the current frame the
+// one of their callbacks.
+function captureContextFrame(resource) {
+  if (async_hook_fields[kUsesContextFrames] > 0)
+    resource[async_context_frame_symbol] = async_context_frames[0];
+}
+
+
 function executionAsyncId() {
   return async_id_fields[kExecutionAsyncId];
 }
@@ -447,6 +503,10 @@ module.exports = {
   clearAsyncIdStack,
   hasAsyncIdStack,
   executionAsyncResource,
+  enableContextFrames,
+  getContextFrame,
+  setContextFrame,
+  captureContextFrame,
   // Internal Embedder API
   newAsyncId,
   getOrSetAsyncId,
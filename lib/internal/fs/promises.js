@@ -5,6 +5,7 @@
 const kIoMaxLength = 2 ** 31 - 1;
 
 const {
+  ArrayIsArray,
   MathMax,
   MathMin,
   NumberIsSafeInteger,
@@ -29,8 +30,11 @@ const {
 const { isArrayBufferView } = require('internal/util/types');
 const { rimrafPromises } = require('internal/fs/rimraf');
 const {
+  bufferToString,
   copyObject,
+  getCopyTreeOptions,
   getDirents,
+  getMapFileAdvice,
   getOptions,
   getStatsFromBinding,
   getValidatedPath,
@@ -41,6 +45,7 @@ const {
   stringToSymlinkType,
   toUnixTimestamp,
   validateBufferArray,
+  validateCopyTreePaths,
   validateOffsetLengthRead,
   validateOffsetLengthWrite,
   validateRmdirOptions,
@@ -101,6 +106,14 @@ class FileHandle {
     return read(this, buffer, offset, length, position);
   }
 
+  readv(buffers, position) {
+    return readv(this, buffers, position);
+  }
+
+  readBatch(buffers, positions) {
+    return readBatch(this, buffers, positions);
+  }
+
   readFile(options) {
     return readFile(this, options);
   }
@@ -185,7 +198,7 @@ async function readFileHandle(filehandle, options) {
 
   const result = Buffer.concat(chunks);
   if (options.encoding) {
-    return result.toString(options.encoding);
+    return bufferToString(result, options.encoding);
   } else {
     return result;
   }
@@ -211,6 +224,16 @@ async function copyFile(src, dest, mode) {
                           kUsePromises);
 }
 
+async function copyTree(src, dest, options) {
+  src = getValidatedPath(src, 'src');
+  dest = getValidatedPath(dest, 'dest');
+  validateCopyTreePaths(src, dest);
+  const { mode, concurrency } = getCopyTreeOptions(options);
+  return binding.copyTree(pathModule.toNamespacedPath(src),
+                          pathModule.toNamespacedPath(dest),
+                          mode, concurrency, kUsePromises);
+}
+
 // Note that unlike fs.open() which uses numeric file descriptors,
 // fsPromises.open() uses the fs.FileHandle class.
 async function open(path, flags, mode) {
@@ -253,6 +276,35 @@ async function read(handle, buffer, offset, length, position) {
   return { bytesRead, buffer };
 }
 
+async function readv(handle, buffers, position) {
+  validateFileHandle(handle);
+  validateBufferArray(buffers);
+
+  if (typeof position !== 'number')
+    position = null;
+
+  const bytesRead = (await binding.readBuffers(handle.fd, buffers, position,
+                                               kUsePromises)) || 0;
+  return { bytesRead, buffers };
+}
+
+async function readBatch(handle, buffers, positions) {
+  validateFileHandle(handle);
+  validateBufferArray(buffers);
+  if (!ArrayIsArray(positions))
+    throw new ERR_INVALID_ARG_TYPE('positions', 'number[]', positions);
+  if (positions.length !== buffers.length) {
+    throw new ERR_INVALID_ARG_VALUE('positions', positions,
+                                    'must have one entry for each buffer');
+  }
+  for (let i = 0; i < positions.length; i++)
+    validateInteger(positions[i], `positions[${i}]`, 0);
+
+  const bytesRead = await binding.readBatch(handle.fd, buffers, positions,
+                                            kUsePromises);
+  return { bytesRead, buffers };
+}
+
 async function write(handle, buffer, offset, length, position) {
   validateFileHandle(handle);
 
@@ -294,6 +346,13 @@ async function writev(handle, buffers, position) {
   return { bytesWritten, buffers };
 }
 
+async function mapFile(path, options) {
+  path = getValidatedPath(path);
+  const advice = getMapFileAdvice(options);
+  return binding.mapFile(pathModule.toNamespacedPath(path), advice,
+                         kUsePromises);
+}
+
 async function rename(oldPath, newPath) {
   oldPath = getValidatedPath(oldPath, 'oldPath');
   newPath = getValidatedPath(newPath, 'newPath');
@@ -526,6 +585,7 @@ module.exports = {
   exports: {
     access,
     copyFile,
+    copyTree,
     open,
     opendir: promisify(opendir),
     rename,
@@ -536,6 +596,7 @@ module.exports = {
     readlink,
     symlink,
     lstat,
+    mapFile,
     stat,
     link,
     unlink,
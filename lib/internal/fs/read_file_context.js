@@ -5,6 +5,7 @@ const {
 } = primordials;
 
 const { Buffer } = require('buffer');
+const { bufferToString } = require('internal/fs/utils');
 
 const { FSReqCallback, close, read } = internalBinding('fs');
 
@@ -55,7 +56,7 @@ function readFileAfterClose(err) {
       buffer = context.buffer;
 
     if (context.encoding)
-      buffer = buffer.toString(context.encoding);
+      buffer = bufferToString(buffer, context.encoding);
   } catch (err) {
     return callback(err);
   }
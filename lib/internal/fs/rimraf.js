@@ -4,6 +4,9 @@
 // - All code related to the glob dependency has been removed.
 // - Bring your own custom fs module is not currently supported.
 // - Some basic code cleanup.
+// - Outside of Windows, trees are removed by the native rmTree() binding, which
+//   spreads the work over the threadpool. The code below is only used on
+//   Windows, where removal needs the EPERM workarounds.
 'use strict';
 
 const {
@@ -26,6 +29,7 @@ const {
   unlink,
   unlinkSync
 } = require('fs');
+const { handleErrorFromBinding } = require('internal/fs/utils');
 const { sep } = require('path');
 const { setTimeout } = require('timers');
 const { sleep } = require('internal/util');
@@ -37,17 +41,22 @@ const epermHandler = isWindows ? fixWinEPERM : _rmdir;
 const epermHandlerSync = isWindows ? fixWinEPERMSync : _rmdirSync;
 const readdirEncoding = 'buffer';
 const separator = Buffer.from(sep);
+const binding = internalBinding('fs');
+const { FSReqCallback } = binding;
+// The number of threadpool threads that a single removal may occupy.
+const kRmTreeConcurrency = 4;
+const removeTree = isWindows ? _rimraf : rmTree;
 
 
 function rimraf(path, options, callback) {
   let retries = 0;
 
-  _rimraf(path, options, function CB(err) {
+  removeTree(path, options, function CB(err) {
     if (err) {
       if (retryErrorCodes.has(err.code) && retries < options.maxRetries) {
         retries++;
         const delay = retries * options.retryDelay;
-        return setTimeout(_rimraf, delay, path, options, CB);
+        return setTimeout(removeTree, delay, path, options, CB);
       }
 
       // The file is already gone.
@@ -60,6 +69,13 @@ function rimraf(path, options, callback) {
 }
 
 
+function rmTree(path, options, callback) {
+  const req = new FSReqCallback();
+  req.oncomplete = callback;
+  binding.rmTree(path, kRmTreeConcurrency, req);
+}
+
+
 function _rimraf(path, options, callback) {
   // SunOS lets the root user unlink directories. Use lstat here to make sure
   // it's not a directory.
@@ -172,6 +188,9 @@ function rimrafPromises(path, options) {
 
 
 function rimrafSync(path, options) {
+  if (!isWindows)
+    return rmTreeSync(path, options);
+
   let stats;
 
   try {
@@ -204,6 +223,28 @@ function rimrafSync(path, options) {
 }
 
 
+function rmTreeSync(path, options) {
+  const tries = options.maxRetries + 1;
+
+  for (let i = 1; i <= tries; i++) {
+    const ctx = {};
+    binding.rmTree(path, kRmTreeConcurrency, undefined, ctx);
+    if (ctx.errno === undefined)
+      return;
+
+    try {
+      handleErrorFromBinding(ctx);
+    } catch (err) {
+      // Give up on the last try, or if the error does not warrant a retry.
+      if (!retryErrorCodes.has(err.code) || i === tries)
+        throw err;
+      if (options.retryDelay > 0)
+        sleep(i * options.retryDelay);
+    }
+  }
+}
+
+
 function _unlinkSync(path, options) {
   const tries = options.maxRetries + 1;
 
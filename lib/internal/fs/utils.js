@@ -32,12 +32,19 @@ const {
   isDate,
   isBigUint64Array
 } = require('internal/util/types');
-const { once } = require('internal/util');
+const { normalizeEncoding, once } = require('internal/util');
 const { toPathIfFileURL } = require('internal/url');
 const {
   validateInt32,
   validateUint32
 } = require('internal/validators');
+const { transferToString } = internalBinding('buffer');
+const {
+  kMapAdviceNormal,
+  kMapAdviceSequential,
+  kMapAdviceRandom,
+  kMapAdviceWillNeed
+} = internalBinding('fs');
 const pathModule = require('path');
 const kType = Symbol('type');
 const kStats = Symbol('stats');
@@ -627,6 +634,27 @@ const validateRmdirOptions = hideStackFrames((options) => {
   return options;
 });
 
+const mapFileAdvice = {
+  __proto__: null,
+  normal: kMapAdviceNormal,
+  sequential: kMapAdviceSequential,
+  random: kMapAdviceRandom,
+  willneed: kMapAdviceWillNeed,
+};
+
+// Returns the native constant for the `advice` option of fs.mapFile().
+const getMapFileAdvice = hideStackFrames((options) => {
+  if (options === undefined)
+    return kMapAdviceNormal;
+  if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'object', options);
+  const { advice = 'normal' } = options;
+  const value = mapFileAdvice[advice];
+  if (value === undefined)
+    throw new ERR_INVALID_OPT_VALUE('advice', advice);
+  return value;
+});
+
 const getValidMode = hideStackFrames((mode, type) => {
   let min = kMinimumAccessMode;
   let max = kMaximumAccessMode;
@@ -651,6 +679,36 @@ const getValidMode = hideStackFrames((mode, type) => {
     'mode', `an integer >= ${min} && <= ${max}`, mode);
 });
 
+const defaultCopyTreeOptions = {
+  mode: 0,
+  concurrency: 4,
+};
+
+const getCopyTreeOptions = hideStackFrames((options) => {
+  if (options === undefined)
+    options = defaultCopyTreeOptions;
+  else if (options === null || typeof options !== 'object')
+    throw new ERR_INVALID_ARG_TYPE('options', 'object', options);
+  else
+    options = { ...defaultCopyTreeOptions, ...options };
+
+  const mode = getValidMode(options.mode, 'copyFile');
+  validateUint32(options.concurrency, 'options.concurrency', true);
+  return { mode, concurrency: options.concurrency };
+});
+
+// Copying a tree into itself would never finish.
+const validateCopyTreePaths = hideStackFrames((src, dest) => {
+  if (typeof src !== 'string' || typeof dest !== 'string')
+    return;
+  const from = pathModule.resolve(src);
+  const to = pathModule.resolve(dest);
+  if (to === from || to.startsWith(from + pathModule.sep)) {
+    throw new ERR_INVALID_ARG_VALUE('dest', dest,
+                                    'must not be src or inside of it');
+  }
+});
+
 const validateStringAfterArrayBufferView = hideStackFrames((buffer, name) => {
   if (typeof buffer !== 'string') {
     throw new ERR_INVALID_ARG_TYPE(
@@ -661,13 +719,32 @@ const validateStringAfterArrayBufferView = hideStackFrames((buffer, name) => {
   }
 });
 
+// Decodes a buffer that fs allocated itself and does not hand out, e.g. for
+// readFile(). Large latin1 and ASCII results are allowed to take over the
+// buffer's memory rather than copying it, so it must not be used afterwards.
+function bufferToString(buffer, encoding) {
+  switch (normalizeEncoding(encoding)) {
+    case 'utf8':
+      return transferToString(buffer, 'utf8');
+    case 'latin1':
+      return transferToString(buffer, 'latin1');
+    case 'ascii':
+      return transferToString(buffer, 'ascii');
+    default:
+      return buffer.toString(encoding);
+  }
+}
+
 module.exports = {
   assertEncoding,
+  bufferToString,
   BigIntStats,  // for testing
   copyObject,
   Dirent,
   getDirent,
   getDirents,
+  getCopyTreeOptions,
+  getMapFileAdvice,
   getOptions,
   getValidatedPath,
   getValidMode,
@@ -681,6 +758,7 @@ module.exports = {
   Stats,
   toUnixTimestamp,
   validateBufferArray,
+  validateCopyTreePaths,
   validateOffsetLengthRead,
   validateOffsetLengthWrite,
   validatePath,
@@ -1,6 +1,7 @@
 'use strict';
 
 const {
+  ArrayPrototypePush,
   ObjectDefineProperty,
   ObjectSetPrototypeOf,
   Symbol,
@@ -11,7 +12,7 @@ const {
   kFsStatsFieldsNumber,
   StatWatcher: _StatWatcher
 } = internalBinding('fs');
-const { FSEvent } = internalBinding('fs_event_wrap');
+const { FSEvent, FSEventBatch } = internalBinding('fs_event_wrap');
 const { UV_ENOSPC } = internalBinding('uv');
 const { EventEmitter } = require('events');
 const {
@@ -30,6 +31,7 @@ const kOldStatus = Symbol('kOldStatus');
 const kUseBigint = Symbol('kUseBigint');
 
 const kFSWatchStart = Symbol('kFSWatchStart');
+const kFilename = Symbol('kFilename');
 const kFSStatWatcherStart = Symbol('kFSStatWatcherStart');
 
 function emitStop(self) {
@@ -212,6 +214,91 @@ function emitCloseNT(self) {
   self.emit('close');
 }
 
+
+// Like FSWatcher, but changes are collected in native code for `delay`
+// milliseconds and coalesced per filename, and then emitted as one array.
+function FSBatchWatcher() {
+  EventEmitter.call(this);
+
+  this._handle = new FSEventBatch();
+  this._handle[owner_symbol] = this;
+
+  this._handle.onchange = (status, filenames, events, overflow) => {
+    if (status < 0) {
+      if (this._handle !== null) {
+        // We don't use this.close() here to avoid firing the close event.
+        this._handle.close();
+        this._handle = null;  // Make the handle garbage collectable.
+      }
+      const error = errors.uvException({
+        errno: status,
+        syscall: 'watch',
+        path: this[kFilename]
+      });
+      error.filename = this[kFilename];
+      this.emit('error', error);
+      return;
+    }
+
+    const changes = [];
+    for (let i = 0; i < filenames.length; i++) {
+      ArrayPrototypePush(changes,
+                         { eventType: events[i], filename: filenames[i] });
+    }
+    this.emit('change', changes, overflow);
+  };
+}
+ObjectSetPrototypeOf(FSBatchWatcher.prototype, EventEmitter.prototype);
+ObjectSetPrototypeOf(FSBatchWatcher, EventEmitter);
+
+FSBatchWatcher.prototype[kFSWatchStart] = function(filename,
+                                                   persistent,
+                                                   recursive,
+                                                   delay,
+                                                   encoding) {
+  filename = getValidatedPath(filename, 'filename');
+  this[kFilename] = filename;
+
+  const err = this._handle.start(toNamespacedPath(filename),
+                                 persistent,
+                                 recursive,
+                                 delay,
+                                 encoding);
+  if (err) {
+    this._handle = null;
+    const error = errors.uvException({
+      errno: err,
+      syscall: 'watch',
+      path: filename,
+      message: err === UV_ENOSPC ?
+        'System limit for number of file watchers reached' : ''
+    });
+    error.filename = filename;
+    throw error;
+  }
+};
+
+// This method is a noop if the watcher has already been closed.
+FSBatchWatcher.prototype.close = function() {
+  if (this._handle === null)
+    return;
+  this._handle.close();
+  this._handle = null;
+  process.nextTick(emitCloseNT, this);
+};
+
+FSBatchWatcher.prototype.ref = function() {
+  if (this._handle !== null)
+    this._handle.ref();
+  return this;
+};
+
+FSBatchWatcher.prototype.unref = function() {
+  if (this._handle !== null)
+    this._handle.unref();
+  return this;
+};
+
 // Legacy alias on the C++ wrapper object. This is not public API, so we may
 // want to runtime-deprecate it at some point. There's no hurry, though.
 ObjectDefineProperty(FSEvent.prototype, 'owner', {
@@ -220,6 +307,7 @@ ObjectDefineProperty(FSEvent.prototype, 'owner', {
 });
 
 module.exports = {
+  FSBatchWatcher,
   FSWatcher,
   StatWatcher,
   kFSWatchStart,
@@ -5,13 +5,15 @@ const {
 } = require('internal/util');
 
 const { format } = require('util');
-const { Map, Symbol } = primordials;
+const { Boolean, Map, NumberIsSafeInteger, Symbol } = primordials;
 
 const {
   ERR_INVALID_ARG_TYPE,
   ERR_INVALID_ARG_VALUE,
 } = require('internal/errors').codes;
 
+const { setImmediate } = require('timers');
+
 const kDestroy = Symbol('kDestroy');
 const kHandle = Symbol('kHandle');
 
@@ -87,8 +89,60 @@ class Histogram {
   get [kHandle]() { return this.#handle; }
 }
 
+// A Histogram that values can be recorded into, from any number of threads.
+// Values are written into a staging buffer that is shared with the native
+// side, and only added to the histogram in batches.
+class RecordableHistogram extends Histogram {
+  #buffer = undefined;
+  #staging = undefined;
+  #flushScheduled = false;
+
+  constructor(internal, buffer) {
+    super(internal);
+    this.#buffer = buffer;
+    this.#staging = internal.staging;
+  }
+
+  record(val) {
+    if (typeof val !== 'number')
+      throw new ERR_INVALID_ARG_TYPE('val', 'number', val);
+    if (val < 0 || !NumberIsSafeInteger(val))
+      throw new ERR_INVALID_ARG_VALUE.RangeError('val', val);
+    const staging = this.#staging;
+    const count = staging[0] + 1;
+    staging[count] = val;
+    staging[0] = count;
+    if (count === staging.length - 1) {
+      this[kHandle].flush();
+    } else if (!this.#flushScheduled) {
+      // Make the values visible to other threads soon, even if no more are
+      // recorded on this one.
+      this.#flushScheduled = true;
+      setImmediate(() => {
+        this.#flushScheduled = false;
+        this[kHandle].flush();
+      }).unref();
+    }
+  }
+
+  recordDelta() {
+    this[kHandle].recordDelta();
+  }
+
+  snapshot(options = {}) {
+    if (typeof options !== 'object' || options === null)
+      throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+    return new Histogram(this[kHandle].snapshot(Boolean(options.reset)));
+  }
+
+  // Passing this to createHistogram() on another thread records into the
+  // same histogram from there.
+  get buffer() { return this.#buffer; }
+}
+
 module.exports = {
   Histogram,
+  RecordableHistogram,
   kDestroy,
   kHandle,
 };
@@ -7,6 +7,7 @@ const {
   ArrayIsArray,
   Map,
   MathMin,
+  NumberIsInteger,
   ObjectAssign,
   ObjectCreate,
   ObjectDefineProperty,
@@ -176,6 +177,7 @@ function debugSessionObj(session, message, ...args) {
 
 const kMaxFrameSize = (2 ** 24) - 1;
 const kMaxInt = (2 ** 32) - 1;
+const kMaxInt32 = (2 ** 31) - 1;
 const kMaxStreams = (2 ** 32) - 1;
 const kMaxALTSVC = (2 ** 14) - 2;
 
@@ -2255,7 +2257,7 @@ function onPipedFileHandleRead() {
 }
 
 function processRespondWithFD(self, fd, headers, offset = 0, length = -1,
-                              streamOptions = 0) {
+                              streamOptions = 0, chunkSize) {
   const state = self[kState];
   state.flags |= STREAM_FLAGS_HEADERS_SENT;
 
@@ -2281,11 +2283,11 @@ function processRespondWithFD(self, fd, headers, offset = 0, length = -1,
   }
 
   defaultTriggerAsyncIdScope(self[async_id_symbol], startFilePipe,
-                             self, fd, offset, length);
+                             self, fd, offset, length, chunkSize);
 }
 
-function startFilePipe(self, fd, offset, length) {
-  const handle = new FileHandle(fd, offset, length);
+function startFilePipe(self, fd, offset, length, chunkSize) {
+  const handle = new FileHandle(fd, offset, length, chunkSize);
   handle.onread = onPipedFileHandleRead;
   handle.stream = self;
 
@@ -2333,7 +2335,8 @@ function doSendFD(session, options, fd, headers, streamOptions, err, stat) {
   processRespondWithFD(this, fd, headers,
                        statOptions.offset | 0,
                        statOptions.length | 0,
-                       streamOptions);
+                       streamOptions,
+                       options.chunkSize);
 }
 
 function doSendFileFD(session, options, fd, headers, streamOptions, err, stat) {
@@ -2402,7 +2405,8 @@ function doSendFileFD(session, options, fd, headers, streamOptions, err, stat) {
   processRespondWithFD(this, fd, headers,
                        options.offset | 0,
                        statOptions.length | 0,
-                       streamOptions);
+                       streamOptions,
+                       options.chunkSize);
 }
 
 function afterOpen(session, options, headers, streamOptions, err, fd) {
@@ -2594,6 +2598,12 @@ class ServerHttp2Stream extends Http2Stream {
     if (options.length !== undefined && typeof options.length !== 'number')
       throw new ERR_INVALID_OPT_VALUE('length', options.length);
 
+    if (options.chunkSize !== undefined &&
+        (!NumberIsInteger(options.chunkSize) ||
+         options.chunkSize < 1 || options.chunkSize > kMaxInt32)) {
+      throw new ERR_INVALID_OPT_VALUE('chunkSize', options.chunkSize);
+    }
+
     if (options.statCheck !== undefined &&
         typeof options.statCheck !== 'function') {
       throw new ERR_INVALID_OPT_VALUE('statCheck', options.statCheck);
@@ -2634,7 +2644,8 @@ class ServerHttp2Stream extends Http2Stream {
     processRespondWithFD(this, fd, headers,
                          options.offset,
                          options.length,
-                         streamOptions);
+                         streamOptions,
+                         options.chunkSize);
   }
 
   // Initiate a file response on this Http2Stream. The path is passed to
@@ -2659,6 +2670,12 @@ class ServerHttp2Stream extends Http2Stream {
     if (options.length !== undefined && typeof options.length !== 'number')
       throw new ERR_INVALID_OPT_VALUE('length', options.length);
 
+    if (options.chunkSize !== undefined &&
+        (!NumberIsInteger(options.chunkSize) ||
+         options.chunkSize < 1 || options.chunkSize > kMaxInt32)) {
+      throw new ERR_INVALID_OPT_VALUE('chunkSize', options.chunkSize);
+    }
+
     if (options.statCheck !== undefined &&
         typeof options.statCheck !== 'function') {
       throw new ERR_INVALID_OPT_VALUE('statCheck', options.statCheck);
@@ -0,0 +1,52 @@
+'use strict';
+
+// Runs the main script with --build-module-bundle, and writes the modules that
+// it loads to the --module-bundle file if the process exits successfully.
+
+const {
+  prepareMainThreadExecution
+} = require('internal/bootstrap/pre_execution');
+
+prepareMainThreadExecution(true);
+
+const { getOptionValue } = require('internal/options');
+const { Module } = require('internal/modules/cjs/loader');
+const { resolveMainPath } = require('internal/modules/run_main');
+const {
+  startRecording,
+  writeBundle,
+} = require('internal/modules/cjs/module_bundle');
+const { uvException } = require('internal/errors');
+
+const bundlePath = getOptionValue('--module-bundle');
+const main = process.argv[1];
+if (!main) {
+  process._rawDebug('--build-module-bundle requires a main script');
+  process.exit(9);
+}
+
+// Rejections that nothing handles would otherwise only print a warning, and
+// leave a bundle behind that was built from a failed entry point.
+process.on('unhandledRejection', (reason) => {
+  throw reason;
+});
+
+const mainPath = resolveMainPath(main);
+process.on('exit', (code) => {
+  if (code !== 0)
+    return;
+  const err = writeBundle(bundlePath, mainPath);
+  if (err !== 0) {
+    const ex = uvException({ errno: err, syscall: 'open', path: bundlePath });
+    process._rawDebug(`Cannot write module bundle: ${ex.message}`);
+    process.exitCode = 1;
+  }
+});
+
+startRecording();
+
+markBootstrapComplete();
+
+// Only CommonJS modules can be recorded, so the main script is not loaded
+// through the ES module loader.
+Module._load(mainPath || main, null, true);
@@ -59,8 +59,10 @@ const internalFS = require('internal/fs/utils');
 const path = require('path');
 const { emitWarningSync } = require('internal/process/warning');
 const {
+  internalModuleFilterPaths,
   internalModuleReadJSON,
-  internalModuleStat
+  internalModuleStat,
+  internalModuleStatCache,
 } = internalBinding('fs');
 const { safeGetenv } = internalBinding('credentials');
 const {
@@ -77,6 +79,13 @@ const manifest = getOptionValue('--experimental-policy') ?
   require('internal/process/policy').manifest :
   null;
 const { compileFunction } = internalBinding('contextify');
+const {
+  getBundledSource,
+  getBundleResolution,
+  isBuildingBundle,
+  recordModule,
+  recordResolution,
+} = require('internal/modules/cjs/module_bundle');
 
 // Whether any user-provided CJS modules had been loaded (executed).
 // Used for internal assertions.
@@ -657,10 +666,24 @@ Module._findPath = function(request, paths, isMain) {
     trailingSlash = /(?:^|\/)\.?\.$/.test(request);
   }
 
+  // Leave out the node_modules directories that cannot contain the package
+  // with a single call, rather than checking each of them in turn below.
+  let indexes;
+  if (!isWindows && !absoluteRequest && paths.length > 1) {
+    const match = StringPrototypeMatch(request, EXPORTS_PATTERN);
+    if (match) {
+      if (exts === undefined)
+        exts = ObjectKeys(Module._extensions);
+      indexes = internalModuleFilterPaths(paths, match[1],
+                                          match[2] !== undefined, exts);
+    }
+  }
+
   // For each path
-  for (let i = 0; i < paths.length; i++) {
+  const count = indexes !== undefined ? indexes.length : paths.length;
+  for (let n = 0; n < count; n++) {
     // Don't search further if path doesn't exist
-    const curPath = paths[i];
+    const curPath = paths[indexes !== undefined ? indexes[n] : n];
     if (curPath && stat(curPath) < 1) continue;
     const basePath = resolveExports(curPath, request, absoluteRequest);
     let filename;
@@ -905,7 +928,12 @@ Module._load = function(request, parent, isMain) {
     }
   }
 
-  const filename = Module._resolveFilename(request, parent, isMain);
+  let filename = getBundleResolution(request, parent);
+  if (filename === undefined) {
+    filename = Module._resolveFilename(request, parent, isMain);
+    if (isBuildingBundle())
+      recordResolution(request, parent, filename);
+  }
 
   const cachedModule = Module._cache[filename];
   if (cachedModule !== undefined) {
@@ -1130,7 +1158,8 @@ function wrapSafe(filename, content, cjsModuleInstance) {
         'module',
         '__filename',
         '__dirname',
-      ]
+      ],
+      true  // Use the --compile-cache-dir cache, if any.
     );
   } catch (err) {
     if (process.mainModule === cjsModuleInstance)
@@ -1194,7 +1223,10 @@ Module.prototype._compile = function(content, filename) {
   const exports = this.exports;
   const thisValue = exports;
   const module = this;
-  if (requireDepth === 0) statCache = new Map();
+  if (requireDepth === 0) {
+    statCache = new Map();
+    internalModuleStatCache(true);
+  }
   if (inspectorWrapper) {
     result = inspectorWrapper(compiledWrapper, thisValue, exports,
                               require, module, filename, dirname);
@@ -1203,12 +1235,22 @@ Module.prototype._compile = function(content, filename) {
                                   filename, dirname);
   }
   hasLoadedAnyUserCJSModule = true;
-  if (requireDepth === 0) statCache = null;
+  if (requireDepth === 0) {
+    statCache = null;
+    internalModuleStatCache(false);
+  }
   return result;
 };
 
 // Native extension for .js
 Module._extensions['.js'] = function(module, filename) {
+  // The package scope of unchanged modules in a module bundle was checked
+  // when the bundle was built.
+  const bundled = getBundledSource(filename);
+  if (bundled !== undefined) {
+    module._compile(bundled, filename);
+    return;
+  }
   if (filename.endsWith('.js')) {
     const pkg = readPackageScope(filename);
     // Function require shouldn't be used in ES modules.
@@ -1219,13 +1261,19 @@ Module._extensions['.js'] = function(module, filename) {
     }
   }
   const content = fs.readFileSync(filename, 'utf8');
+  if (isBuildingBundle())
+    recordModule(filename, content);
   module._compile(content, filename);
 };
 
 
 // Native extension for .json
 Module._extensions['.json'] = function(module, filename) {
-  const content = fs.readFileSync(filename, 'utf8');
+  let content = getBundledSource(filename);
+  if (content === undefined)
+    content = fs.readFileSync(filename, 'utf8');
+  if (isBuildingBundle())
+    recordModule(filename, content);
 
   if (manifest) {
     const moduleURL = pathToFileURL(filename);
@@ -0,0 +1,114 @@
+'use strict';
+
+// Support for module bundles in the CommonJS loader. With
+// --build-module-bundle, the filenames that requests resolve to and the
+// sources of the modules that the entry point loads are recorded, and written
+// to the --module-bundle file when the process exits successfully. When the
+// process is started from such a file, the requests are not resolved again,
+// and the sources of all modules whose files are unchanged are taken from the
+// bundle instead of being read from disk.
+
+const {
+  ArrayPrototypePush,
+  SafeMap,
+} = primordials;
+
+const {
+  getModuleBundle,
+  getBundledSource: getBundledSourceAt,
+  writeModuleBundle,
+} = internalBinding('module_bundle');
+
+// Set up by startRecording() with --build-module-bundle.
+let recordedResolutions = null;
+let recordedModules = null;
+
+// Filled in from the bundle on first use; null if there is none.
+let resolutions;
+let moduleIndexes;
+
+function resolutionKey(request, parent) {
+  return `${parent && parent.filename ? parent.filename : ''}\x00${request}`;
+}
+
+function loadBundle() {
+  const data = getModuleBundle();
+  if (data === undefined) {
+    resolutions = null;
+    moduleIndexes = null;
+    return;
+  }
+  const { 0: keys, 1: filenames, 2: moduleFilenames } = data;
+  resolutions = new SafeMap();
+  for (let i = 0; i < keys.length; i++)
+    resolutions.set(keys[i], filenames[i]);
+  moduleIndexes = new SafeMap();
+  for (let i = 0; i < moduleFilenames.length; i++)
+    moduleIndexes.set(moduleFilenames[i], i);
+}
+
+function getBundleResolution(request, parent) {
+  if (resolutions === undefined)
+    loadBundle();
+  if (resolutions === null)
+    return undefined;
+  return resolutions.get(resolutionKey(request, parent));
+}
+
+// Returns the source of a module in the bundle, or undefined if the module is
+// not in it or its file has changed since the bundle was built.
+function getBundledSource(filename) {
+  if (resolutions === undefined)
+    loadBundle();
+  if (moduleIndexes === null)
+    return undefined;
+  const index = moduleIndexes.get(filename);
+  if (index === undefined)
+    return undefined;
+  return getBundledSourceAt(index);
+}
+
+function isBuildingBundle() {
+  return recordedResolutions !== null;
+}
+
+function startRecording() {
+  recordedResolutions = new SafeMap();
+  recordedModules = new SafeMap();
+}
+
+function recordResolution(request, parent, filename) {
+  recordedResolutions.set(resolutionKey(request, parent), filename);
+}
+
+// Records the contents of a file that the loader has read.
+function recordModule(filename, source) {
+  recordedModules.set(filename, source);
+}
+
+function writeBundle(path, entry) {
+  const keys = [];
+  const filenames = [];
+  for (const { 0: key, 1: filename } of recordedResolutions) {
+    ArrayPrototypePush(keys, key);
+    ArrayPrototypePush(filenames, filename);
+  }
+  const moduleFilenames = [];
+  const sources = [];
+  for (const { 0: filename, 1: source } of recordedModules) {
+    ArrayPrototypePush(moduleFilenames, filename);
+    ArrayPrototypePush(sources, source);
+  }
+  return writeModuleBundle(path, entry, keys, filenames, moduleFilenames,
+                           sources);
+}
+
+module.exports = {
+  getBundledSource,
+  getBundleResolution,
+  isBuildingBundle,
+  recordModule,
+  recordResolution,
+  startRecording,
+  writeBundle,
+};
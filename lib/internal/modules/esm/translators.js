@@ -78,7 +78,8 @@ translators.set('module', async function moduleStrategy(url) {
     source, { url, format: 'module' }, defaultTransformSource));
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  const module = new ModuleWrap(url, undefined, source, 0, 0, undefined,
+                                true);
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
@@ -3,9 +3,18 @@
 const CJSLoader = require('internal/modules/cjs/loader');
 const { Module, toRealPath, readPackageScope } = CJSLoader;
 const { getOptionValue } = require('internal/options');
+const {
+  getBundledSource,
+  getBundleResolution,
+} = require('internal/modules/cjs/module_bundle');
 const path = require('path');
 
 function resolveMainPath(main) {
+  // The entry point of a module bundle was resolved when it was built.
+  const bundledPath = getBundleResolution(main, null);
+  if (bundledPath !== undefined)
+    return bundledPath;
+
   // Note extension resolution for the main entry point can be deprecated in a
   // future major.
   // Module._findPath is monkey-patchable here.
@@ -31,8 +40,10 @@ function shouldUseESMLoader(mainPath) {
   // Determine the module format of the main
   if (mainPath && mainPath.endsWith('.mjs'))
     return true;
-  if (!mainPath || mainPath.endsWith('.cjs'))
+  if (!mainPath || mainPath.endsWith('.cjs') ||
+      getBundledSource(mainPath) !== undefined) {
     return false;
+  }
   const pkg = readPackageScope(mainPath);
   return pkg && pkg.data.type === 'module';
 }
@@ -73,5 +84,6 @@ function executeUserEntryPoint(main = process.argv[1]) {
 }
 
 module.exports = {
-  executeUserEntryPoint
+  executeUserEntryPoint,
+  resolveMainPath,
 };
@@ -31,6 +31,7 @@ const {
   newAsyncId,
   initHooksExist,
   destroyHooksExist,
+  captureContextFrame,
   emitInit,
   emitBefore,
   emitAfter,
@@ -131,6 +132,7 @@ function nextTick(callback) {
     callback,
     args
   };
+  captureContextFrame(tickObject);
   if (initHooksExist())
     emitInit(asyncId, 'TickObject', triggerAsyncId, tickObject);
   queue.push(tickObject);
@@ -65,26 +65,32 @@
 // after the first one encountered that does not yet need to timeout will also
 // always be due to timeout at a later time.
 //
-// Less-than constant time operations are thus contained in two places:
-// The PriorityQueue — an efficient binary heap implementation that does all
-// operations in worst-case O(log n) time — which manages the order of expiring
-// Timeout lists and the object map lookup of a specific list by the duration of
-// timers within (or creation of a new list). However, these operations combined
-// have shown to be trivial in comparison to other timers architectures.
+// The order in which the lists expire is managed by a hierarchical timing
+// wheel in C++ (src/timer_wheel.h), which the lists are registered with by
+// their duration. Adding, moving and removing a list takes constant time there.
+// The lists that are due are passed to processTimers() in batches, in the order
+// in which they expire, through the shared dueTimerLists array. The changes
+// that are made to the lists while timers run are queued in the shared
+// timerListUpdates array and applied when processTimers() returns, rather than
+// calling into C++ for each of them. That leaves the object map lookup of a
+// specific list by the duration of timers within (or creation of a new list).
 
 const {
   MathMax,
   MathTrunc,
-  NumberMIN_SAFE_INTEGER,
   ObjectCreate,
   Symbol,
 } = primordials;
 
 const {
-  scheduleTimer,
+  scheduleTimerList,
+  unscheduleTimerList,
+  applyTimerListUpdates,
   toggleTimerRef,
   getLibuvNow,
-  immediateInfo
+  immediateInfo,
+  dueTimerLists,
+  timerListUpdates
 } = internalBinding('timers');
 
 const {
@@ -92,6 +98,7 @@ const {
   newAsyncId,
   initHooksExist,
   destroyHooksExist,
+  captureContextFrame,
   // The needed emit*() functions.
   emitInit,
   emitBefore,
@@ -110,7 +117,6 @@ const {
 const { validateNumber } = require('internal/validators');
 
 const L = require('internal/linkedlist');
-const PriorityQueue = require('internal/priority_queue');
 
 const { inspect } = require('internal/util/inspect');
 const debug = require('internal/util/debuglog').debuglog('timer');
@@ -123,20 +129,18 @@ const kHasOutstanding = 2;
 // Timeout values > TIMEOUT_MAX are set to 1.
 const TIMEOUT_MAX = 2 ** 31 - 1;
 
-let timerListId = NumberMIN_SAFE_INTEGER;
-
 const kRefed = Symbol('refed');
 
 // Create a single linked list instance only once at startup
 const immediateQueue = new ImmediateList();
 
-let nextExpiry = Infinity;
 let refCount = 0;
 
-// This is a priority queue with a custom sorting function that first compares
-// the expiry times of two lists and if they're the same then compares their
-// individual IDs to determine which list was created first.
-const timerListQueue = new PriorityQueue(compareTimersLists, setPosition);
+// This is TimerListInfo::kMaxUpdates in src/env.h.
+const kMaxTimerListUpdates = (timerListUpdates.length - 1) / 2;
+
+// Set while processTimers() runs, see scheduleList().
+let queueTimerListUpdates = false;
 
 // Object map containing linked lists of timers, keyed and sorted by their
 // duration in milliseconds.
@@ -149,6 +153,7 @@ function initAsyncResource(resource, type) {
   const asyncId = resource[async_id_symbol] = newAsyncId();
   const triggerAsyncId =
     resource[trigger_async_id_symbol] = getDefaultTriggerAsyncId();
+  captureContextFrame(resource);
   if (initHooksExist())
     emitInit(asyncId, type, triggerAsyncId, resource);
 }
@@ -232,9 +237,7 @@ function TimersList(expiry, msecs) {
   this._idleNext = this; // Create the list with the linkedlist properties to
   this._idlePrev = this; // Prevent any unnecessary hidden class changes.
   this.expiry = expiry;
-  this.id = timerListId++;
   this.msecs = msecs;
-  this.priorityQueuePosition = null;
 }
 
 // Make sure the linked list only shows the minimal necessary information.
@@ -337,6 +340,33 @@ function insertGuarded(item, refed, start) {
   item[kRefed] = refed;
 }
 
+function queueTimerListUpdate(msecs, expiry) {
+  let count = timerListUpdates[0];
+  if (count === kMaxTimerListUpdates) {
+    applyTimerListUpdates();
+    count = 0;
+  }
+  timerListUpdates[1 + 2 * count] = msecs;
+  timerListUpdates[2 + 2 * count] = expiry;
+  timerListUpdates[0] = count + 1;
+}
+
+// While processTimers() runs, C++ arms the timer handle once it returns, so
+// changes to the timing wheel are only queued then.
+function scheduleList(msecs, expiry) {
+  if (queueTimerListUpdates)
+    queueTimerListUpdate(msecs, expiry);
+  else
+    scheduleTimerList(msecs, expiry);
+}
+
+function unscheduleList(msecs) {
+  if (queueTimerListUpdates)
+    queueTimerListUpdate(msecs, -1);
+  else
+    unscheduleTimerList(msecs);
+}
+
 function insert(item, msecs, start = getLibuvNow()) {
   // Truncate so that accuracy of sub-milisecond timers is not assumed.
   msecs = MathTrunc(msecs);
@@ -348,12 +378,7 @@ function insert(item, msecs, start = getLibuvNow()) {
     debug('no %d list was found in insert, creating a new one', msecs);
     const expiry = start + msecs;
     timerListMap[msecs] = list = new TimersList(expiry, msecs);
-    timerListQueue.insert(list);
-
-    if (nextExpiry > expiry) {
-      scheduleTimer(msecs);
-      nextExpiry = expiry;
-    }
+    scheduleList(msecs, expiry);
   }
 
   L.append(list, item);
@@ -389,21 +414,6 @@ function getTimerDuration(msecs, name) {
   return msecs;
 }
 
-function compareTimersLists(a, b) {
-  const expiryDiff = a.expiry - b.expiry;
-  if (expiryDiff === 0) {
-    if (a.id < b.id)
-      return -1;
-    if (a.id > b.id)
-      return 1;
-  }
-  return expiryDiff;
-}
-
-function setPosition(node, pos) {
-  node.priorityQueuePosition = pos;
-}
-
 function getTimerCallbacks(runNextTicks) {
   // If an uncaught exception was thrown during execution of immediateQueue,
   // this queue will store all remaining Immediates that need to run upon
@@ -474,24 +484,32 @@ function getTimerCallbacks(runNextTicks) {
   }
 
 
-  function processTimers(now) {
+  // The first `dueCount` entries of `dueTimerLists` hold the durations of
+  // lists that are due, in the order in which they expired. `continued` is
+  // true if this batch continues an earlier one of the same run. The return
+  // value tells C++ whether any timer is refed.
+  function processTimers(now, dueCount, continued) {
     debug('process timer lists %d', now);
-    nextExpiry = Infinity;
-
-    let list;
-    let ranAtLeastOneList = false;
-    while (list = timerListQueue.peek()) {
-      if (list.expiry > now) {
-        nextExpiry = list.expiry;
-        return refCount > 0 ? nextExpiry : -nextExpiry;
+
+    let ranAtLeastOneList = continued;
+    queueTimerListUpdates = true;
+    try {
+      for (let i = 0; i < dueCount; i++) {
+        const list = timerListMap[dueTimerLists[i]];
+        // A timer that ran before may have removed the list, or replaced it
+        // with one that expires later.
+        if (list === undefined || list.expiry > now)
+          continue;
+        if (ranAtLeastOneList)
+          runNextTicks();
+        else
+          ranAtLeastOneList = true;
+        listOnTimeout(list, now);
       }
-      if (ranAtLeastOneList)
-        runNextTicks();
-      else
-        ranAtLeastOneList = true;
-      listOnTimeout(list, now);
+    } finally {
+      queueTimerListUpdates = false;
     }
-    return 0;
+    return refCount > 0;
   }
 
   function listOnTimeout(list, now) {
@@ -508,8 +526,7 @@ function getTimerCallbacks(runNextTicks) {
       // This happens if there are more timers scheduled for later in the list.
       if (diff < msecs) {
         list.expiry = MathMax(timer._idleStart + msecs, now + 1);
-        list.id = timerListId++;
-        timerListQueue.percolateDown(1);
+        scheduleList(msecs, list.expiry);
         debug('%d list wait because diff is %d', msecs, diff);
         return;
       }
@@ -570,7 +587,7 @@ function getTimerCallbacks(runNextTicks) {
     // If `L.peek(list)` returned nothing, the list was either empty or we have
     // called all of the timer timeouts.
     // As such, we can remove the list from the object map and
-    // the PriorityQueue.
+    // the timing wheel.
     debug('%d list empty', msecs);
 
     // The current list may have been removed and recreated since the reference
@@ -578,7 +595,7 @@ function getTimerCallbacks(runNextTicks) {
     // before destroying.
     if (list === timerListMap[msecs]) {
       delete timerListMap[msecs];
-      timerListQueue.shift();
+      unscheduleList(msecs);
     }
   }
 
@@ -608,8 +625,8 @@ module.exports = {
   active,
   unrefActive,
   insert,
+  unscheduleList,
   timerListMap,
-  timerListQueue,
   decRefCount,
   incRefCount
 };
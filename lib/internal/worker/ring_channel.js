@@ -0,0 +1,293 @@
+'use strict';
+
+/* global SharedArrayBuffer */
+
+const {
+  Int32Array,
+  MathMin,
+  Symbol,
+  Uint8Array,
+} = primordials;
+
+const {
+  RingChannelWaker,
+  wakeRingChannel
+} = internalBinding('messaging');
+const { owner_symbol } = internalBinding('symbols');
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_OUT_OF_RANGE,
+  },
+} = require('internal/errors');
+const { validateInteger } = require('internal/validators');
+const {
+  isAnyArrayBuffer,
+  isArrayBufferView,
+  isSharedArrayBuffer
+} = require('internal/util/types');
+const { Buffer } = require('buffer');
+const EventEmitter = require('events');
+
+// The SharedArrayBuffer of a RingChannel starts with a header of four 32-bit
+// words, followed by the ring itself. Records in the ring consist of their
+// length as a 32-bit word and their contents, padded to a multiple of four
+// bytes, and may wrap around the end of the ring.
+const kHeaderSize = 16;
+// The total number of bytes consumed and produced, modulo 2 ** 32.
+const kReadIndex = 0;
+const kWriteIndex = 1;
+// What the reading side does when it has run out of records, see below.
+const kState = 2;
+// The id of the RingChannelWaker of a reading side that uses events.
+const kWakerId = 3;
+
+// The reading side is busy, or nobody reads from the channel at all.
+const kActive = 0;
+// The reading side waits for its event loop to be woken up.
+const kIdle = 1;
+// The reading side is blocked in Atomics.wait() on kState.
+const kWaiting = 2;
+
+const kMinSize = 64;
+const kMaxSize = 2 ** 30;
+
+// Number of records emitted before other work on the event loop gets a turn.
+const kMaxRecordsPerWakeup = 1000;
+
+const kHeader = Symbol('kHeader');
+const kData = Symbol('kData');
+const kWords = Symbol('kWords');
+const kHandle = Symbol('kHandle');
+const kRefed = Symbol('kRefed');
+const kStart = Symbol('kStart');
+const kStop = Symbol('kStop');
+const kOnWake = Symbol('kOnWake');
+
+function isValidSize(size) {
+  return size >= kMinSize && size <= kMaxSize && (size & (size - 1)) === 0;
+}
+
+function toUint8Array(data) {
+  if (typeof data === 'string')
+    return Buffer.from(data);
+  if (isArrayBufferView(data))
+    return new Uint8Array(data.buffer, data.byteOffset, data.byteLength);
+  if (isAnyArrayBuffer(data))
+    return new Uint8Array(data);
+  throw new ERR_INVALID_ARG_TYPE(
+    'data', ['string', 'Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+    data);
+}
+
+// Lets the reading side know that there are new records, if it has run out
+// of them before. The compare-and-swap makes sure that this happens only once
+// for every time that it does.
+function wakeReader(header) {
+  const state = Atomics.load(header, kState);
+  if (state === kActive ||
+      Atomics.compareExchange(header, kState, state, kActive) !== state) {
+    return;
+  }
+  if (state === kWaiting)
+    Atomics.notify(header, kState, 1);
+  else
+    wakeRingChannel(Atomics.load(header, kWakerId) >>> 0);
+}
+
+class RingChannel extends EventEmitter {
+  constructor(sizeOrBuffer) {
+    super();
+    let buffer;
+    if (typeof sizeOrBuffer === 'number') {
+      validateInteger(sizeOrBuffer, 'size', kMinSize, kMaxSize);
+      if (!isValidSize(sizeOrBuffer)) {
+        throw new ERR_INVALID_ARG_VALUE(
+          'size', sizeOrBuffer, 'must be a power of two');
+      }
+      buffer = new SharedArrayBuffer(kHeaderSize + sizeOrBuffer);
+    } else if (isSharedArrayBuffer(sizeOrBuffer)) {
+      if (!isValidSize(sizeOrBuffer.byteLength - kHeaderSize)) {
+        throw new ERR_INVALID_ARG_VALUE(
+          'buffer', sizeOrBuffer, 'is not the buffer of a RingChannel');
+      }
+      buffer = sizeOrBuffer;
+    } else {
+      throw new ERR_INVALID_ARG_TYPE(
+        'sizeOrBuffer', ['number', 'SharedArrayBuffer'], sizeOrBuffer);
+    }
+
+    this[kHeader] = new Int32Array(buffer, 0, kHeaderSize / 4);
+    this[kData] = new Uint8Array(buffer, kHeaderSize);
+    this[kWords] = new Int32Array(buffer, kHeaderSize);
+    this[kHandle] = null;
+    this[kRefed] = true;
+
+    this.on('newListener', (name) => {
+      if (name === 'message' && this.listenerCount('message') === 0)
+        this[kStart]();
+    });
+    this.on('removeListener', (name) => {
+      if (name === 'message' && this.listenerCount('message') === 0)
+        this[kStop]();
+    });
+  }
+
+  get buffer() {
+    return this[kHeader].buffer;
+  }
+
+  write(data) {
+    const bytes = toUint8Array(data);
+    const header = this[kHeader];
+    const ring = this[kData];
+    const size = ring.length;
+    const length = bytes.length;
+    const recordSize = 4 + ((length + 3) & ~3);
+    if (recordSize > size) {
+      throw new ERR_OUT_OF_RANGE(
+        'data.byteLength', `<= ${size - 4}`, length);
+    }
+
+    const write = Atomics.load(header, kWriteIndex);
+    const used = (write - Atomics.load(header, kReadIndex)) | 0;
+    if (size - used < recordSize)
+      return false;
+
+    const offset = write & (size - 1);
+    this[kWords][offset >>> 2] = length;
+    const start = (offset + 4) & (size - 1);
+    const first = MathMin(length, size - start);
+    ring.set(first === length ? bytes : bytes.subarray(0, first), start);
+    if (first < length)
+      ring.set(bytes.subarray(first), 0);
+
+    // Publishing the new write index also publishes the record contents.
+    Atomics.store(header, kWriteIndex, (write + recordSize) | 0);
+    wakeReader(header);
+    return true;
+  }
+
+  read() {
+    const header = this[kHeader];
+    const read = Atomics.load(header, kReadIndex);
+    if (read === Atomics.load(header, kWriteIndex))
+      return undefined;
+
+    const ring = this[kData];
+    const size = ring.length;
+    const offset = read & (size - 1);
+    const length = this[kWords][offset >>> 2];
+    const start = (offset + 4) & (size - 1);
+    const first = MathMin(length, size - start);
+    const result = Buffer.allocUnsafe(length);
+    result.set(ring.subarray(start, start + first));
+    if (first < length)
+      result.set(ring.subarray(0, length - first), first);
+
+    Atomics.store(header, kReadIndex, (read + 4 + ((length + 3) & ~3)) | 0);
+    return result;
+  }
+
+  readSync(timeout) {
+    if (timeout !== undefined && timeout !== Infinity)
+      validateInteger(timeout, 'timeout', 0);
+    const header = this[kHeader];
+    for (;;) {
+      const record = this.read();
+      if (record !== undefined)
+        return record;
+
+      // Announce that we are going to wait, then check again, so that a
+      // record written in between is not missed.
+      Atomics.store(header, kState, kWaiting);
+      if (Atomics.load(header, kWriteIndex) !==
+          Atomics.load(header, kReadIndex)) {
+        Atomics.store(header, kState, kActive);
+        continue;
+      }
+      const result = Atomics.wait(header, kState, kWaiting, timeout);
+      Atomics.store(header, kState, kActive);
+      if (result === 'timed-out')
+        return this.read();
+    }
+  }
+
+  ref() {
+    this[kRefed] = true;
+    if (this[kHandle] !== null)
+      this[kHandle].ref();
+    return this;
+  }
+
+  unref() {
+    this[kRefed] = false;
+    if (this[kHandle] !== null)
+      this[kHandle].unref();
+    return this;
+  }
+
+  close() {
+    this.removeAllListeners('message');
+  }
+
+  [kStart]() {
+    const handle = new RingChannelWaker();
+    handle[owner_symbol] = this;
+    handle.onmessage = onwake;
+    if (!this[kRefed])
+      handle.unref();
+    this[kHandle] = handle;
+    Atomics.store(this[kHeader], kWakerId, handle.getId());
+    // Records may have been written before anyone was listening.
+    wakeRingChannel(handle.getId());
+  }
+
+  [kStop]() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return;
+    this[kHandle] = null;
+    const header = this[kHeader];
+    Atomics.compareExchange(header, kWakerId, handle.getId(), 0);
+    Atomics.store(header, kState, kActive);
+    handle.close();
+  }
+
+  [kOnWake]() {
+    const header = this[kHeader];
+    for (let i = 0; i < kMaxRecordsPerWakeup; i++) {
+      const record = this.read();
+      if (record === undefined) {
+        // Go idle, unless a record was written since the last check.
+        Atomics.store(header, kState, kIdle);
+        if (Atomics.load(header, kWriteIndex) ===
+            Atomics.load(header, kReadIndex)) {
+          return;
+        }
+        Atomics.store(header, kState, kActive);
+        continue;
+      }
+      try {
+        this.emit('message', record);
+      } catch (err) {
+        if (this[kHandle] !== null)
+          wakeRingChannel(this[kHandle].getId());
+        throw err;
+      }
+      // The last listener may have been removed.
+      if (this[kHandle] === null)
+        return;
+    }
+    wakeRingChannel(this[kHandle].getId());
+  }
+}
+
+function onwake() {
+  this[owner_symbol][kOnWake]();
+}
+
+module.exports = {
+  RingChannel
+};
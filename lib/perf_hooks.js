@@ -7,17 +7,21 @@ const {
   ObjectDefineProperties,
   ObjectDefineProperty,
   ObjectKeys,
+  NumberMAX_SAFE_INTEGER,
   Set,
   Symbol,
 } = primordials;
 
 const {
   ELDHistogram: _ELDHistogram,
+  RecordableHistogram: _RecordableHistogram,
+  createHistogramBuffer,
   PerformanceEntry,
   mark: _mark,
   clearMark: _clearMark,
   measure: _measure,
   milestones,
+  loopTiming,
   observerCounts,
   setupObservers,
   timeOrigin,
@@ -25,9 +29,15 @@ const {
   timerify,
   constants,
   installGarbageCollectionTracking,
-  removeGarbageCollectionTracking
+  removeGarbageCollectionTracking,
+  getWorkerTaskStats,
+  startRequestLatencyTracking: _startRequestLatencyTracking,
+  stopRequestLatencyTracking: _stopRequestLatencyTracking,
+  getRequestLatency: _getRequestLatency
 } = internalBinding('performance');
 
+const { Providers: asyncProviders } = internalBinding('async_wrap');
+
 const {
   NODE_PERFORMANCE_ENTRY_TYPE_NODE,
   NODE_PERFORMANCE_ENTRY_TYPE_MARK,
@@ -42,12 +52,20 @@ const {
   NODE_PERFORMANCE_MILESTONE_LOOP_START,
   NODE_PERFORMANCE_MILESTONE_LOOP_EXIT,
   NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE,
-  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT
+  NODE_PERFORMANCE_MILESTONE_ENVIRONMENT,
+
+  NODE_PERFORMANCE_LOOP_TIMING_TIMERS,
+  NODE_PERFORMANCE_LOOP_TIMING_POLL_IDLE,
+  NODE_PERFORMANCE_LOOP_TIMING_POLL_ACTIVE,
+  NODE_PERFORMANCE_LOOP_TIMING_CHECK,
+  NODE_PERFORMANCE_LOOP_TIMING_OTHER,
+  NODE_PERFORMANCE_LOOP_TIMING_ITERATIONS
 } = constants;
 
 const { AsyncResource } = require('async_hooks');
 const L = require('internal/linkedlist');
 const kInspect = require('internal/util').customInspectSymbol;
+const { isSharedArrayBuffer } = require('internal/util/types');
 
 const {
   ERR_INVALID_CALLBACK,
@@ -59,6 +77,7 @@ const {
 
 const {
   Histogram,
+  RecordableHistogram,
   kHandle,
 } = require('internal/histogram');
 
@@ -205,6 +224,10 @@ class PerformanceNodeTiming extends PerformanceEntry {
     return getMilestoneTimestamp(NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE);
   }
 
+  get idleTime() {
+    return loopTiming[NODE_PERFORMANCE_LOOP_TIMING_POLL_IDLE] / 1e6;
+  }
+
   [kInspect]() {
     return {
       name: 'node',
@@ -216,7 +239,8 @@ class PerformanceNodeTiming extends PerformanceEntry {
       bootstrapComplete: this.bootstrapComplete,
       environment: this.environment,
       loopStart: this.loopStart,
-      loopExit: this.loopExit
+      loopExit: this.loopExit,
+      idleTime: this.idleTime
     };
   }
 }
@@ -387,6 +411,33 @@ class Performance {
     return now() - timeOrigin;
   }
 
+  eventLoopUtilization(util1, util2) {
+    const loopStart = nodeTiming.loopStart;
+    if (loopStart <= 0) {
+      return { idle: 0, active: 0, utilization: 0 };
+    }
+
+    if (util2) {
+      const idle = util1.idle - util2.idle;
+      const active = util1.active - util2.active;
+      return { idle, active, utilization: active / (idle + active) };
+    }
+
+    const idle = nodeTiming.idleTime;
+    const active = this.now() - loopStart - idle;
+    if (!util1) {
+      return { idle, active, utilization: active / (idle + active) };
+    }
+
+    const idleDelta = idle - util1.idle;
+    const activeDelta = active - util1.active;
+    return {
+      idle: idleDelta,
+      active: activeDelta,
+      utilization: activeDelta / (idleDelta + activeDelta)
+    };
+  }
+
   mark(name) {
     name = `${name}`;
     _mark(name);
@@ -578,10 +629,118 @@ function monitorEventLoopDelay(options = {}) {
   return new ELDHistogram(new _ELDHistogram(resolution));
 }
 
+function createHistogram(options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  let { buffer } = options;
+  if (buffer === undefined) {
+    const {
+      lowest = 1,
+      highest = NumberMAX_SAFE_INTEGER,
+      figures = 3,
+    } = options;
+    if (typeof lowest !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('options.lowest', 'number', lowest);
+    }
+    if (lowest < 1 || !NumberIsSafeInteger(lowest)) {
+      throw new ERR_INVALID_OPT_VALUE.RangeError('lowest', lowest);
+    }
+    if (typeof highest !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('options.highest', 'number', highest);
+    }
+    if (highest < 2 * lowest || !NumberIsSafeInteger(highest)) {
+      throw new ERR_INVALID_OPT_VALUE.RangeError('highest', highest);
+    }
+    if (typeof figures !== 'number') {
+      throw new ERR_INVALID_ARG_TYPE('options.figures', 'number', figures);
+    }
+    if (figures < 1 || figures > 5 || !NumberIsSafeInteger(figures)) {
+      throw new ERR_INVALID_OPT_VALUE.RangeError('figures', figures);
+    }
+    buffer = createHistogramBuffer(lowest, highest, figures);
+  } else if (!isSharedArrayBuffer(buffer)) {
+    throw new ERR_INVALID_ARG_TYPE('options.buffer',
+                                   'SharedArrayBuffer', buffer);
+  }
+  return new RecordableHistogram(new _RecordableHistogram(buffer), buffer);
+}
+
+function getEventLoopPhaseTimes() {
+  const ms = (field) => loopTiming[field] / 1e6;
+  return {
+    timers: ms(NODE_PERFORMANCE_LOOP_TIMING_TIMERS),
+    pollIdle: ms(NODE_PERFORMANCE_LOOP_TIMING_POLL_IDLE),
+    pollActive: ms(NODE_PERFORMANCE_LOOP_TIMING_POLL_ACTIVE),
+    check: ms(NODE_PERFORMANCE_LOOP_TIMING_CHECK),
+    other: ms(NODE_PERFORMANCE_LOOP_TIMING_OTHER),
+    iterations: loopTiming[NODE_PERFORMANCE_LOOP_TIMING_ITERATIONS],
+  };
+}
+
+function startRequestLatencyTracking() {
+  _startRequestLatencyTracking();
+}
+
+function stopRequestLatencyTracking() {
+  _stopRequestLatencyTracking();
+}
+
+let providerNames;
+
+function getRequestLatency(options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    throw new ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const handles = _getRequestLatency(Boolean(options.reset));
+  if (handles === undefined)
+    return undefined;
+  if (providerNames === undefined) {
+    providerNames = [];
+    for (const name of ObjectKeys(asyncProviders))
+      providerNames[asyncProviders[name]] = name;
+  }
+  const result = {};
+  for (let i = 0; i < handles.length; i++) {
+    if (handles[i] !== undefined)
+      result[providerNames[i]] = new Histogram(handles[i]);
+  }
+  return result;
+}
+
+// Filled in by getWorkerTaskStats(), five fields per priority lane.
+const workerTaskStatsFields = new Float64Array(15);
+
+function getPlatformTaskStats() {
+  if (!getWorkerTaskStats(workerTaskStatsFields))
+    return undefined;
+  const lane = (index) => {
+    const offset = index * 5;
+    return {
+      tasks: workerTaskStatsFields[offset],
+      steals: workerTaskStatsFields[offset + 1],
+      waitTime: workerTaskStatsFields[offset + 2],
+      maxWaitTime: workerTaskStatsFields[offset + 3],
+      runTime: workerTaskStatsFields[offset + 4],
+    };
+  };
+  return {
+    userBlocking: lane(0),
+    normal: lane(1),
+    lowPriority: lane(2),
+  };
+}
+
 module.exports = {
   performance,
   PerformanceObserver,
-  monitorEventLoopDelay
+  monitorEventLoopDelay,
+  createHistogram,
+  getEventLoopPhaseTimes,
+  getPlatformTaskStats,
+  startRequestLatencyTracking,
+  stopRequestLatencyTracking,
+  getRequestLatency
 };
 
 ObjectDefineProperty(module.exports, 'constants', {
@@ -43,11 +43,11 @@ const {
   initAsyncResource,
   getTimerDuration,
   timerListMap,
-  timerListQueue,
   immediateQueue,
   active,
   unrefActive,
-  insert
+  insert,
+  unscheduleList
 } = require('internal/timers');
 const {
   promisify: { custom: customPromisify },
@@ -86,7 +86,7 @@ function unenroll(item) {
     const list = timerListMap[msecs];
     if (list !== undefined && L.isEmpty(list)) {
       debug('unenroll: list empty');
-      timerListQueue.removeAt(list.priorityQueuePosition);
+      unscheduleList(list.msecs);
       delete timerListMap[list.msecs];
     }
 
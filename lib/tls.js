@@ -327,6 +327,7 @@ exports.parseCertString = internalUtil.deprecate(
   'DEP0076');
 
 exports.createSecureContext = _tls_common.createSecureContext;
+exports.createSecureContextAsync = _tls_common.createSecureContextAsync;
 exports.SecureContext = _tls_common.SecureContext;
 exports.TLSSocket = _tls_wrap.TLSSocket;
 exports.Server = _tls_wrap.Server;
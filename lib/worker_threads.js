@@ -15,6 +15,8 @@ const {
   receiveMessageOnPort
 } = require('internal/worker/io');
 
+const { RingChannel } = require('internal/worker/ring_channel');
+
 module.exports = {
   isMainThread,
   MessagePort,
@@ -22,6 +24,7 @@ module.exports = {
   moveMessagePortToContext,
   receiveMessageOnPort,
   resourceLimits,
+  RingChannel,
   threadId,
   SHARE_ENV,
   Worker,
@@ -147,6 +147,7 @@
       'lib/internal/inspector_async_hook.js',
       'lib/internal/js_stream_socket.js',
       'lib/internal/linkedlist.js',
+      'lib/internal/main/build_module_bundle.js',
       'lib/internal/main/check_syntax.js',
       'lib/internal/main/eval_string.js',
       'lib/internal/main/eval_stdin.js',
@@ -160,6 +161,7 @@
       'lib/internal/modules/run_main.js',
       'lib/internal/modules/cjs/helpers.js',
       'lib/internal/modules/cjs/loader.js',
+      'lib/internal/modules/cjs/module_bundle.js',
       'lib/internal/modules/esm/loader.js',
       'lib/internal/modules/esm/create_dynamic_module.js',
       'lib/internal/modules/esm/get_format.js',
@@ -216,6 +218,7 @@
       'lib/internal/vm/module.js',
       'lib/internal/worker.js',
       'lib/internal/worker/io.js',
+      'lib/internal/worker/ring_channel.js',
       'lib/internal/watchdog.js',
       'lib/internal/streams/lazy_transform.js',
       'lib/internal/streams/async_iterator.js',
@@ -548,6 +551,7 @@
         'src/api/utils.cc',
         'src/async_wrap.cc',
         'src/cares_wrap.cc',
+        'src/compile_cache.cc',
         'src/connect_wrap.cc',
         'src/connection_wrap.cc',
         'src/debug_utils.cc',
@@ -576,11 +580,15 @@
         'src/node_env_var.cc',
         'src/node_errors.cc',
         'src/node_file.cc',
+        'src/node_file_mmap.cc',
+        'src/node_file_tree.cc',
+        'src/node_file_uring.cc',
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
+        'src/node_module_bundle.cc',
         'src/node_metadata.cc',
         'src/node_native_module.cc',
         'src/node_native_module_env.cc',
@@ -596,6 +604,8 @@
         'src/node_report_module.cc',
         'src/node_report_utils.cc',
         'src/node_serdes.cc',
+        'src/node_simd.cc',
+        'src/node_snapshot_blob.cc',
         'src/node_sockaddr.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
@@ -611,6 +621,7 @@
         'src/node_zlib.cc',
         'src/pipe_wrap.cc',
         'src/process_wrap.cc',
+        'src/request_latency.cc',
         'src/signal_wrap.cc',
         'src/spawn_sync.cc',
         'src/stream_base.cc',
@@ -619,6 +630,7 @@
         'src/string_bytes.cc',
         'src/string_decoder.cc',
         'src/tcp_wrap.cc',
+        'src/timer_wheel.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
         'src/tracing/node_trace_buffer.cc',
@@ -636,6 +648,8 @@
         'src/base_object.h',
         'src/base_object-inl.h',
         'src/base64.h',
+        'src/blob_serializer.h',
+        'src/compile_cache.h',
         'src/connect_wrap.h',
         'src/connection_wrap.h',
         'src/debug_utils.h',
@@ -663,6 +677,9 @@
         'src/node_errors.h',
         'src/node_file.h',
         'src/node_file-inl.h',
+        'src/node_file_mmap.h',
+        'src/node_file_tree.h',
+        'src/node_file_uring.h',
         'src/node_http_common.h',
         'src/node_http_common-inl.h',
         'src/node_http2.h',
@@ -673,6 +690,7 @@
         'src/node_mem.h',
         'src/node_mem-inl.h',
         'src/node_messaging.h',
+        'src/node_module_bundle.h',
         'src/node_metadata.h',
         'src/node_mutex.h',
         'src/node_native_module.h',
@@ -687,6 +705,8 @@
         'src/node_report.h',
         'src/node_revert.h',
         'src/node_root_certs.h',
+        'src/node_simd.h',
+        'src/node_snapshot_blob.h',
         'src/node_sockaddr.h',
         'src/node_sockaddr-inl.h',
         'src/node_stat_watcher.h',
@@ -700,6 +720,7 @@
         'src/pipe_wrap.h',
         'src/req_wrap.h',
         'src/req_wrap-inl.h',
+        'src/request_latency.h',
         'src/spawn_sync.h',
         'src/stream_base.h',
         'src/stream_base-inl.h',
@@ -710,6 +731,7 @@
         'src/string_decoder-inl.h',
         'src/string_search.h',
         'src/tcp_wrap.h',
+        'src/timer_wheel.h',
         'src/tracing/agent.h',
         'src/tracing/node_trace_buffer.h',
         'src/tracing/node_trace_writer.h',
@@ -1144,6 +1166,7 @@
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
         'test/cctest/test_report_util.cc',
+        'test/cctest/test_simd.cc',
         'test/cctest/test_sockaddr.cc',
         'test/cctest/test_traced_value.cc',
         'test/cctest/test_util.cc',
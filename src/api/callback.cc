@@ -16,6 +16,7 @@ using v8::MicrotasksScope;
 using v8::NewStringType;
 using v8::Object;
 using v8::String;
+using v8::Undefined;
 using v8::Value;
 
 CallbackScope::CallbackScope(Isolate* isolate,
@@ -52,12 +53,22 @@ InternalCallbackScope::InternalCallbackScope(Environment* env,
     skip_task_queues_(flags & kSkipTaskQueues) {
   CHECK_NOT_NULL(env);
   env->PushAsyncCallbackScope();
+  if (env->async_callback_scope_depth() == 1)
+    env->performance_state()->LoopWakeup();
 
   if (!env->can_call_into_js()) {
     failed_ = true;
     return;
   }
 
+  // The frames are kept in the caller's HandleScope, so that Close() can
+  // still use them.
+  AsyncHooks* async_hooks = env->async_hooks();
+  if (async_hooks->uses_context_frames()) {
+    outer_context_frame_ = async_hooks->context_frame();
+    context_frame_ = async_hooks->enter_context_frame(object);
+  }
+
   HandleScope handle_scope(env->isolate());
   // If you hit this assertion, you forgot to enter the v8::Context first.
   CHECK_EQ(Environment::GetCurrent(env->isolate()), env);
@@ -92,9 +103,27 @@ void InternalCallbackScope::Close() {
     AsyncWrap::EmitAfter(env_, async_context_.async_id);
   }
 
+  // The stack may already have been unwound because of an uncaught exception,
+  // in which case the current frame does not belong to this resource anymore.
+  bool owns_context_frame =
+      env_->execution_async_id() == async_context_.async_id;
+
   if (pushed_ids_)
     env_->async_hooks()->pop_async_context(async_context_.async_id);
 
+  if (!context_frame_.IsEmpty()) {
+    HandleScope handle_scope(env_->isolate());
+    env_->async_hooks()->leave_context_frame(
+        owns_context_frame ? object_ : Local<Object>(),
+        context_frame_,
+        outer_context_frame_);
+  } else if (env_->async_hooks()->uses_context_frames()) {
+    // Frames were enabled while this callback was running, so there was none
+    // before it.
+    HandleScope handle_scope(env_->isolate());
+    env_->async_hooks()->set_context_frame(Undefined(env_->isolate()));
+  }
+
   if (failed_) return;
 
   if (env_->async_callback_scope_depth() > 1 || skip_task_queues_) {
@@ -233,6 +233,12 @@ static void PromiseHook(PromiseHookType type, Local<Promise> promise,
 
   Environment* env = Environment::GetCurrent(context);
   if (env == nullptr) return;
+
+  AsyncHooks* async_hooks = env->async_hooks();
+  if (async_hooks->uses_context_frames())
+    async_hooks->context_frame_promise_hook(type, promise);
+  if (!async_hooks->promise_hook_enabled()) return;
+
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "EnvPromiseHook", env);
 
@@ -327,18 +333,43 @@ static void SetupHooks(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// The PromiseHook is shared by async_hooks and async context frames, and
+// is only installed while one of them needs it.
+static void UpdatePromiseHook(Environment* env) {
+  AsyncHooks* async_hooks = env->async_hooks();
+
+  // The per-Isolate API provides no way of knowing whether there are multiple
+  // users of the PromiseHook. That hopefully goes away when V8 introduces
+  // a per-context API.
+  if (async_hooks->promise_hook_enabled() ||
+      async_hooks->uses_context_frames()) {
+    env->isolate()->SetPromiseHook(PromiseHook);
+  } else {
+    env->isolate()->SetPromiseHook(nullptr);
+  }
+}
+
+
 static void EnablePromiseHook(const FunctionCallbackInfo<Value>& args) {
-  args.GetIsolate()->SetPromiseHook(PromiseHook);
+  Environment* env = Environment::GetCurrent(args);
+  env->async_hooks()->set_promise_hook_enabled(true);
+  UpdatePromiseHook(env);
 }
 
 
 static void DisablePromiseHook(const FunctionCallbackInfo<Value>& args) {
-  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+  env->async_hooks()->set_promise_hook_enabled(false);
+  UpdatePromiseHook(env);
+}
 
-  // The per-Isolate API provides no way of knowing whether there are multiple
-  // users of the PromiseHook. That hopefully goes away when V8 introduces
-  // a per-context API.
-  isolate->SetPromiseHook(nullptr);
+
+// Starts propagating async context frames. This cannot be undone, because
+// resources that were created in the meantime already carry their frame.
+static void EnableContextFrames(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->async_hooks()->fields()[AsyncHooks::kUsesContextFrames] = 1;
+  UpdatePromiseHook(env);
 }
 
 
@@ -471,6 +502,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   env->SetMethod(target, "queueDestroyAsyncId", QueueDestroyAsyncId);
   env->SetMethod(target, "enablePromiseHook", EnablePromiseHook);
   env->SetMethod(target, "disablePromiseHook", DisablePromiseHook);
+  env->SetMethod(target, "enableContextFrames", EnableContextFrames);
   env->SetMethod(target, "registerDestroyHook", RegisterDestroyHook);
 
   PropertyAttribute ReadOnlyDontDelete =
@@ -508,6 +540,10 @@ void AsyncWrap::Initialize(Local<Object> target,
                          "execution_async_resources",
                          env->async_hooks()->execution_async_resources());
 
+  FORCE_SET_TARGET_FIELD(target,
+                         "async_context_frames",
+                         env->async_hooks()->async_context_frames());
+
   target->Set(context,
               env->async_ids_stack_string(),
               env->async_hooks()->async_ids_stack().GetJSArray()).Check();
@@ -516,6 +552,11 @@ void AsyncWrap::Initialize(Local<Object> target,
               FIXED_ONE_BYTE_STRING(env->isolate(), "owner_symbol"),
               env->owner_symbol()).Check();
 
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(),
+                                    "async_context_frame_symbol"),
+              env->async_context_frame_symbol()).Check();
+
   Local<Object> constants = Object::New(isolate);
 #define SET_HOOKS_CONSTANT(name)                                              \
   FORCE_SET_TARGET_FIELD(                                                     \
@@ -533,6 +574,7 @@ void AsyncWrap::Initialize(Local<Object> target,
   SET_HOOKS_CONSTANT(kAsyncIdCounter);
   SET_HOOKS_CONSTANT(kDefaultTriggerAsyncId);
   SET_HOOKS_CONSTANT(kStackLength);
+  SET_HOOKS_CONSTANT(kUsesContextFrames);
 #undef SET_HOOKS_CONSTANT
   FORCE_SET_TARGET_FIELD(target, "constants", constants);
 
@@ -678,6 +720,9 @@ void AsyncWrap::AsyncReset(Local<Object> resource, double execution_async_id,
     resource_.Reset(env()->isolate(), resource);
   }
 
+  if (env()->async_hooks()->uses_context_frames())
+    env()->async_hooks()->capture_context_frame(resource);
+
   switch (provider_type()) {
 #define V(PROVIDER)                                                           \
     case PROVIDER_ ## PROVIDER:                                               \
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_simd.h"
 #include "util.h"
 
 #include <cstddef>
@@ -85,6 +86,29 @@ bool base64_decode_group_slow(char* const dst, const size_t dstlen,
 }
 
 
+// The vectorized decoder only handles one-byte input.
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const char* const src, const size_t srclen) {
+  return simd::Base64Decode(dst, dstlen, src, srclen);
+}
+
+
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const uint8_t* const src,
+                                 const size_t srclen) {
+  return simd::Base64Decode(
+      dst, dstlen, reinterpret_cast<const char*>(src), srclen);
+}
+
+
+template <typename TypeName>
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const TypeName* const src,
+                                 const size_t srclen) {
+  return 0;
+}
+
+
 template <typename TypeName>
 size_t base64_decode_fast(char* const dst, const size_t dstlen,
                           const TypeName* const src, const size_t srclen,
@@ -95,17 +119,26 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   size_t i = 0;
   size_t k = 0;
   while (i < max_i && k < max_k) {
-    const uint32_t v =
-        unbase64(src[i + 0]) << 24 |
-        unbase64(src[i + 1]) << 16 |
-        unbase64(src[i + 2]) << 8 |
-        unbase64(src[i + 3]);
-    // If MSB is set, input contains whitespace or is not valid base64.
-    if (v & 0x80808080) {
-      if (!base64_decode_group_slow(dst, dstlen, src, srclen, &i, &k))
-        return k;
-      max_i = i + (srclen - i) / 4 * 4;  // Align max_i again.
-    } else {
+    // Decode runs of plain base64 characters with SIMD when possible.
+    const size_t n =
+        base64_decode_simd(dst + k, max_k - k, src + i, max_i - i);
+    i += n;
+    k += n / 4 * 3;
+    // Whatever stopped the SIMD decoder is handled by the scalar code, which
+    // hands back control after the next group that needs the slow path.
+    while (i < max_i && k < max_k) {
+      const uint32_t v =
+          unbase64(src[i + 0]) << 24 |
+          unbase64(src[i + 1]) << 16 |
+          unbase64(src[i + 2]) << 8 |
+          unbase64(src[i + 3]);
+      // If MSB is set, input contains whitespace or is not valid base64.
+      if (v & 0x80808080) {
+        if (!base64_decode_group_slow(dst, dstlen, src, srclen, &i, &k))
+          return k;
+        max_i = i + (srclen - i) / 4 * 4;  // Align max_i again.
+        break;
+      }
       dst[k + 0] = ((v >> 22) & 0xFC) | ((v >> 20) & 0x03);
       dst[k + 1] = ((v >> 12) & 0xF0) | ((v >> 10) & 0x0F);
       dst[k + 2] = ((v >>  2) & 0xC0) | ((v >>  0) & 0x3F);
@@ -148,8 +181,8 @@ static size_t base64_encode(const char* src,
                               "abcdefghijklmnopqrstuvwxyz"
                               "0123456789+/";
 
-  i = 0;
-  k = 0;
+  i = simd::Base64Encode(src, slen, dst);
+  k = i / 3 * 4;
   n = slen / 3 * 3;
 
   while (i < n) {
@@ -0,0 +1,75 @@
+#ifndef SRC_BLOB_SERIALIZER_H_
+#define SRC_BLOB_SERIALIZER_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace node {
+
+// Helpers for the files that are read at startup with --snapshot-blob and
+// --module-bundle. Values are stored in host byte order, and strings are
+// prefixed with their length, since the files are only ever read by the same
+// build that wrote them.
+
+template <typename T>
+inline void BlobWrite(std::string* out, T value) {
+  out->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline void BlobWriteString(std::string* out, const char* str, size_t length) {
+  BlobWrite<uint32_t>(out, static_cast<uint32_t>(length));
+  out->append(str, length);
+}
+
+inline void BlobWriteString(std::string* out, const std::string& str) {
+  BlobWriteString(out, str.data(), str.size());
+}
+
+class BlobReader {
+ public:
+  explicit BlobReader(const std::string& data) : data_(data) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    if (data_.size() - pos_ < sizeof(*value)) return false;
+    memcpy(value, data_.data() + pos_, sizeof(*value));
+    pos_ += sizeof(*value);
+    return true;
+  }
+
+  bool ReadString(std::string* str) {
+    const char* data;
+    uint32_t length;
+    if (!Read(&length) || !ReadBytes(length, &data)) return false;
+    str->assign(data, length);
+    return true;
+  }
+
+  bool ReadBytes(size_t length, const char** data) {
+    if (data_.size() - pos_ < length) return false;
+    *data = data_.data() + pos_;
+    pos_ += length;
+    return true;
+  }
+
+  bool ReadCount(uint32_t* count) {
+    // Every element takes up at least one byte, which rules out counts that
+    // would make us allocate huge vectors for malformed files.
+    return Read(count) && *count <= data_.size() - pos_;
+  }
+
+  bool AtEnd() const { return pos_ == data_.size(); }
+
+ private:
+  const std::string& data_;
+  size_t pos_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_BLOB_SERIALIZER_H_
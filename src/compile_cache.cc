@@ -0,0 +1,440 @@
+#include "compile_cache.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::Function;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+using v8::UnboundModuleScript;
+
+namespace {
+
+// Every cache file starts with this header, followed by the key of the
+// module that it belongs to (see CacheKey()) and the cache data.
+struct CacheHeader {
+  uint64_t code_hash;
+  uint32_t code_size;
+  uint32_t key_size;
+  uint32_t cache_size;
+  uint32_t cache_hash;
+};
+
+static_assert(sizeof(CacheHeader) == 24, "CacheHeader must not be padded");
+
+// Only detects corrupted cache data.
+uint32_t Crc32(const char* data, size_t length) {
+  // crc32() takes an uInt length, so feed large inputs in pieces.
+  uLong crc = 0;
+  const Bytef* bytes = reinterpret_cast<const Bytef*>(data);
+  while (length > 0) {
+    uInt chunk = static_cast<uInt>(std::min<size_t>(length, 1 << 30));
+    crc = crc32(crc, bytes, chunk);
+    bytes += chunk;
+    length -= chunk;
+  }
+  return static_cast<uint32_t>(crc);
+}
+
+// 64-bit FNV-1a, which names the cache files and identifies the source code
+// that a cache was created from. A 32-bit checksum collides far too easily
+// across all the modules and versions of them that share a cache directory.
+uint64_t Hash64(const char* data, size_t length) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (size_t i = 0; i < length; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+// Identifies a module in the caches of all threads and in its cache file.
+std::string CacheKey(CachedCodeType type, const std::string& filename) {
+  return (type == CachedCodeType::kCommonJS ? "cjs:" : "esm:") + filename;
+}
+
+std::string GetCacheVersionTag() {
+  // The V8 version is part of the name for readability; the tag also covers
+  // the V8 flags that affect whether a cache can be consumed.
+  char tag[16];
+  snprintf(tag, sizeof(tag), "%08x", ScriptCompiler::CachedDataVersionTag());
+  return std::string(v8::V8::GetVersion()) + "-" + tag;
+}
+
+// Writes the file under a temporary name first, so that other processes
+// never see a partially written cache.
+int WriteCacheFile(const std::string& path,
+                   const std::string& tmp_path,
+                   const std::string& contents) {
+  uv_buf_t buf = uv_buf_init(const_cast<char*>(contents.data()),
+                             static_cast<unsigned int>(contents.size()));
+  int err = WriteFileSync(tmp_path.c_str(), buf);
+  uv_fs_t req;
+  if (err == 0) {
+    err = uv_fs_rename(nullptr, &req, tmp_path.c_str(), path.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  if (err != 0) {
+    uv_fs_unlink(nullptr, &req, tmp_path.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  return err;
+}
+
+// The cache of a module that is shared between all threads.
+struct SharedCache {
+  uint64_t code_hash;
+  uint32_t code_size;
+  std::shared_ptr<ScriptCompiler::CachedData> cache;
+};
+
+// New caches are no longer shared once they take up this much memory.
+constexpr size_t kMaxSharedCacheSize = 64 * 1024 * 1024;
+
+Mutex shared_cache_mutex;
+std::unordered_map<std::string, SharedCache> shared_caches;
+size_t shared_cache_size = 0;
+
+struct CacheFile {
+  std::string path;
+  std::string tmp_path;
+  std::string contents;
+  int result = 0;
+};
+
+class CompileCacheWriteJob : public ThreadPoolWork {
+ public:
+  CompileCacheWriteJob(Environment* env, std::vector<CacheFile>&& files)
+      : ThreadPoolWork(env), files_(std::move(files)) {}
+
+  void DoThreadPoolWork() override {
+    for (CacheFile& file : files_)
+      file.result = WriteCacheFile(file.path, file.tmp_path, file.contents);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<CompileCacheWriteJob> self(this);
+    for (const CacheFile& file : files_) {
+      Debug(env(), DebugCategory::CODE_CACHE,
+            "[compile cache] wrote %s: %s\n",
+            file.path,
+            status != 0 ? uv_err_name(status) :
+                file.result != 0 ? uv_err_name(file.result) : "ok");
+    }
+  }
+
+ private:
+  std::vector<CacheFile> files_;
+};
+
+}  // anonymous namespace
+
+std::unique_ptr<CompileCacheHandler> CompileCacheHandler::Create(
+    Environment* env, const std::string& dir) {
+  if (dir.empty()) {
+    return std::unique_ptr<CompileCacheHandler>(
+        new CompileCacheHandler(env, std::string()));
+  }
+
+  std::string cache_dir = dir + kPathSeparator + GetCacheVersionTag();
+
+  fs::FSReqWrapSync req_wrap_sync;
+  int err = fs::MKDirpSync(nullptr, &req_wrap_sync.req, cache_dir, 0777,
+                           nullptr);
+  if (err < 0 && err != UV_EEXIST) {
+    fprintf(stderr,
+            "%s: Failed to create compile cache directory %s\n",
+            uv_err_name(err),
+            cache_dir.c_str());
+    return nullptr;
+  }
+
+  Debug(env, DebugCategory::CODE_CACHE,
+        "[compile cache] using %s\n", cache_dir);
+  return std::unique_ptr<CompileCacheHandler>(
+      new CompileCacheHandler(env, cache_dir));
+}
+
+CompileCacheHandler::CompileCacheHandler(Environment* env,
+                                         const std::string& cache_dir)
+    : env_(env), cache_dir_(cache_dir) {
+  env_->AddCleanupHook(CleanupHook, this);
+}
+
+CompileCacheHandler::~CompileCacheHandler() {
+  env_->RemoveCleanupHook(CleanupHook, this);
+}
+
+void CompileCacheHandler::CleanupHook(void* arg) {
+  // Whatever has not been written yet is written synchronously, since the
+  // event loop is not going to run again.
+  static_cast<CompileCacheHandler*>(arg)->Persist(true);
+}
+
+CompileCacheEntry* CompileCacheHandler::GetOrInsert(Local<String> code,
+                                                    Local<String> filename,
+                                                    CachedCodeType type) {
+  Isolate* isolate = env_->isolate();
+  Utf8Value filename_utf8(isolate, filename);
+  Utf8Value code_utf8(isolate, code);
+
+  std::string key = CacheKey(type, filename_utf8.ToString());
+  uint64_t code_hash = Hash64(*code_utf8, code_utf8.length());
+  uint32_t code_size = static_cast<uint32_t>(code_utf8.length());
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    CompileCacheEntry* entry = it->second.get();
+    if (entry->code_hash != code_hash || entry->code_size != code_size) {
+      // The file was changed and loaded again; the old cache is of no use.
+      entry->code_hash = code_hash;
+      entry->code_size = code_size;
+      entry->cache.reset();
+    }
+    if (entry->cache == nullptr)
+      ReadSharedCache(entry);
+    return entry;
+  }
+
+  auto entry = std::make_unique<CompileCacheEntry>();
+  char name[32];
+  snprintf(name, sizeof(name), "%016" PRIx64, Hash64(key.data(), key.size()));
+  entry->filename = filename_utf8.ToString();
+  entry->cache_filename =
+      cache_dir_.empty() ? name : cache_dir_ + kPathSeparator + name;
+  entry->code_hash = code_hash;
+  entry->code_size = code_size;
+  entry->type = type;
+  if (!cache_dir_.empty())
+    ReadCacheFile(entry.get());
+  if (entry->cache == nullptr)
+    ReadSharedCache(entry.get());
+  else
+    ShareCache(entry.get());
+
+  CompileCacheEntry* result = entry.get();
+  entries_.emplace(std::move(key), std::move(entry));
+  return result;
+}
+
+void CompileCacheHandler::ReadCacheFile(CompileCacheEntry* entry) {
+  std::string contents;
+  int err = ReadFileSync(&contents, entry->cache_filename.c_str());
+  if (err != 0) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] no cache for %s: %s\n",
+          entry->cache_filename, uv_err_name(err));
+    return;
+  }
+
+  CacheHeader header;
+  if (contents.size() < sizeof(header)) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] %s is truncated\n", entry->cache_filename);
+    return;
+  }
+  memcpy(&header, contents.data(), sizeof(header));
+
+  // Different modules can still end up with the same cache file name.
+  const std::string key = CacheKey(entry->type, entry->filename);
+  if (header.key_size != key.size() ||
+      contents.compare(sizeof(header), key.size(), key) != 0) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] %s was created for a different module\n",
+          entry->cache_filename);
+    return;
+  }
+
+  const char* data = contents.data() + sizeof(header) + key.size();
+  size_t data_size = contents.size() - sizeof(header) - key.size();
+  if (header.code_size != entry->code_size ||
+      header.code_hash != entry->code_hash) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] %s was created for different code\n",
+          entry->cache_filename);
+    return;
+  }
+  if (header.cache_size != data_size ||
+      header.cache_hash != Crc32(data, data_size)) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] %s is corrupted\n", entry->cache_filename);
+    return;
+  }
+
+  uint8_t* buffer = new uint8_t[data_size];
+  memcpy(buffer, data, data_size);
+  entry->cache = std::make_unique<ScriptCompiler::CachedData>(
+      buffer, static_cast<int>(data_size),
+      ScriptCompiler::CachedData::BufferOwned);
+  Debug(env_, DebugCategory::CODE_CACHE,
+        "[compile cache] read %d bytes from %s\n",
+        data_size, entry->cache_filename);
+}
+
+void CompileCacheHandler::ReadSharedCache(CompileCacheEntry* entry) {
+  {
+    Mutex::ScopedLock lock(shared_cache_mutex);
+    auto it = shared_caches.find(CacheKey(entry->type, entry->filename));
+    if (it == shared_caches.end() ||
+        it->second.code_hash != entry->code_hash ||
+        it->second.code_size != entry->code_size) {
+      return;
+    }
+    entry->cache = it->second.cache;
+  }
+  Debug(env_, DebugCategory::CODE_CACHE,
+        "[compile cache] using shared cache for %s\n", entry->cache_filename);
+}
+
+void CompileCacheHandler::ShareCache(CompileCacheEntry* entry) {
+  size_t size = static_cast<size_t>(entry->cache->length);
+  std::string key = CacheKey(entry->type, entry->filename);
+  {
+    Mutex::ScopedLock lock(shared_cache_mutex);
+    auto it = shared_caches.find(key);
+    size_t old_size = it != shared_caches.end() ?
+        static_cast<size_t>(it->second.cache->length) : 0;
+    if (shared_cache_size - old_size + size > kMaxSharedCacheSize)
+      return;
+    shared_cache_size = shared_cache_size - old_size + size;
+    shared_caches[std::move(key)] =
+        SharedCache { entry->code_hash, entry->code_size, entry->cache };
+  }
+  Debug(env_, DebugCategory::CODE_CACHE,
+        "[compile cache] shared %d bytes for %s\n",
+        size, entry->cache_filename);
+}
+
+ScriptCompiler::CachedData* CompileCacheHandler::CopyCache(
+    CompileCacheEntry* entry) {
+  CHECK_NOT_NULL(entry->cache);
+  return new ScriptCompiler::CachedData(
+      entry->cache->data,
+      entry->cache->length,
+      ScriptCompiler::CachedData::BufferNotOwned);
+}
+
+bool CompileCacheHandler::MaybeSave(CompileCacheEntry* entry, bool rejected) {
+  if (entry->cache != nullptr && !rejected) return false;
+
+  if (rejected) {
+    Debug(env_, DebugCategory::CODE_CACHE,
+          "[compile cache] V8 rejected %s\n", entry->cache_filename);
+    entry->cache.reset();
+  }
+
+  if (!entry->refreshed) {
+    entry->refreshed = true;
+    pending_.push_back(entry);
+  }
+  if (!persist_scheduled_) {
+    persist_scheduled_ = true;
+    // Give the code a chance to run first, so that the functions it calls
+    // have been compiled and are included in the cache.
+    env_->SetUnrefImmediate([](Environment* env) {
+      CompileCacheHandler* handler = env->compile_cache_handler();
+      if (handler != nullptr) handler->Persist(false);
+    });
+  }
+  return true;
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Function> fn,
+                                    bool rejected) {
+  CHECK_EQ(entry->type, CachedCodeType::kCommonJS);
+  if (!MaybeSave(entry, rejected)) return;
+  entry->fn.Reset(env_->isolate(), fn);
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Module> module,
+                                    bool rejected) {
+  CHECK_EQ(entry->type, CachedCodeType::kESM);
+  if (!MaybeSave(entry, rejected)) return;
+  // The unbound script is only available before the module is evaluated.
+  entry->unbound_script.Reset(env_->isolate(),
+                              module->GetUnboundModuleScript());
+}
+
+void CompileCacheHandler::Persist(bool sync) {
+  persist_scheduled_ = false;
+  if (pending_.empty()) return;
+
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+  std::vector<CacheFile> files;
+
+  for (CompileCacheEntry* entry : pending_) {
+    std::unique_ptr<ScriptCompiler::CachedData> cache;
+    if (entry->type == CachedCodeType::kCommonJS) {
+      Local<Function> fn = entry->fn.Get(isolate);
+      cache.reset(ScriptCompiler::CreateCodeCacheForFunction(fn));
+    } else {
+      Local<UnboundModuleScript> script = entry->unbound_script.Get(isolate);
+      cache.reset(ScriptCompiler::CreateCodeCache(script));
+    }
+    entry->refreshed = false;
+    entry->fn.Reset();
+    entry->unbound_script.Reset();
+    if (!cache || cache->length <= 0) continue;
+
+    entry->cache = std::move(cache);
+    ShareCache(entry);
+    if (cache_dir_.empty()) continue;
+
+    const char* data = reinterpret_cast<const char*>(entry->cache->data);
+    size_t data_size = static_cast<size_t>(entry->cache->length);
+    const std::string key = CacheKey(entry->type, entry->filename);
+    CacheHeader header;
+    header.code_hash = entry->code_hash;
+    header.code_size = entry->code_size;
+    header.key_size = static_cast<uint32_t>(key.size());
+    header.cache_size = static_cast<uint32_t>(data_size);
+    header.cache_hash = Crc32(data, data_size);
+
+    CacheFile file;
+    file.path = entry->cache_filename;
+    file.tmp_path = SPrintF("%s.%d-%d-%d.tmp",
+                            entry->cache_filename,
+                            uv_os_getpid(),
+                            env_->thread_id(),
+                            write_count_++);
+    file.contents.reserve(sizeof(header) + key.size() + data_size);
+    file.contents.append(reinterpret_cast<const char*>(&header),
+                         sizeof(header));
+    file.contents.append(key);
+    file.contents.append(data, data_size);
+    files.push_back(std::move(file));
+  }
+  pending_.clear();
+
+  if (files.empty()) return;
+
+  if (sync) {
+    for (const CacheFile& file : files) {
+      int err = WriteCacheFile(file.path, file.tmp_path, file.contents);
+      Debug(env_, DebugCategory::CODE_CACHE,
+            "[compile cache] wrote %s: %s\n",
+            file.path, err != 0 ? uv_err_name(err) : "ok");
+    }
+    return;
+  }
+
+  CompileCacheWriteJob* job = new CompileCacheWriteJob(env_, std::move(files));
+  job->ScheduleWork();
+}
+
+}  // namespace node
@@ -0,0 +1,110 @@
+#ifndef SRC_COMPILE_CACHE_H_
+#define SRC_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+enum class CachedCodeType : uint8_t {
+  kCommonJS = 0,
+  kESM,
+};
+
+struct CompileCacheEntry {
+  std::string filename;
+  std::string cache_filename;
+  uint64_t code_hash;
+  uint32_t code_size;
+  CachedCodeType type;
+  // The cache that was read from disk or taken from the cache shared by all
+  // threads, if it matched the source code.
+  std::shared_ptr<v8::ScriptCompiler::CachedData> cache;
+  // Set when a fresh cache should be written for this entry.
+  bool refreshed = false;
+  // The compiled code that a fresh cache is created from; only one of these
+  // is set, depending on the type.
+  v8::Global<v8::Function> fn;
+  v8::Global<v8::UnboundModuleScript> unbound_script;
+};
+
+// Keeps the V8 code cache of user-land CommonJS and ES modules in a directory
+// (--compile-cache-dir), so that later runs can skip compiling them. Cache
+// files are named after a hash of the module's type and filename, and hold
+// the full filename and a hash of the source that they were produced from,
+// both of which are checked before a cache is used. They live in a
+// subdirectory that is specific to the V8 version and flags, since V8 rejects
+// caches from any other.
+//
+// New caches are created on the main thread shortly after the code was
+// compiled, and are written to disk on the threadpool.
+//
+// Caches are also shared between all threads of the process in memory, the
+// same way as the code cache of the NativeModuleLoader: the first thread that
+// compiles a module provides the cache for all others. Worker threads always
+// have a handler for this, with an empty cache_dir() if no directory is used.
+class CompileCacheHandler {
+ public:
+  // Returns nullptr if the cache directory cannot be created. If dir is
+  // empty, only the in-memory cache is used.
+  static std::unique_ptr<CompileCacheHandler> Create(Environment* env,
+                                                     const std::string& dir);
+  ~CompileCacheHandler();
+
+  // Looks up the entry for a file, reading its cache from disk the first
+  // time. entry->cache is only set if it was produced from the same source.
+  CompileCacheEntry* GetOrInsert(v8::Local<v8::String> code,
+                                 v8::Local<v8::String> filename,
+                                 CachedCodeType type);
+  // Returns a CachedData that V8 can consume, which does not own the data
+  // of entry->cache.
+  v8::ScriptCompiler::CachedData* CopyCache(CompileCacheEntry* entry);
+  // Schedules a new cache to be written for the entry, unless the cache that
+  // it was compiled with was accepted by V8.
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Function> fn,
+                 bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Module> module,
+                 bool rejected);
+
+  // Creates the caches of all pending entries and writes them to disk,
+  // either on the threadpool or synchronously.
+  void Persist(bool sync);
+
+  const std::string& cache_dir() const { return cache_dir_; }
+
+  CompileCacheHandler(const CompileCacheHandler&) = delete;
+  CompileCacheHandler& operator=(const CompileCacheHandler&) = delete;
+
+ private:
+  CompileCacheHandler(Environment* env, const std::string& cache_dir);
+
+  void ReadCacheFile(CompileCacheEntry* entry);
+  void ReadSharedCache(CompileCacheEntry* entry);
+  void ShareCache(CompileCacheEntry* entry);
+  bool MaybeSave(CompileCacheEntry* entry, bool rejected);
+  static void CleanupHook(void* arg);
+
+  Environment* env_;
+  std::string cache_dir_;
+  // Keyed by the type and the filename of the module.
+  std::unordered_map<std::string, std::unique_ptr<CompileCacheEntry>> entries_;
+  std::vector<CompileCacheEntry*> pending_;
+  bool persist_scheduled_ = false;
+  uint64_t write_count_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_COMPILE_CACHE_H_
@@ -43,6 +43,8 @@ void FWrite(FILE* file, const std::string& str);
   V(INSPECTOR_SERVER)                                                          \
   V(INSPECTOR_PROFILER)                                                        \
   V(CODE_CACHE)                                                                \
+  V(MODULE_BUNDLE)                                                             \
+  V(FS)                                                                        \
   V(WASI)
 
 enum class DebugCategory {
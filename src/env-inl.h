@@ -68,6 +68,8 @@ inline AsyncHooks::AsyncHooks()
     : async_ids_stack_(env()->isolate(), 16 * 2),
       fields_(env()->isolate(), kFieldsCount),
       async_id_fields_(env()->isolate(), kUidFieldsCount) {
+  async_context_frames_.Reset(env()->isolate(),
+                              v8::Array::New(env()->isolate(), 1));
   clear_async_id_stack();
 
   // Always perform async_hooks checks, not just when async_hooks is enabled.
@@ -117,6 +119,10 @@ inline v8::Local<v8::Array> AsyncHooks::execution_async_resources() {
   return PersistentToLocal::Strong(execution_async_resources_);
 }
 
+inline v8::Local<v8::Array> AsyncHooks::async_context_frames() {
+  return PersistentToLocal::Strong(async_context_frames_);
+}
+
 inline v8::Local<v8::String> AsyncHooks::provider_string(int idx) {
   return providers_[idx].Get(env()->isolate());
 }
@@ -197,11 +203,77 @@ inline void AsyncHooks::clear_async_id_stack() {
   v8::HandleScope handle_scope(isolate);
   execution_async_resources_.Reset(isolate, v8::Array::New(isolate));
 
+  // Go back to the frame that was current outside of all callbacks, if JS
+  // remembered one.
+  v8::Local<v8::Array> frames = async_context_frames();
+  if (frames->Length() > 1) {
+    v8::Local<v8::Context> context = env()->context();
+    v8::Local<v8::Value> frame;
+    if (frames->Get(context, 1).ToLocal(&frame))
+      set_context_frame(frame);
+    USE(frames->Set(context,
+                    FIXED_ONE_BYTE_STRING(isolate, "length"),
+                    v8::Integer::New(isolate, 1)));
+  }
+
   async_id_fields_[kExecutionAsyncId] = 0;
   async_id_fields_[kTriggerAsyncId] = 0;
   fields_[kStackLength] = 0;
 }
 
+inline bool AsyncHooks::uses_context_frames() {
+  return fields_[kUsesContextFrames] > 0;
+}
+
+inline v8::Local<v8::Value> AsyncHooks::context_frame() {
+  v8::Local<v8::Value> frame;
+  if (!async_context_frames()->Get(env()->context(), 0).ToLocal(&frame))
+    return v8::Undefined(env()->isolate());
+  return frame;
+}
+
+inline void AsyncHooks::set_context_frame(v8::Local<v8::Value> frame) {
+  USE(async_context_frames()->Set(env()->context(), 0, frame));
+}
+
+inline void AsyncHooks::capture_context_frame(v8::Local<v8::Object> resource) {
+  USE(resource->Set(env()->context(),
+                    env()->async_context_frame_symbol(),
+                    context_frame()));
+}
+
+inline v8::Local<v8::Value> AsyncHooks::enter_context_frame(
+    v8::Local<v8::Object> resource) {
+  v8::Local<v8::Value> frame;
+  if (!resource->Get(env()->context(), env()->async_context_frame_symbol())
+          .ToLocal(&frame)) {
+    frame = v8::Undefined(env()->isolate());
+  }
+  set_context_frame(frame);
+  return frame;
+}
+
+inline void AsyncHooks::leave_context_frame(
+    v8::Local<v8::Object> resource,
+    v8::Local<v8::Value> entered_frame,
+    v8::Local<v8::Value> outer_frame) {
+  v8::Local<v8::Value> frame = context_frame();
+  if (!resource.IsEmpty() && !frame->StrictEquals(entered_frame)) {
+    USE(resource->Set(env()->context(),
+                      env()->async_context_frame_symbol(),
+                      frame));
+  }
+  set_context_frame(outer_frame);
+}
+
+inline bool AsyncHooks::promise_hook_enabled() const {
+  return promise_hook_enabled_;
+}
+
+inline void AsyncHooks::set_promise_hook_enabled(bool enabled) {
+  promise_hook_enabled_ = enabled;
+}
+
 // The DefaultTriggerAsyncIdScope(AsyncWrap*) constructor is defined in
 // async_wrap-inl.h to avoid a circular dependency.
 
@@ -266,6 +338,18 @@ inline void ImmediateInfo::ref_count_dec(uint32_t decrement) {
   fields_[kRefCount] -= decrement;
 }
 
+inline TimerListInfo::TimerListInfo(v8::Isolate* isolate)
+    : due_(isolate, kDueBatchSize),
+      updates_(isolate, 1 + 2 * kMaxUpdates) {}
+
+inline AliasedFloat64Array& TimerListInfo::due() {
+  return due_;
+}
+
+inline AliasedFloat64Array& TimerListInfo::updates() {
+  return updates_;
+}
+
 inline TickInfo::TickInfo(v8::Isolate* isolate)
     : fields_(isolate, kFieldsCount) {}
 
@@ -444,6 +528,10 @@ inline TickInfo* Environment::tick_info() {
   return &tick_info_;
 }
 
+inline TimerListInfo* Environment::timer_list_info() {
+  return &timer_list_info_;
+}
+
 inline uint64_t Environment::timer_base() const {
   return timer_base_;
 }
@@ -959,6 +1047,18 @@ inline performance::performance_state* Environment::performance_state() {
   return performance_state_.get();
 }
 
+inline CompileCacheHandler* Environment::compile_cache_handler() {
+  return compile_cache_handler_.get();
+}
+
+inline worker::WorkerIsolatePool* Environment::worker_isolate_pool() {
+  return worker_isolate_pool_.get();
+}
+
+inline RequestLatencyRecorder* Environment::request_latency_recorder() {
+  return request_latency_recorder_.get();
+}
+
 inline std::unordered_map<std::string, uint64_t>*
     Environment::performance_marks() {
   return &performance_marks_;
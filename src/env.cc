@@ -1,6 +1,7 @@
 #include "env.h"
 
 #include "async_wrap.h"
+#include "compile_cache.h"
 #include "debug_utils-inl.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
@@ -13,6 +14,7 @@
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
 #include "req_wrap-inl.h"
+#include "request_latency.h"
 #include "tracing/agent.h"
 #include "tracing/traced_value.h"
 #include "util-inl.h"
@@ -42,6 +44,8 @@ using v8::NewStringType;
 using v8::Number;
 using v8::Object;
 using v8::Private;
+using v8::Promise;
+using v8::PromiseHookType;
 using v8::SnapshotCreator;
 using v8::StackTrace;
 using v8::String;
@@ -300,6 +304,7 @@ Environment::Environment(IsolateData* isolate_data,
       isolate_data_(isolate_data),
       immediate_info_(context->GetIsolate()),
       tick_info_(context->GetIsolate()),
+      timer_list_info_(context->GetIsolate()),
       timer_base_(uv_now(isolate_data->event_loop())),
       exec_argv_(exec_args),
       argv_(args),
@@ -381,6 +386,23 @@ Environment::Environment(IsolateData* isolate_data,
     async_hooks_.no_force_checks();
   }
 
+  fs_io_uring_enabled = options_->experimental_fs_io_uring;
+
+  // Workers always share the code cache of the modules that they load with
+  // the rest of the process, with or without a cache directory.
+  if (!options_->compile_cache_dir.empty() || !is_main_thread()) {
+    compile_cache_handler_ =
+        CompileCacheHandler::Create(this, options_->compile_cache_dir);
+  }
+
+  // Only the main thread keeps Isolates around for the Workers it starts, so
+  // that the pool does not get multiplied by nested Workers.
+  if (is_main_thread() && isolate_data->platform() != nullptr &&
+      per_process::cli_options->worker_isolate_pool_size > 0) {
+    worker_isolate_pool_ = std::make_unique<worker::WorkerIsolatePool>(
+        this, per_process::cli_options->worker_isolate_pool_size);
+  }
+
   // TODO(joyeecheung): deserialize when the snapshot covers the environment
   // properties.
   CreateProperties();
@@ -398,6 +420,8 @@ Environment::~Environment() {
 
   HandleScope handle_scope(isolate());
 
+  compile_cache_handler_.reset();
+
 #if HAVE_INSPECTOR
   // Destroy inspector agent before erasing the context. The inspector
   // destructor depends on the context still being accessible.
@@ -472,6 +496,24 @@ void Environment::InitializeLibuv(bool start_profiler_idle_notifier) {
   uv_unref(reinterpret_cast<uv_handle_t*>(&idle_check_handle_));
   uv_unref(reinterpret_cast<uv_handle_t*>(&task_queues_async_));
 
+  // The check handle is started after immediate_check_handle_ so that it
+  // runs first, and the time spent running immediates is not counted as
+  // part of the poll phase.
+  uv_prepare_init(event_loop(), &loop_timing_prepare_handle_);
+  uv_check_init(event_loop(), &loop_timing_check_handle_);
+  uv_prepare_start(&loop_timing_prepare_handle_, [](uv_prepare_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::loop_timing_prepare_handle_, handle);
+    env->performance_state()->LoopPrepare();
+  });
+  uv_check_start(&loop_timing_check_handle_, [](uv_check_t* handle) {
+    Environment* env =
+        ContainerOf(&Environment::loop_timing_check_handle_, handle);
+    env->performance_state()->LoopCheck();
+  });
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_timing_prepare_handle_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&loop_timing_check_handle_));
+
   // Register clean-up cb to be called to clean up the handles
   // when the environment is freed, note that they are not cleaned in
   // the one environment per process setup, but will be called in
@@ -526,6 +568,14 @@ void Environment::RegisterHandleCleanups() {
       reinterpret_cast<uv_handle_t*>(&idle_check_handle_),
       close_and_finish,
       nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_timing_prepare_handle_),
+      close_and_finish,
+      nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(&loop_timing_check_handle_),
+      close_and_finish,
+      nullptr);
   RegisterHandleCleanup(
       reinterpret_cast<uv_handle_t*>(&task_queues_async_),
       close_and_finish,
@@ -554,6 +604,10 @@ void Environment::CleanupHandles() {
     uv_run(event_loop(), UV_RUN_ONCE);
   }
 
+  // This needs to wait until all Isolates that were being created for the
+  // pool on the threadpool have arrived.
+  worker_isolate_pool_.reset();
+
   file_handle_read_wrap_freelist_.clear();
 }
 
@@ -580,6 +634,11 @@ void Environment::StopProfilerIdleNotifier() {
   uv_check_stop(&idle_check_handle_);
 }
 
+void Environment::set_request_latency_recorder(
+    std::unique_ptr<RequestLatencyRecorder> recorder) {
+  request_latency_recorder_ = std::move(recorder);
+}
+
 void Environment::PrintSyncTrace() const {
   if (!trace_sync_io_) return;
 
@@ -738,9 +797,45 @@ void Environment::RequestInterruptFromV8() {
 
 void Environment::ScheduleTimer(int64_t duration_ms) {
   if (started_cleanup_) return;
+  timer_expiry_ = uv_now(event_loop()) - timer_base() + duration_ms;
   uv_timer_start(timer_handle(), RunTimers, duration_ms, 0);
 }
 
+void Environment::ScheduleTimerList(int64_t msecs, uint64_t expiry) {
+  // Changes that processTimers() has queued come first.
+  ApplyTimerListUpdates();
+  timer_wheel_.Schedule(msecs, expiry);
+
+  // RunTimers() takes care of the handle once it is running.
+  uv_handle_t* h = reinterpret_cast<uv_handle_t*>(timer_handle());
+  if (!uv_is_active(h) || expiry < timer_expiry_) {
+    uint64_t now = uv_now(event_loop()) - timer_base();
+    ScheduleTimer(expiry > now ? expiry - now : 0);
+  }
+}
+
+void Environment::UnscheduleTimerList(int64_t msecs) {
+  ApplyTimerListUpdates();
+  timer_wheel_.Unschedule(msecs);
+}
+
+void Environment::ApplyTimerListUpdates() {
+  AliasedFloat64Array& updates = timer_list_info_.updates();
+  size_t count = static_cast<size_t>(updates[0]);
+  if (count == 0)
+    return;
+  CHECK_LE(count, TimerListInfo::kMaxUpdates);
+  for (size_t i = 0; i < count; i++) {
+    int64_t msecs = static_cast<int64_t>(updates[1 + 2 * i]);
+    double expiry = updates[2 + 2 * i];
+    if (expiry < 0)
+      timer_wheel_.Unschedule(msecs);
+    else
+      timer_wheel_.Schedule(msecs, static_cast<uint64_t>(expiry));
+  }
+  updates[0] = 0;
+}
+
 void Environment::ToggleTimerRef(bool ref) {
   if (started_cleanup_) return;
 
@@ -753,6 +848,9 @@ void Environment::ToggleTimerRef(bool ref) {
 
 void Environment::RunTimers(uv_timer_t* handle) {
   Environment* env = Environment::from_timer_handle(handle);
+  performance::LoopPhaseScope phase_scope(
+      env->performance_state(),
+      performance::NODE_PERFORMANCE_LOOP_TIMING_TIMERS);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "RunTimers", env);
 
@@ -767,15 +865,49 @@ void Environment::RunTimers(uv_timer_t* handle) {
 
   Local<Function> cb = env->timers_callback_function();
   MaybeLocal<Value> ret;
-  Local<Value> arg = env->GetNow();
+  Local<Value> now = env->GetNow();
+  TimerWheel* wheel = &env->timer_wheel_;
+  wheel->Advance(now->IntegerValue(env->context()).FromJust());
+
+  // The due lists are passed to JS in batches, through
+  // timer_list_info()->due(). Lists that are left due because a timer threw
+  // are passed again, starting with a new batch.
+  AliasedFloat64Array& due_lists = env->timer_list_info()->due();
+  const std::vector<int64_t>* due = &wheel->GetDue();
+  size_t position = 0;
+  bool continued = false;
   // This code will loop until all currently due timers will process. It is
   // impossible for us to end up in an infinite loop due to how the JS-side
   // is structured.
-  do {
-    TryCatchScope try_catch(env);
-    try_catch.SetVerbose(true);
-    ret = cb->Call(env->context(), process, 1, &arg);
-  } while (ret.IsEmpty() && env->can_call_into_js());
+  for (;;) {
+    size_t count =
+        std::min(due->size() - position, TimerListInfo::kDueBatchSize);
+    for (size_t i = 0; i < count; i++)
+      due_lists[i] = static_cast<double>((*due)[position + i]);
+    Local<Value> argv[] = {
+      now,
+      Integer::NewFromUnsigned(env->isolate(), static_cast<uint32_t>(count)),
+      Boolean::New(env->isolate(), continued)
+    };
+    {
+      TryCatchScope try_catch(env);
+      try_catch.SetVerbose(true);
+      ret = cb->Call(env->context(), process, arraysize(argv), argv);
+    }
+    env->ApplyTimerListUpdates();
+    if (ret.IsEmpty()) {
+      if (!env->can_call_into_js())
+        break;
+      due = &wheel->GetDue();
+      position = 0;
+      continued = false;
+      continue;
+    }
+    position += count;
+    if (position >= due->size())
+      break;
+    continued = true;
+  }
 
   // NOTE(apapirovski): If it ever becomes possible that `call_into_js` above
   // is reset back to `true` after being previously set to `false` then this
@@ -785,25 +917,20 @@ void Environment::RunTimers(uv_timer_t* handle) {
   if (ret.IsEmpty())
     return;
 
-  // To allow for less JS-C++ boundary crossing, the value returned from JS
-  // serves a few purposes:
-  // 1. If it's 0, no more timers exist and the handle should be unrefed
-  // 2. If it's > 0, the value represents the next timer's expiry and there
-  //    is at least one timer remaining that is refed.
-  // 3. If it's < 0, the absolute value represents the next timer's expiry
-  //    and there are no timers that are refed.
-  int64_t expiry_ms =
-      ret.ToLocalChecked()->IntegerValue(env->context()).FromJust();
+  // The value returned from JS tells whether any of the remaining timers
+  // is refed.
+  bool refed = ret.ToLocalChecked()->IsTrue();
+  uint64_t expiry = env->timer_wheel_.NextExpiry();
 
   uv_handle_t* h = reinterpret_cast<uv_handle_t*>(handle);
 
-  if (expiry_ms != 0) {
-    int64_t duration_ms =
-        llabs(expiry_ms) - (uv_now(env->event_loop()) - env->timer_base());
+  if (expiry != TimerWheel::kNever) {
+    int64_t duration_ms = static_cast<int64_t>(expiry) -
+        static_cast<int64_t>(uv_now(env->event_loop()) - env->timer_base());
 
     env->ScheduleTimer(duration_ms > 0 ? duration_ms : 1);
 
-    if (expiry_ms > 0)
+    if (refed)
       uv_ref(h);
     else
       uv_unref(h);
@@ -815,6 +942,9 @@ void Environment::RunTimers(uv_timer_t* handle) {
 
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
+  performance::LoopPhaseScope phase_scope(
+      env->performance_state(),
+      performance::NODE_PERFORMANCE_LOOP_TIMING_CHECK);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
@@ -930,6 +1060,11 @@ void TickInfo::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("fields", fields_);
 }
 
+void TimerListInfo::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("due", due_);
+  tracker->TrackField("updates", updates_);
+}
+
 void AsyncHooks::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("providers", providers_);
   tracker->TrackField("async_ids_stack", async_ids_stack_);
@@ -946,6 +1081,50 @@ void AsyncHooks::grow_async_ids_stack() {
       async_ids_stack_.GetJSArray()).Check();
 }
 
+void AsyncHooks::context_frame_promise_hook(PromiseHookType type,
+                                            Local<Promise> promise) {
+  Isolate* isolate = env()->isolate();
+  Local<Context> context = env()->context();
+  HandleScope handle_scope(isolate);
+
+  switch (type) {
+    case PromiseHookType::kInit: {
+      Local<Value> frame = context_frame();
+      if (!frame->IsUndefined()) {
+        USE(promise->SetPrivate(context,
+                                env()->async_context_frame_private_symbol(),
+                                frame));
+      }
+      break;
+    }
+    case PromiseHookType::kBefore: {
+      // Promise reactions are run one at a time from the microtask queue,
+      // so a single slot is enough to restore the outer frame in kAfter.
+      Local<Value> frame;
+      if (!promise->GetPrivate(context,
+                               env()->async_context_frame_private_symbol())
+              .ToLocal(&frame)) {
+        frame = Undefined(isolate);
+      }
+      promise_outer_context_frame_.Reset(isolate, context_frame());
+      set_context_frame(frame);
+      break;
+    }
+    case PromiseHookType::kAfter: {
+      Local<Value> outer_frame = Undefined(isolate);
+      if (!promise_outer_context_frame_.IsEmpty()) {
+        outer_frame =
+            PersistentToLocal::Strong(promise_outer_context_frame_);
+      }
+      promise_outer_context_frame_.Reset();
+      set_context_frame(outer_frame);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
 uv_key_t Environment::thread_local_env = {};
 
 void Environment::Exit(int exit_code) {
@@ -967,6 +1146,9 @@ void Environment::Exit(int exit_code) {
   }
   if (is_main_thread()) {
     stop_sub_worker_contexts();
+    // The cleanup hooks do not run when exiting this way, so write out the
+    // compile cache here.
+    if (compile_cache_handler_) compile_cache_handler_->Persist(true);
     DisposePlatform();
     exit(exit_code);
   } else {
@@ -1026,6 +1208,8 @@ inline size_t Environment::SelfSize() const {
   size -= sizeof(async_hooks_);
   size -= sizeof(tick_info_);
   size -= sizeof(immediate_info_);
+  size -= sizeof(timer_list_info_);
+  size -= sizeof(timer_wheel_);
   return size;
 }
 
@@ -1048,6 +1232,10 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("async_hooks", async_hooks_);
   tracker->TrackField("immediate_info", immediate_info_);
   tracker->TrackField("tick_info", tick_info_);
+  tracker->TrackField("timer_list_info", timer_list_info_);
+  tracker->TrackField("timer_wheel", timer_wheel_);
+  tracker->TrackField("worker_isolate_pool", worker_isolate_pool_);
+  tracker->TrackField("request_latency_recorder", request_latency_recorder_);
 
 #define V(PropertyName, TypeName)                                              \
   tracker->TrackField(#PropertyName, PropertyName());
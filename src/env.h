@@ -37,6 +37,7 @@
 #include "node_main_instance.h"
 #include "node_options.h"
 #include "req_wrap.h"
+#include "timer_wheel.h"
 #include "util.h"
 #include "uv.h"
 #include "v8.h"
@@ -59,8 +60,12 @@ class ContextifyScript;
 class CompiledFnEntry;
 }
 
+class CompileCacheHandler;
+class RequestLatencyRecorder;
+
 namespace fs {
 class FileHandleReadWrap;
+class IoUring;
 }
 
 namespace performance {
@@ -85,6 +90,7 @@ class ParentInspectorHandle;
 
 namespace worker {
 class Worker;
+class WorkerIsolatePool;
 }
 
 namespace loader {
@@ -154,6 +160,7 @@ constexpr size_t kFsStatsBufferLength =
   V(alpn_buffer_private_symbol, "node:alpnBuffer")                            \
   V(arraybuffer_untransferable_private_symbol, "node:untransferableBuffer")   \
   V(arrow_message_private_symbol, "node:arrowMessage")                        \
+  V(async_context_frame_private_symbol, "node:asyncContextFrame")             \
   V(contextify_context_private_symbol, "node:contextify:context")             \
   V(contextify_global_private_symbol, "node:contextify:global")               \
   V(decorated_private_symbol, "node:decorated")                               \
@@ -162,6 +169,7 @@ constexpr size_t kFsStatsBufferLength =
 // Symbols are per-isolate primitives but Environment proxies them
 // for the sake of convenience.
 #define PER_ISOLATE_SYMBOL_PROPERTIES(V)                                       \
+  V(async_context_frame_symbol, "async_context_frame")                         \
   V(handle_onclose_symbol, "handle_onclose")                                   \
   V(no_message_symbol, "no_message_symbol")                                    \
   V(oninit_symbol, "oninit")                                                   \
@@ -632,6 +640,7 @@ class AsyncHooks : public MemoryRetainer {
     kTotals,
     kCheck,
     kStackLength,
+    kUsesContextFrames,
     kFieldsCount,
   };
 
@@ -647,6 +656,7 @@ class AsyncHooks : public MemoryRetainer {
   inline AliasedFloat64Array& async_id_fields();
   inline AliasedFloat64Array& async_ids_stack();
   inline v8::Local<v8::Array> execution_async_resources();
+  inline v8::Local<v8::Array> async_context_frames();
 
   inline v8::Local<v8::String> provider_string(int idx);
 
@@ -658,6 +668,33 @@ class AsyncHooks : public MemoryRetainer {
   inline bool pop_async_context(double async_id);
   inline void clear_async_id_stack();  // Used in fatal exceptions.
 
+  // Async context frames are opaque JS values that are propagated from the
+  // code that creates an async resource to the callbacks of that resource,
+  // and by the PromiseHook to promise reactions. None of this happens until
+  // the first frame is entered from JS, which sets kUsesContextFrames.
+  inline bool uses_context_frames();
+  inline v8::Local<v8::Value> context_frame();
+  inline void set_context_frame(v8::Local<v8::Value> frame);
+  // Stores the current frame on |resource|, so that it becomes current
+  // while the callbacks of |resource| are running.
+  inline void capture_context_frame(v8::Local<v8::Object> resource);
+  // Makes the frame of |resource| current and returns it.
+  inline v8::Local<v8::Value> enter_context_frame(
+      v8::Local<v8::Object> resource);
+  // Unless |resource| is empty, writes the current frame back to it when it
+  // is no longer |entered_frame|, so that entering a frame from a callback
+  // carries over to later callbacks. Then makes |outer_frame| current again.
+  inline void leave_context_frame(v8::Local<v8::Object> resource,
+                                  v8::Local<v8::Value> entered_frame,
+                                  v8::Local<v8::Value> outer_frame);
+  // Propagates frames from where promises are created to their reactions.
+  void context_frame_promise_hook(v8::PromiseHookType type,
+                                  v8::Local<v8::Promise> promise);
+
+  // Whether the PromiseHook should emit async_hooks events for promises.
+  inline bool promise_hook_enabled() const;
+  inline void set_promise_hook_enabled(bool enabled);
+
   AsyncHooks(const AsyncHooks&) = delete;
   AsyncHooks& operator=(const AsyncHooks&) = delete;
   AsyncHooks(AsyncHooks&&) = delete;
@@ -702,6 +739,13 @@ class AsyncHooks : public MemoryRetainer {
   void grow_async_ids_stack();
 
   v8::Global<v8::Array> execution_async_resources_;
+  // Index 0 holds the current context frame. The other indices are used by
+  // pushAsyncContext() in JS to remember the frame that was current before
+  // each entry of the async ID stack.
+  v8::Global<v8::Array> async_context_frames_;
+  // The frame that was current before the running promise reaction.
+  v8::Global<v8::Value> promise_outer_context_frame_;
+  bool promise_hook_enabled_ = false;
 };
 
 class ImmediateInfo : public MemoryRetainer {
@@ -732,6 +776,39 @@ class ImmediateInfo : public MemoryRetainer {
   AliasedUint32Array fields_;
 };
 
+// Memory that RunTimers() shares with processTimers() in JS, so that the due
+// timer lists can be passed to JS and changes to the timing wheel made while
+// the timers run can be passed back without allocating or calling into C++.
+class TimerListInfo : public MemoryRetainer {
+ public:
+  // How many due lists are passed to processTimers() at a time, and how many
+  // changes it queues before it has them applied.
+  static constexpr size_t kDueBatchSize = 64;
+  static constexpr size_t kMaxUpdates = 64;
+
+  inline AliasedFloat64Array& due();
+  inline AliasedFloat64Array& updates();
+
+  TimerListInfo(const TimerListInfo&) = delete;
+  TimerListInfo& operator=(const TimerListInfo&) = delete;
+  TimerListInfo(TimerListInfo&&) = delete;
+  TimerListInfo& operator=(TimerListInfo&&) = delete;
+  ~TimerListInfo() = default;
+
+  SET_MEMORY_INFO_NAME(TimerListInfo)
+  SET_SELF_SIZE(TimerListInfo)
+  void MemoryInfo(MemoryTracker* tracker) const override;
+
+ private:
+  friend class Environment;  // So we can call the constructor.
+  inline explicit TimerListInfo(v8::Isolate* isolate);
+
+  AliasedFloat64Array due_;
+  // Index 0 holds the number of queued changes. They follow as pairs of the
+  // duration of a list and its new expiry time, or -1 if it was removed.
+  AliasedFloat64Array updates_;
+};
+
 class TickInfo : public MemoryRetainer {
  public:
   inline AliasedUint8Array& fields();
@@ -936,6 +1013,7 @@ class Environment : public MemoryRetainer {
   inline AsyncHooks* async_hooks();
   inline ImmediateInfo* immediate_info();
   inline TickInfo* tick_info();
+  inline TimerListInfo* timer_list_info();
   inline uint64_t timer_base() const;
   inline std::shared_ptr<KVStore> env_vars();
   inline void set_env_vars(std::shared_ptr<KVStore> env_vars);
@@ -986,6 +1064,17 @@ class Environment : public MemoryRetainer {
       id_to_script_map;
   std::unordered_map<uint32_t, contextify::CompiledFnEntry*> id_to_function_map;
 
+  // Results of the module loader's stat() calls. They are only kept while a
+  // top-level require() call runs, like the loader's own stat cache.
+  std::unordered_map<std::string, int> module_stat_cache;
+  bool module_stat_cache_enabled = false;
+
+  // Whether async fs requests go through io_uring, see node_file_uring.h.
+  // The ring is created on first use and owns itself.
+  bool fs_io_uring_enabled = false;
+  bool fs_io_uring_unavailable = false;
+  fs::IoUring* fs_io_uring = nullptr;
+
   inline uint32_t get_next_module_id();
   inline uint32_t get_next_script_id();
   inline uint32_t get_next_function_id();
@@ -1019,6 +1108,12 @@ class Environment : public MemoryRetainer {
       file_handle_read_wrap_freelist();
 
   inline performance::performance_state* performance_state();
+  inline CompileCacheHandler* compile_cache_handler();
+  inline worker::WorkerIsolatePool* worker_isolate_pool();
+  // This is only set while request latency tracking is enabled.
+  inline RequestLatencyRecorder* request_latency_recorder();
+  void set_request_latency_recorder(
+      std::unique_ptr<RequestLatencyRecorder> recorder);
   inline std::unordered_map<std::string, uint64_t>* performance_marks();
 
   void CollectUVExceptionInfo(v8::Local<v8::Value> context,
@@ -1203,6 +1298,13 @@ class Environment : public MemoryRetainer {
   v8::Local<v8::Value> GetNow();
   void ScheduleTimer(int64_t duration);
   void ToggleTimerRef(bool ref);
+  // JS timer lists are keyed by the duration of their timers, and |expiry|
+  // is relative to timer_base().
+  void ScheduleTimerList(int64_t msecs, uint64_t expiry);
+  void UnscheduleTimerList(int64_t msecs);
+  // Applies the changes that processTimers() has queued in
+  // timer_list_info()->updates().
+  void ApplyTimerListUpdates();
 
   inline void AddCleanupHook(void (*fn)(void*), void* arg);
   inline void RemoveCleanupHook(void (*fn)(void*), void* arg);
@@ -1274,6 +1376,9 @@ class Environment : public MemoryRetainer {
   uv_idle_t immediate_idle_handle_;
   uv_prepare_t idle_prepare_handle_;
   uv_check_t idle_check_handle_;
+  // These time the phases of the event loop, see performance_state.
+  uv_prepare_t loop_timing_prepare_handle_;
+  uv_check_t loop_timing_check_handle_;
   uv_async_t task_queues_async_;
   int64_t task_queues_async_refs_ = 0;
   bool profiler_idle_notifier_started_ = false;
@@ -1281,7 +1386,11 @@ class Environment : public MemoryRetainer {
   AsyncHooks async_hooks_;
   ImmediateInfo immediate_info_;
   TickInfo tick_info_;
+  TimerListInfo timer_list_info_;
   const uint64_t timer_base_;
+  TimerWheel timer_wheel_;
+  // When timer_handle_ fires next, relative to timer_base_.
+  uint64_t timer_expiry_ = 0;
   std::shared_ptr<KVStore> env_vars_;
   bool printed_error_ = false;
   bool trace_sync_io_ = false;
@@ -1329,6 +1438,9 @@ class Environment : public MemoryRetainer {
   AliasedInt32Array stream_base_state_;
 
   std::unique_ptr<performance::performance_state> performance_state_;
+  std::unique_ptr<CompileCacheHandler> compile_cache_handler_;
+  std::unique_ptr<worker::WorkerIsolatePool> worker_isolate_pool_;
+  std::unique_ptr<RequestLatencyRecorder> request_latency_recorder_;
   std::unordered_map<std::string, uint64_t> performance_marks_;
 
   bool has_run_bootstrapping_code_ = false;
@@ -21,13 +21,30 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "memory_tracker-inl.h"
 #include "node.h"
 #include "handle_wrap.h"
 #include "string_bytes.h"
-
+#include "util-inl.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace node {
 
+using v8::Array;
+using v8::Boolean;
 using v8::Context;
 using v8::DontDelete;
 using v8::DontEnum;
@@ -35,6 +52,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
@@ -42,6 +60,7 @@ using v8::PropertyAttribute;
 using v8::ReadOnly;
 using v8::Signature;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 namespace {
@@ -230,7 +249,500 @@ void FSEventWrap::OnEvent(uv_fs_event_t* handle, const char* filename,
   wrap->MakeCallback(env->onchange_string(), arraysize(argv), argv);
 }
 
+
+// Watches a file or directory tree and reports changes in batches. Events
+// that arrive within `delay` milliseconds of the first one are collected and
+// coalesced per path, so that a burst of writes to a file is reported once,
+// and only one callback into JS is made for the whole batch.
+//
+// On Linux, all directories of the tree are watched through one inotify file
+// descriptor, polled by a single handle, rather than one uv_fs_event_t per
+// directory. Elsewhere, a single (recursive, where requested) uv_fs_event_t
+// feeds the same batching.
+class FSEventBatchWrap : public HandleWrap {
+ public:
+  static void Initialize(Environment* env, Local<Object> target);
+  static void New(const FunctionCallbackInfo<Value>& args);
+  static void Start(const FunctionCallbackInfo<Value>& args);
+
+  void Close(Local<Value> close_callback = Local<Value>()) override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(FSEventBatchWrap)
+  SET_SELF_SIZE(FSEventBatchWrap)
+
+ private:
+  static const encoding kDefaultEncoding = UTF8;
+
+  // Bits of the events that are reported for each path.
+  enum Events : uint32_t {
+    kRename = 1 << 0,
+    kChange = 1 << 1,
+  };
+
+  FSEventBatchWrap(Environment* env, Local<Object> object);
+  ~FSEventBatchWrap() override = default;
+
+  // Starts watching path_. Returns a libuv error code. Sets *initialized once
+  // handle_ needs to be closed, even if watching fails afterwards.
+  int StartWatching(bool recursive, bool* initialized);
+  void Record(std::string&& filename, uint32_t events);
+  void ScheduleFlush();
+  void EmitError(int status);
+
+  static void OnTimer(uv_timer_t* timer);
+  void Flush();
+
+#ifdef __linux__
+  void OnClose() override;
+  int AddWatches(const std::string& relative, bool report);
+  void RemoveWatches(const std::string& relative);
+  void ReadEvents();
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+
+  uv_poll_t handle_;
+  int inotify_fd_ = -1;
+  bool recursive_ = false;
+  // The name under which changes of the watched file are reported, if it is
+  // not a directory.
+  std::string file_name_;
+  // Watch descriptor -> directory, relative to path_.
+  std::unordered_map<int, std::string> watches_;
+#else
+  static void OnEvent(uv_fs_event_t* handle,
+                      const char* filename,
+                      int events,
+                      int status);
+
+  uv_fs_event_t handle_;
+#endif
+
+  std::string path_;
+  uint64_t delay_ = 0;
+  enum encoding encoding_ = kDefaultEncoding;
+  // Fires delay_ ms after the first event of a batch. It is allocated
+  // separately because it may outlive the wrap while it is being closed.
+  uv_timer_t* timer_ = nullptr;
+  // The changes of the current batch, in the order in which they were first
+  // seen, and the index of each path in it.
+  std::vector<std::pair<std::string, uint32_t>> changes_;
+  std::unordered_map<std::string, size_t> change_index_;
+  // Set when the kernel dropped events, so that the batch is incomplete.
+  bool overflow_ = false;
+};
+
+
+FSEventBatchWrap::FSEventBatchWrap(Environment* env, Local<Object> object)
+    : HandleWrap(env,
+                 object,
+                 reinterpret_cast<uv_handle_t*>(&handle_),
+                 AsyncWrap::PROVIDER_FSEVENTWRAP) {
+  MarkAsUninitialized();
+}
+
+
+void FSEventBatchWrap::Initialize(Environment* env, Local<Object> target) {
+  auto fsevent_batch_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "FSEventBatch");
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  t->InstanceTemplate()->SetInternalFieldCount(
+      FSEventBatchWrap::kInternalFieldCount);
+  t->SetClassName(fsevent_batch_string);
+
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(t, "start", Start);
+
+  target->Set(env->context(),
+              fsevent_batch_string,
+              t->GetFunction(env->context()).ToLocalChecked()).Check();
+}
+
+
+void FSEventBatchWrap::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new FSEventBatchWrap(env, args.This());
+}
+
+
+// wrap.start(filename, persistent, recursive, delay, encoding)
+void FSEventBatchWrap::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  FSEventBatchWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(wrap->IsHandleClosing());  // Check that Start() has not been called.
+
+  CHECK_GE(args.Length(), 5);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  wrap->path_ = std::string(*path, path.length());
+
+  CHECK(args[3]->IsUint32());
+  wrap->delay_ = args[3].As<Uint32>()->Value();
+  wrap->encoding_ = ParseEncoding(env->isolate(), args[4], kDefaultEncoding);
+
+  bool initialized = false;
+  int err = wrap->StartWatching(args[2]->IsTrue(), &initialized);
+  if (initialized)
+    wrap->MarkAsInitialized();
+  if (err != 0) {
+    wrap->Close();
+    return args.GetReturnValue().Set(err);
+  }
+
+  wrap->timer_ = new uv_timer_t();
+  CHECK_EQ(uv_timer_init(env->event_loop(), wrap->timer_), 0);
+  wrap->timer_->data = wrap;
+  // Whether the loop is kept alive is up to the watcher itself.
+  uv_unref(reinterpret_cast<uv_handle_t*>(wrap->timer_));
+
+  if (!args[1]->IsTrue())
+    uv_unref(wrap->GetHandle());
+
+  args.GetReturnValue().Set(0);
+}
+
+
+void FSEventBatchWrap::Close(Local<Value> close_callback) {
+  if (timer_ != nullptr) {
+    uv_close(reinterpret_cast<uv_handle_t*>(timer_), [](uv_handle_t* handle) {
+      delete reinterpret_cast<uv_timer_t*>(handle);
+    });
+    timer_ = nullptr;
+  }
+  HandleWrap::Close(close_callback);
+}
+
+
+void FSEventBatchWrap::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("changes",
+                              changes_.size() * (sizeof(changes_[0]) +
+                                                 sizeof(size_t)));
+#ifdef __linux__
+  tracker->TrackFieldWithSize("watches",
+                              watches_.size() * (sizeof(int) +
+                                                 sizeof(std::string)));
+#endif
+}
+
+
+void FSEventBatchWrap::Record(std::string&& filename, uint32_t events) {
+  auto it = change_index_.find(filename);
+  if (it == change_index_.end()) {
+    change_index_.emplace(filename, changes_.size());
+    changes_.emplace_back(std::move(filename), events);
+  } else {
+    changes_[it->second].second |= events;
+  }
+  ScheduleFlush();
+}
+
+
+void FSEventBatchWrap::ScheduleFlush() {
+  if (timer_ != nullptr &&
+      !uv_is_active(reinterpret_cast<uv_handle_t*>(timer_))) {
+    uv_timer_start(timer_, OnTimer, delay_, 0);
+  }
+}
+
+
+void FSEventBatchWrap::OnTimer(uv_timer_t* timer) {
+  static_cast<FSEventBatchWrap*>(timer->data)->Flush();
+}
+
+
+// Calls onchange(0, filenames, events, overflow) with the changes of the
+// current batch.
+void FSEventBatchWrap::Flush() {
+  if (IsHandleClosing() || (changes_.empty() && !overflow_))
+    return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  std::vector<Local<Value>> filenames(changes_.size());
+  std::vector<Local<Value>> events(changes_.size());
+  for (size_t i = 0; i < changes_.size(); i++) {
+    const std::string& filename = changes_[i].first;
+    Local<Value> error;
+    MaybeLocal<Value> value = StringBytes::Encode(isolate,
+                                                  filename.data(),
+                                                  filename.size(),
+                                                  encoding_,
+                                                  &error);
+    // Report names that cannot be represented in the requested encoding as
+    // Buffers.
+    if (value.IsEmpty()) {
+      value = StringBytes::Encode(isolate,
+                                  filename.data(),
+                                  filename.size(),
+                                  BUFFER,
+                                  &error);
+    }
+    filenames[i] = value.ToLocalChecked();
+    // A rename implies a change, as with FSEventWrap.
+    events[i] = (changes_[i].second & kRename) ? env->rename_string()
+                                               : env->change_string();
+  }
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, 0),
+    Array::New(isolate, filenames.data(), filenames.size()),
+    Array::New(isolate, events.data(), events.size()),
+    Boolean::New(isolate, overflow_)
+  };
+
+  changes_.clear();
+  change_index_.clear();
+  overflow_ = false;
+
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+
+
+// Calls onchange(status). The watcher is closed from JS afterwards.
+void FSEventBatchWrap::EmitError(int status) {
+  if (IsHandleClosing())
+    return;
+
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[] = { Integer::New(env->isolate(), status) };
+  MakeCallback(env->onchange_string(), arraysize(argv), argv);
+}
+
+
+#ifdef __linux__
+
+constexpr uint32_t kInotifyMask = IN_ATTRIB | IN_CREATE | IN_MODIFY |
+                                  IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF |
+                                  IN_MOVED_FROM | IN_MOVED_TO;
+
+// The events that change the set of names in a directory.
+constexpr uint32_t kInotifyRenameMask = IN_CREATE | IN_DELETE |
+                                        IN_DELETE_SELF | IN_MOVE_SELF |
+                                        IN_MOVED_FROM | IN_MOVED_TO;
+
+
+int FSEventBatchWrap::StartWatching(bool recursive, bool* initialized) {
+  recursive_ = recursive;
+
+  struct stat st;
+  if (stat(path_.c_str(), &st) != 0)
+    return -errno;
+
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0)
+    return -errno;
+
+  int err = uv_poll_init(env()->event_loop(), &handle_, inotify_fd_);
+  if (err != 0) {
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+    return err;
+  }
+  // From here on, inotify_fd_ is closed along with handle_.
+  *initialized = true;
+
+  if (S_ISDIR(st.st_mode)) {
+    err = AddWatches("", false);
+  } else {
+    // Like FSEventWrap, report changes under the name of the file.
+    const size_t slash = path_.find_last_of('/');
+    file_name_ = slash == std::string::npos ? path_ : path_.substr(slash + 1);
+    const int wd = inotify_add_watch(inotify_fd_, path_.c_str(), kInotifyMask);
+    err = wd < 0 ? -errno : 0;
+    if (wd >= 0)
+      watches_.emplace(wd, "");
+  }
+
+  if (err == 0)
+    err = uv_poll_start(&handle_, UV_READABLE, OnPoll);
+  return err;
+}
+
+
+void FSEventBatchWrap::OnClose() {
+  if (inotify_fd_ >= 0)
+    close(inotify_fd_);
+  inotify_fd_ = -1;
+  watches_.clear();
+}
+
+
+// Watches the directory at `relative`, and with recursive_ all directories
+// below it. With `report`, everything that is found is recorded as a change,
+// because it may have been created before the watch was in place.
+int FSEventBatchWrap::AddWatches(const std::string& relative, bool report) {
+  std::vector<std::string> pending { relative };
+  while (!pending.empty()) {
+    const std::string dir = std::move(pending.back());
+    pending.pop_back();
+    const std::string path = dir.empty() ? path_ : path_ + '/' + dir;
+
+    const int wd = inotify_add_watch(inotify_fd_, path.c_str(),
+                                     kInotifyMask | IN_ONLYDIR);
+    if (wd < 0) {
+      // The watch limit is reached, or the watched directory itself is gone.
+      if (errno == ENOSPC || dir.empty())
+        return -errno;
+      // Subdirectories may disappear before they are watched.
+      continue;
+    }
+    watches_[wd] = dir;
+
+    if (!recursive_ && !report)
+      continue;
+
+    DIR* handle = opendir(path.c_str());
+    if (handle == nullptr)
+      continue;
+    while (struct dirent* ent = readdir(handle)) {
+      if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0)
+        continue;
+      std::string child = dir.empty() ? ent->d_name : dir + '/' + ent->d_name;
+      bool is_dir = ent->d_type == DT_DIR;
+      if (ent->d_type == DT_UNKNOWN) {
+        struct stat st;
+        const std::string child_path = path_ + '/' + child;
+        is_dir = lstat(child_path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+      }
+      if (report)
+        Record(std::string(child), kRename);
+      if (recursive_ && is_dir)
+        pending.emplace_back(std::move(child));
+    }
+    closedir(handle);
+  }
+  return 0;
+}
+
+
+// Stops watching the directory at `relative` and everything below it, after
+// it was moved away.
+void FSEventBatchWrap::RemoveWatches(const std::string& relative) {
+  const std::string prefix = relative + '/';
+  for (auto it = watches_.begin(); it != watches_.end();) {
+    if (it->second == relative ||
+        it->second.compare(0, prefix.size(), prefix) == 0) {
+      inotify_rm_watch(inotify_fd_, it->first);
+      it = watches_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+
+void FSEventBatchWrap::ReadEvents() {
+  alignas(struct inotify_event) char buf[64 * 1024];
+
+  for (;;) {
+    const ssize_t size = read(inotify_fd_, buf, sizeof(buf));
+    if (size < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        EmitError(-errno);
+      return;
+    }
+
+    for (const char* p = buf; p < buf + size;) {
+      const struct inotify_event* event =
+          reinterpret_cast<const struct inotify_event*>(p);
+      p += sizeof(*event) + event->len;
+
+      if (event->mask & IN_Q_OVERFLOW) {
+        overflow_ = true;
+        ScheduleFlush();
+        continue;
+      }
+
+      auto it = watches_.find(event->wd);
+      if (it == watches_.end())
+        continue;
+      if (event->mask & IN_IGNORED) {
+        watches_.erase(it);
+        continue;
+      }
+
+      std::string filename;
+      if (!file_name_.empty())
+        filename = file_name_;
+      else if (event->len == 0 || event->name[0] == '\0')
+        filename = it->second;
+      else if (it->second.empty())
+        filename = event->name;
+      else
+        filename = it->second + '/' + event->name;
+
+      Record(std::string(filename),
+             (event->mask & kInotifyRenameMask) ? kRename : kChange);
+
+      if (!recursive_ || !(event->mask & IN_ISDIR) || !file_name_.empty())
+        continue;
+      if (event->mask & IN_MOVED_FROM)
+        RemoveWatches(filename);
+      if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+        const int err = AddWatches(filename, true);
+        if (err == UV_ENOSPC)
+          return EmitError(err);
+      }
+    }
+  }
+}
+
+
+void FSEventBatchWrap::OnPoll(uv_poll_t* handle, int status, int events) {
+  FSEventBatchWrap* wrap = static_cast<FSEventBatchWrap*>(handle->data);
+  if (status < 0)
+    return wrap->EmitError(status);
+  wrap->ReadEvents();
+}
+
+#else  // !__linux__
+
+int FSEventBatchWrap::StartWatching(bool recursive, bool* initialized) {
+  int err = uv_fs_event_init(env()->event_loop(), &handle_);
+  if (err != 0)
+    return err;
+  *initialized = true;
+  return uv_fs_event_start(&handle_,
+                           OnEvent,
+                           path_.c_str(),
+                           recursive ? UV_FS_EVENT_RECURSIVE : 0);
+}
+
+
+void FSEventBatchWrap::OnEvent(uv_fs_event_t* handle,
+                               const char* filename,
+                               int events,
+                               int status) {
+  FSEventBatchWrap* wrap = static_cast<FSEventBatchWrap*>(handle->data);
+  if (status < 0)
+    return wrap->EmitError(status);
+  wrap->Record(filename != nullptr ? filename : "",
+               (events & UV_RENAME) ? kRename : kChange);
+}
+
+#endif  // __linux__
+
+
+void InitializeFSEventWrap(Local<Object> target,
+                           Local<Value> unused,
+                           Local<Context> context,
+                           void* priv) {
+  FSEventWrap::Initialize(target, unused, context, priv);
+  FSEventBatchWrap::Initialize(Environment::GetCurrent(context), target);
+}
+
 }  // anonymous namespace
 }  // namespace node
 
-NODE_MODULE_CONTEXT_AWARE_INTERNAL(fs_event_wrap, node::FSEventWrap::Initialize)
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(fs_event_wrap, node::InitializeFSEventWrap)
@@ -17,6 +17,10 @@ bool Histogram::Record(int64_t value) {
   return hdr_record_value(histogram_.get(), value);
 }
 
+int64_t Histogram::Add(const Histogram& other) {
+  return hdr_add(histogram_.get(), other.histogram_.get());
+}
+
 int64_t Histogram::Min() {
   return hdr_min(histogram_.get());
 }
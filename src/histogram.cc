@@ -1,15 +1,24 @@
 #include "histogram.h"  // NOLINT(build/include_inline)
 #include "histogram-inl.h"
 #include "memory_tracker-inl.h"
+#include "node_errors.h"
+#include "node_mutex.h"
+
+#include <algorithm>
+#include <unordered_map>
 
 namespace node {
 
+using v8::BackingStore;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Integer;
 using v8::Local;
 using v8::Map;
 using v8::Number;
+using v8::Object;
 using v8::ObjectTemplate;
+using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Value;
 
@@ -138,4 +147,338 @@ void HistogramBase::Initialize(Environment* env) {
   env->set_histogram_instance_template(histogramt);
 }
 
+// The values recorded by one thread. The mutex is only contended while the
+// histogram is being read from another thread.
+struct HistogramShard {
+  HistogramShard(int64_t lowest, int64_t highest, int figures)
+      : histogram(lowest, highest, figures) {}
+
+  Mutex mutex;
+  Histogram histogram;
+  int64_t exceeds = 0;
+};
+
+// Locks are always taken in the order SharedHistogram::mutex, then
+// HistogramShard::mutex.
+struct SharedHistogram {
+  SharedHistogram(int64_t lowest, int64_t highest, int figures)
+      : lowest(lowest),
+        highest(highest),
+        figures(figures),
+        retired(lowest, highest, figures) {}
+
+  const int64_t lowest;
+  const int64_t highest;
+  const int figures;
+
+  Mutex mutex;
+  std::vector<HistogramShard*> shards;
+  // Holds the values of threads whose RecordableHistogram has gone away.
+  HistogramShard retired;
+};
+
+namespace {
+
+// Maps the memory of the SharedArrayBuffers created by CreateBuffer() to the
+// SharedHistogram that they belong to, so that other threads can find it.
+Mutex shared_histograms_mutex;
+std::unordered_map<void*, std::weak_ptr<SharedHistogram>> shared_histograms;
+
+void DeleteSharedHistogram(void* data, size_t length, void* deleter_data) {
+  {
+    Mutex::ScopedLock lock(shared_histograms_mutex);
+    shared_histograms.erase(data);
+  }
+  delete static_cast<std::shared_ptr<SharedHistogram>*>(deleter_data);
+  delete[] static_cast<char*>(data);
+}
+
+inline void RecordValue(HistogramShard* shard, int64_t value) {
+  if (!shard->histogram.Record(value) && shard->exceeds < 0xFFFFFFFF)
+    shard->exceeds++;
+}
+
+}  // anonymous namespace
+
+RecordableHistogram::RecordableHistogram(
+    Environment* env,
+    Local<Object> wrap,
+    std::shared_ptr<SharedHistogram> shared)
+    : BaseObject(env, wrap),
+      shared_(std::move(shared)),
+      shard_(new HistogramShard(
+          shared_->lowest, shared_->highest, shared_->figures)),
+      staging_(env->isolate(), kStagingSize + 1) {
+  MakeWeak();
+  wrap->Set(env->context(),
+            FIXED_ONE_BYTE_STRING(env->isolate(), "staging"),
+            staging_.GetJSArray()).Check();
+  Mutex::ScopedLock lock(shared_->mutex);
+  shared_->shards.push_back(shard_.get());
+}
+
+RecordableHistogram::~RecordableHistogram() {
+  FlushStaging();
+  Mutex::ScopedLock lock(shared_->mutex);
+  auto it = std::find(shared_->shards.begin(),
+                      shared_->shards.end(),
+                      shard_.get());
+  CHECK_NE(it, shared_->shards.end());
+  shared_->shards.erase(it);
+  HistogramShard* retired = &shared_->retired;
+  Mutex::ScopedLock retired_lock(retired->mutex);
+  retired->exceeds += retired->histogram.Add(shard_->histogram) +
+                      shard_->exceeds;
+}
+
+void RecordableHistogram::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("histogram",
+                              shard_->histogram.GetMemorySize());
+  tracker->TrackField("staging", staging_);
+}
+
+void RecordableHistogram::FlushStaging() {
+  size_t count = static_cast<size_t>(staging_[0]);
+  if (count == 0)
+    return;
+  CHECK_LE(count, kStagingSize);
+  Mutex::ScopedLock lock(shard_->mutex);
+  for (size_t n = 1; n <= count; n++)
+    RecordValue(shard_.get(), static_cast<int64_t>(staging_[n]));
+  staging_[0] = 0;
+}
+
+int64_t RecordableHistogram::Merge(Histogram* target, bool reset) {
+  FlushStaging();
+  int64_t exceeds = 0;
+  auto merge = [&](HistogramShard* shard) {
+    Mutex::ScopedLock lock(shard->mutex);
+    exceeds += target->Add(shard->histogram) + shard->exceeds;
+    if (reset) {
+      shard->histogram.Reset();
+      shard->exceeds = 0;
+    }
+  };
+  Mutex::ScopedLock lock(shared_->mutex);
+  for (HistogramShard* shard : shared_->shards)
+    merge(shard);
+  merge(&shared_->retired);
+  return exceeds;
+}
+
+void RecordableHistogram::CreateBuffer(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsNumber());
+  CHECK(args[1]->IsNumber());
+  CHECK(args[2]->IsInt32());
+  int64_t lowest = static_cast<int64_t>(args[0].As<Number>()->Value());
+  int64_t highest = static_cast<int64_t>(args[1].As<Number>()->Value());
+  int figures = args[2].As<Integer>()->Value();
+  CHECK_GE(lowest, 1);
+  CHECK_GE(highest, 2 * lowest);
+  CHECK(figures >= 1 && figures <= 5);
+
+  // The buffer is only used to refer to the histogram from JS, on any
+  // thread, and to keep it alive for as long as that is possible.
+  constexpr size_t kLength = 8;
+  char* data = new char[kLength]();
+  auto shared = new std::shared_ptr<SharedHistogram>(
+      std::make_shared<SharedHistogram>(lowest, highest, figures));
+  {
+    Mutex::ScopedLock lock(shared_histograms_mutex);
+    shared_histograms[data] = *shared;
+  }
+  std::shared_ptr<BackingStore> store =
+      SharedArrayBuffer::NewBackingStore(
+          data, kLength, DeleteSharedHistogram, shared);
+  args.GetReturnValue().Set(SharedArrayBuffer::New(env->isolate(), store));
+}
+
+void RecordableHistogram::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsSharedArrayBuffer());
+  void* data = args[0].As<SharedArrayBuffer>()->GetBackingStore()->Data();
+  std::shared_ptr<SharedHistogram> shared;
+  {
+    Mutex::ScopedLock lock(shared_histograms_mutex);
+    auto it = shared_histograms.find(data);
+    if (it != shared_histograms.end())
+      shared = it->second.lock();
+  }
+  if (!shared) {
+    return THROW_ERR_INVALID_ARG_VALUE(
+        env, "The buffer does not belong to a histogram");
+  }
+  new RecordableHistogram(env, args.This(), std::move(shared));
+}
+
+void RecordableHistogram::Flush(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->FlushStaging();
+}
+
+void RecordableHistogram::RecordDelta(
+    const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  uint64_t time = uv_hrtime();
+  if (histogram->prev_ > 0 && time > histogram->prev_) {
+    HistogramShard* shard = histogram->shard_.get();
+    Mutex::ScopedLock lock(shard->mutex);
+    RecordValue(shard, static_cast<int64_t>(time - histogram->prev_));
+  }
+  histogram->prev_ = time;
+}
+
+void RecordableHistogram::GetMin(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  args.GetReturnValue().Set(static_cast<double>(merged.Min()));
+}
+
+void RecordableHistogram::GetMax(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  args.GetReturnValue().Set(static_cast<double>(merged.Max()));
+}
+
+void RecordableHistogram::GetMean(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  args.GetReturnValue().Set(merged.Mean());
+}
+
+void RecordableHistogram::GetExceeds(
+    const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  double value = static_cast<double>(histogram->Merge(&merged));
+  args.GetReturnValue().Set(value);
+}
+
+void RecordableHistogram::GetStddev(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  args.GetReturnValue().Set(merged.Stddev());
+}
+
+void RecordableHistogram::GetPercentile(
+    const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double percentile = args[0].As<Number>()->Value();
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  args.GetReturnValue().Set(merged.Percentile(percentile));
+}
+
+void RecordableHistogram::GetPercentiles(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsMap());
+  Local<Map> map = args[0].As<Map>();
+  SharedHistogram* shared = histogram->shared_.get();
+  Histogram merged(shared->lowest, shared->highest, shared->figures);
+  histogram->Merge(&merged);
+  merged.Percentiles([map, env](double key, double value) {
+    map->Set(
+        env->context(),
+        Number::New(env->isolate(), key),
+        Number::New(env->isolate(), value)).IsEmpty();
+  });
+}
+
+void RecordableHistogram::DoReset(const FunctionCallbackInfo<Value>& args) {
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->staging_[0] = 0;
+  histogram->prev_ = 0;
+  SharedHistogram* shared = histogram->shared_.get();
+  Mutex::ScopedLock lock(shared->mutex);
+  auto reset = [](HistogramShard* shard) {
+    Mutex::ScopedLock lock(shard->mutex);
+    shard->histogram.Reset();
+    shard->exceeds = 0;
+  };
+  for (HistogramShard* shard : shared->shards)
+    reset(shard);
+  reset(&shared->retired);
+}
+
+// Returns a plain Histogram with a copy of the values recorded so far. If
+// the first argument is true, the values are removed from this histogram at
+// the same time, so that no value is lost or counted twice between two
+// consecutive snapshots.
+void RecordableHistogram::Snapshot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RecordableHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  SharedHistogram* shared = histogram->shared_.get();
+  BaseObjectPtr<HistogramBase> snapshot =
+      HistogramBase::New(env, shared->lowest, shared->highest, shared->figures);
+  if (!snapshot)
+    return;
+  snapshot->AddExceeds(
+      histogram->Merge(snapshot.get(), args[0]->IsTrue()));
+  args.GetReturnValue().Set(snapshot->object());
+}
+
+void RecordableHistogram::Initialize(Environment* env, Local<Object> target) {
+  HistogramBase::Initialize(env);
+
+  Local<String> classname =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "RecordableHistogram");
+  Local<FunctionTemplate> histogram =
+      env->NewFunctionTemplate(RecordableHistogram::New);
+  histogram->SetClassName(classname);
+  histogram->InstanceTemplate()->SetInternalFieldCount(
+      RecordableHistogram::kInternalFieldCount);
+  env->SetProtoMethod(histogram, "flush", RecordableHistogram::Flush);
+  env->SetProtoMethod(histogram,
+                      "recordDelta",
+                      RecordableHistogram::RecordDelta);
+  env->SetProtoMethod(histogram, "exceeds", RecordableHistogram::GetExceeds);
+  env->SetProtoMethod(histogram, "min", RecordableHistogram::GetMin);
+  env->SetProtoMethod(histogram, "max", RecordableHistogram::GetMax);
+  env->SetProtoMethod(histogram, "mean", RecordableHistogram::GetMean);
+  env->SetProtoMethod(histogram, "stddev", RecordableHistogram::GetStddev);
+  env->SetProtoMethod(histogram,
+                      "percentile",
+                      RecordableHistogram::GetPercentile);
+  env->SetProtoMethod(histogram,
+                      "percentiles",
+                      RecordableHistogram::GetPercentiles);
+  env->SetProtoMethod(histogram, "reset", RecordableHistogram::DoReset);
+  env->SetProtoMethod(histogram, "snapshot", RecordableHistogram::Snapshot);
+  target->Set(env->context(),
+              classname,
+              histogram->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  env->SetMethod(target,
+                 "createHistogramBuffer",
+                 RecordableHistogram::CreateBuffer);
+  NODE_DEFINE_CONSTANT(target, kStagingSize);
+}
+
 }  // namespace node
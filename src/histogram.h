@@ -4,12 +4,14 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "hdr_histogram.h"
+#include "aliased_buffer.h"
 #include "base_object.h"
 #include "util.h"
 
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 
 namespace node {
 
@@ -25,6 +27,9 @@ class Histogram {
 
   inline bool Record(int64_t value);
   inline void Reset();
+  // Adds all values recorded in another histogram to this one, and returns
+  // the number of values that fell outside of its range.
+  inline int64_t Add(const Histogram& other);
   inline int64_t Min();
   inline int64_t Max();
   inline double Mean();
@@ -56,6 +61,7 @@ class HistogramBase : public BaseObject, public Histogram {
   inline void ResetState();
 
   int64_t Exceeds() const { return exceeds_; }
+  void AddExceeds(int64_t count) { exceeds_ += count; }
 
   void MemoryInfo(MemoryTracker* tracker) const override;
   SET_MEMORY_INFO_NAME(HistogramBase)
@@ -91,6 +97,60 @@ class HistogramBase : public BaseObject, public Histogram {
   uint64_t prev_ = 0;
 };
 
+struct HistogramShard;
+struct SharedHistogram;
+
+// A histogram that can be recorded into from several threads at once. Each
+// thread has a RecordableHistogram object of its own that records into a
+// separate HistogramShard, and all shards are merged when the values are
+// read. The threads find the SharedHistogram through a SharedArrayBuffer
+// that is created along with it, and that keeps it alive.
+//
+// Values are recorded in batches: JS code writes them into an aliased buffer
+// (the number of values first, then the values) and they are only added to
+// the shard once it is full, or before the histogram is read.
+class RecordableHistogram : public BaseObject {
+ public:
+  static constexpr size_t kStagingSize = 256;
+
+  RecordableHistogram(Environment* env,
+                      v8::Local<v8::Object> wrap,
+                      std::shared_ptr<SharedHistogram> shared);
+  ~RecordableHistogram() override;
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RecordableHistogram)
+  SET_SELF_SIZE(RecordableHistogram)
+
+  static void CreateBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Flush(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void RecordDelta(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMin(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMax(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetMean(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetExceeds(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetStddev(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetPercentile(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetPercentiles(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void DoReset(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Snapshot(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+ private:
+  void FlushStaging();
+  // Adds the values of all threads to target, after flushing the ones staged
+  // on this one, and returns the number of values that were out of range.
+  int64_t Merge(Histogram* target, bool reset = false);
+
+  std::shared_ptr<SharedHistogram> shared_;
+  std::unique_ptr<HistogramShard> shard_;
+  AliasedFloat64Array staging_;
+  uint64_t prev_ = 0;
+};
+
 }  // namespace node
 
 #endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
@@ -1,5 +1,6 @@
 #include "module_wrap.h"
 
+#include "compile_cache.h"
 #include "env.h"
 #include "memory_tracker-inl.h"
 #include "node_contextify.h"
@@ -93,7 +94,8 @@ ModuleWrap* ModuleWrap::GetFromID(Environment* env, uint32_t id) {
   return module_wrap_it->second;
 }
 
-// new ModuleWrap(url, context, source, lineOffset, columnOffset)
+// new ModuleWrap(url, context, source, lineOffset, columnOffset, cachedData,
+//                useCompileCache)
 // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
 void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
@@ -144,6 +146,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   TryCatchScope try_catch(env);
 
   Local<Module> module;
+  CompileCacheHandler* cache_handler = nullptr;
+  CompileCacheEntry* cache_entry = nullptr;
 
   {
     Context::Scope context_scope(context);
@@ -163,6 +167,7 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
       module = Module::CreateSyntheticModule(isolate, url, export_names,
         SyntheticModuleEvaluationStepsCallback);
     } else {
+      Local<String> source_text = args[2].As<String>();
       ScriptCompiler::CachedData* cached_data = nullptr;
       if (!args[5]->IsUndefined()) {
         CHECK(args[5]->IsArrayBufferView());
@@ -172,9 +177,16 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         cached_data =
             new ScriptCompiler::CachedData(data + cached_data_buf->ByteOffset(),
                                            cached_data_buf->ByteLength());
+      } else if (args[6]->IsTrue()) {
+        cache_handler = env->compile_cache_handler();
+        if (cache_handler != nullptr) {
+          cache_entry = cache_handler->GetOrInsert(
+              source_text, url, CachedCodeType::kESM);
+          if (cache_entry->cache != nullptr)
+            cached_data = cache_handler->CopyCache(cache_entry);
+        }
       }
 
-      Local<String> source_text = args[2].As<String>();
       ScriptOrigin origin(url,
                           line_offset,                      // line offset
                           column_offset,                    // column offset
@@ -203,8 +215,12 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
-      if (options == ScriptCompiler::kConsumeCodeCache &&
-          source.GetCachedData()->rejected) {
+      bool rejected = options == ScriptCompiler::kConsumeCodeCache &&
+                      source.GetCachedData()->rejected;
+      if (cache_entry != nullptr) {
+        // A stale cache from the cache directory is simply replaced.
+        cache_handler->MaybeSave(cache_entry, module, rejected);
+      } else if (rejected) {
         THROW_ERR_VM_MODULE_CACHED_DATA_REJECTED(
             env, "cachedData buffer was rejected");
         try_catch.ReThrow();
@@ -37,6 +37,8 @@
 #include "node_process.h"
 #include "node_report.h"
 #include "node_revert.h"
+#include "node_module_bundle.h"
+#include "node_snapshot_blob.h"
 #include "node_v8_platform-inl.h"
 #include "node_version.h"
 
@@ -428,6 +430,10 @@ MaybeLocal<Value> StartMainThreadExecution(Environment* env) {
     return StartExecution(env, "internal/main/prof_process");
   }
 
+  if (per_process::cli_options->build_module_bundle) {
+    return StartExecution(env, "internal/main/build_module_bundle");
+  }
+
   // -e/--eval without -i/--interactive
   if (env->options()->has_eval_string && !env->options()->force_repl) {
     return StartExecution(env, "internal/main/eval_string");
@@ -1023,7 +1029,24 @@ int Start(int argc, char** argv) {
 
     bool force_no_snapshot =
         per_process::cli_options->per_isolate->no_node_snapshot;
-    if (!force_no_snapshot) {
+    const std::string& snapshot_blob_path =
+        per_process::cli_options->snapshot_blob;
+    SnapshotBlob snapshot_blob;
+    if (!snapshot_blob_path.empty()) {
+      std::string error = snapshot_blob.ReadFromFile(snapshot_blob_path);
+      if (!error.empty()) {
+        fprintf(stderr, "%s: %s: %s\n",
+                result.args.at(0).c_str(),
+                snapshot_blob_path.c_str(),
+                error.c_str());
+        TearDownOncePerProcess();
+        return 9;
+      }
+      external_references.push_back(reinterpret_cast<intptr_t>(nullptr));
+      params.external_references = external_references.data();
+      params.snapshot_blob = snapshot_blob.startup_data();
+      indexes = snapshot_blob.isolate_data_indexes();
+    } else if (!force_no_snapshot) {
       v8::StartupData* blob = NodeMainInstance::GetEmbeddedSnapshotBlob();
       if (blob != nullptr) {
         // TODO(joyeecheung): collect external references and set it in
@@ -1035,6 +1058,27 @@ int Start(int argc, char** argv) {
       }
     }
 
+    const std::string& module_bundle_path =
+        per_process::cli_options->module_bundle;
+    ModuleBundle module_bundle;
+    // With --build-module-bundle, the file is written rather than read.
+    if (!module_bundle_path.empty() &&
+        !per_process::cli_options->build_module_bundle) {
+      std::string error = module_bundle.ReadFromFile(module_bundle_path);
+      if (!error.empty()) {
+        fprintf(stderr, "%s: %s: %s\n",
+                result.args.at(0).c_str(),
+                module_bundle_path.c_str(),
+                error.c_str());
+        TearDownOncePerProcess();
+        return 9;
+      }
+      // The entry point takes the place of the main script, and all other
+      // arguments are passed on to it.
+      result.args.insert(result.args.begin() + 1, module_bundle.entry());
+      per_process::module_bundle = &module_bundle;
+    }
+
     NodeMainInstance main_instance(&params,
                                    uv_default_loop(),
                                    per_process::v8_platform.Platform(),
@@ -1042,6 +1086,7 @@ int Start(int argc, char** argv) {
                                    result.exec_args,
                                    indexes);
     result.exit_code = main_instance.Run();
+    per_process::module_bundle = nullptr;
   }
 
   TearDownOncePerProcess();
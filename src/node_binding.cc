@@ -53,6 +53,7 @@
   V(inspector)                                                                 \
   V(js_stream)                                                                 \
   V(messaging)                                                                 \
+  V(module_bundle)                                                             \
   V(module_wrap)                                                               \
   V(native_module)                                                             \
   V(options)                                                                   \
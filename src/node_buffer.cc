@@ -23,6 +23,7 @@
 #include "node.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "node_simd.h"
 
 #include "env-inl.h"
 #include "string_bytes.h"
@@ -544,6 +545,30 @@ void StringSlice(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Decodes a buffer that nothing else refers to, such as one that fs allocated
+// for readFile(). The buffer may be detached in the process.
+void TransferToString(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsArrayBufferView());
+  const enum encoding encoding = ParseEncoding(isolate, args[1], UTF8);
+
+  Local<Value> error;
+  MaybeLocal<Value> ret =
+      StringBytes::EncodeTransfer(isolate,
+                                  args[0].As<ArrayBufferView>(),
+                                  encoding,
+                                  &error);
+  if (ret.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    isolate->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(ret.ToLocalChecked());
+}
+
+
 // bytesCopied = copy(buffer, target[, targetStart][, sourceStart][, sourceEnd])
 void Copy(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
@@ -720,9 +745,37 @@ void StringWrite(const FunctionCallbackInfo<Value>& args) {
 void ByteLengthUtf8(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsString());
+  Local<String> str = args[0].As<String>();
 
   // Fast case: avoid StringBytes on UTF8 string. Jump to v8.
-  args.GetReturnValue().Set(args[0].As<String>()->Utf8Length(env->isolate()));
+  if (str->IsOneByte()) {
+    args.GetReturnValue().Set(str->Utf8Length(env->isolate()));
+    return;
+  }
+
+  // V8 measures two-byte strings one character at a time, so copy them out
+  // in chunks and let the vectorized counter measure those instead.
+  size_t length = 0;
+  if (str->IsExternal()) {
+    const String::ExternalStringResource* ext =
+        str->GetExternalStringResource();
+    length = simd::Utf8Length(ext->data(), ext->length());
+  } else {
+    uint16_t chunk[1024];
+    const int str_length = str->Length();
+    for (int start = 0; start < str_length;) {
+      int count = std::min(static_cast<int>(arraysize(chunk)),
+                           str_length - start);
+      str->Write(env->isolate(), chunk, start, count,
+                 String::NO_NULL_TERMINATION);
+      // Keep surrogate pairs within a single chunk.
+      if (start + count < str_length && (chunk[count - 1] & 0xFC00) == 0xD800)
+        count--;
+      length += simd::Utf8Length(chunk, count);
+      start += count;
+    }
+  }
+  args.GetReturnValue().Set(static_cast<uint32_t>(length));
 }
 
 // Normalize val to be an integer in the range of [1, -1] since
@@ -1200,6 +1253,8 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "ucs2Write", StringWrite<UCS2>);
   env->SetMethod(target, "utf8Write", StringWrite<UTF8>);
 
+  env->SetMethod(target, "transferToString", TransferToString);
+
   // It can be a nullptr when running inside an isolate where we
   // do not own the ArrayBuffer allocator.
   if (NodeArrayBufferAllocator* allocator =
@@ -25,6 +25,7 @@
 #include "node_internals.h"
 #include "node_watchdog.h"
 #include "base_object-inl.h"
+#include "compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "module_wrap.h"
@@ -1050,13 +1051,24 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
+  // Argument 10: use the --compile-cache-dir cache (optional)
+  CompileCacheHandler* cache_handler = nullptr;
+  if (args[9]->IsTrue() && cached_data_buf.IsEmpty())
+    cache_handler = env->compile_cache_handler();
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
+  CompileCacheEntry* cache_entry = nullptr;
   if (!cached_data_buf.IsEmpty()) {
     uint8_t* data = static_cast<uint8_t*>(
         cached_data_buf->Buffer()->GetBackingStore()->Data());
     cached_data = new ScriptCompiler::CachedData(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (cache_handler != nullptr) {
+    cache_entry = cache_handler->GetOrInsert(
+        code, filename, CachedCodeType::kCommonJS);
+    if (cache_entry->cache != nullptr)
+      cached_data = cache_handler->CopyCache(cache_entry);
   }
 
   // Get the function id
@@ -1131,6 +1143,12 @@ void ContextifyContext::CompileFunction(
   }
   Local<Function> fn = maybe_fn.ToLocalChecked();
 
+  if (cache_entry != nullptr) {
+    bool rejected = options == ScriptCompiler::kConsumeCodeCache &&
+                    source.GetCachedData()->rejected;
+    cache_handler->MaybeSave(cache_entry, fn, rejected);
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
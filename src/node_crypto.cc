@@ -111,7 +111,10 @@ static const char* const root_certs[] = {
 
 static const char system_cert_path[] = NODE_OPENSSL_SYSTEM_CERT_PATH;
 
+// The shared root store is immutable once created and handed out with
+// X509_STORE_up_ref(), so every context that uses the default CAs shares it.
 static X509_STORE* root_cert_store;
+static Mutex root_cert_store_mutex;
 
 static bool extra_root_certs_loaded = false;
 
@@ -467,6 +470,7 @@ void SecureContext::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "addCACert", AddCACert);
   env->SetProtoMethod(t, "addCRL", AddCRL);
   env->SetProtoMethod(t, "addRootCerts", AddRootCerts);
+  env->SetProtoMethod(t, "loadCACerts", LoadCACerts);
   env->SetProtoMethod(t, "setCipherSuites", SetCipherSuites);
   env->SetProtoMethod(t, "setCiphers", SetCiphers);
   env->SetProtoMethod(t, "setSigalgs", SetSigalgs);
@@ -1006,6 +1010,22 @@ static X509_STORE* NewRootCertStore() {
 }
 
 
+static X509_STORE* GetOrCreateRootCertStore() {
+  Mutex::ScopedLock lock(root_cert_store_mutex);
+  if (root_cert_store == nullptr)
+    root_cert_store = NewRootCertStore();
+  return root_cert_store;
+}
+
+
+// Contexts that still use the shared root store get their own copy before
+// any certificates or CRLs are added to it.
+static bool IsRootCertStore(X509_STORE* store) {
+  Mutex::ScopedLock lock(root_cert_store_mutex);
+  return store == root_cert_store;
+}
+
+
 void SecureContext::AddCACert(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -1024,7 +1044,7 @@ void SecureContext::AddCACert(const FunctionCallbackInfo<Value>& args) {
   X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_.get());
   while (X509* x509 = PEM_read_bio_X509_AUX(
       bio.get(), nullptr, NoPasswordCallback, nullptr)) {
-    if (cert_store == root_cert_store) {
+    if (IsRootCertStore(cert_store)) {
       cert_store = NewRootCertStore();
       SSL_CTX_set_cert_store(sc->ctx_.get(), cert_store);
     }
@@ -1058,7 +1078,7 @@ void SecureContext::AddCRL(const FunctionCallbackInfo<Value>& args) {
     return env->ThrowError("Failed to parse CRL");
 
   X509_STORE* cert_store = SSL_CTX_get_cert_store(sc->ctx_.get());
-  if (cert_store == root_cert_store) {
+  if (IsRootCertStore(cert_store)) {
     cert_store = NewRootCertStore();
     SSL_CTX_set_cert_store(sc->ctx_.get(), cert_store);
   }
@@ -1098,6 +1118,7 @@ static unsigned long AddCertsFromFile(  // NOLINT(runtime/int)
 
 void UseExtraCaCerts(const std::string& file) {
   ClearErrorOnReturn clear_error_on_return;
+  Mutex::ScopedLock lock(root_cert_store_mutex);
 
   if (root_cert_store == nullptr) {
     root_cert_store = NewRootCertStore();
@@ -1130,13 +1151,11 @@ void SecureContext::AddRootCerts(const FunctionCallbackInfo<Value>& args) {
   ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
   ClearErrorOnReturn clear_error_on_return;
 
-  if (root_cert_store == nullptr) {
-    root_cert_store = NewRootCertStore();
-  }
+  X509_STORE* store = GetOrCreateRootCertStore();
 
   // Increment reference count so global store is not deleted along with CTX.
-  X509_STORE_up_ref(root_cert_store);
-  SSL_CTX_set_cert_store(sc->ctx_.get(), root_cert_store);
+  X509_STORE_up_ref(store);
+  SSL_CTX_set_cert_store(sc->ctx_.get(), store);
 }
 
 
@@ -1435,7 +1454,7 @@ void SecureContext::LoadPKCS12(const FunctionCallbackInfo<Value>& args) {
     for (int i = 0; i < sk_X509_num(extra_certs.get()); i++) {
       X509* ca = sk_X509_value(extra_certs.get(), i);
 
-      if (cert_store == root_cert_store) {
+      if (IsRootCertStore(cert_store)) {
         cert_store = NewRootCertStore();
         SSL_CTX_set_cert_store(sc->ctx_.get(), cert_store);
       }
@@ -5728,6 +5747,135 @@ inline void CopyBuffer(Local<Value> buf, std::vector<char>* vec) {
 }
 
 
+// Parses CA certificates and builds the X509_STORE for a SecureContext on the
+// threadpool. Without any input buffers, the shared root store is used (and
+// created on first use, which is the expensive part for the bundled roots).
+struct LoadCACertsJob : public CryptoJob {
+  BaseObjectPtr<SecureContext> sc;
+  std::vector<std::vector<char>> inputs;
+  bool use_root_certs = false;
+  X509_STORE* store = nullptr;
+  STACK_OF(X509_NAME)* client_ca_names = nullptr;
+  CryptoErrorVector errors;
+
+  inline explicit LoadCACertsJob(Environment* env) : CryptoJob(env) {}
+
+  inline ~LoadCACertsJob() override {
+    if (store != nullptr) X509_STORE_free(store);
+    if (client_ca_names != nullptr)
+      sk_X509_NAME_pop_free(client_ca_names, X509_NAME_free);
+  }
+
+  inline void DoThreadPoolWork() override {
+    ClearErrorOnReturn clear_error_on_return;
+
+    if (use_root_certs) {
+      store = GetOrCreateRootCertStore();
+      X509_STORE_up_ref(store);
+      return;
+    }
+
+    store = X509_STORE_new();
+    client_ca_names = sk_X509_NAME_new_null();
+    if (store == nullptr || client_ca_names == nullptr)
+      return errors.Capture();
+
+    for (const auto& input : inputs) {
+      if (!AddCerts(input.data(), input.size()))
+        return errors.Capture();
+    }
+  }
+
+  inline void AfterThreadPoolWork() override {
+    Local<Value> arg = ToResult();
+    if (errors.empty()) {
+      // Ownership of both the store and the name list moves to the SSL_CTX.
+      SSL_CTX_set_cert_store(sc->ctx_.get(), store);
+      store = nullptr;
+      if (client_ca_names != nullptr) {
+        SSL_CTX_set_client_CA_list(sc->ctx_.get(), client_ca_names);
+        client_ca_names = nullptr;
+      }
+    }
+    async_wrap->MakeCallback(env()->ondone_string(), 1, &arg);
+  }
+
+  inline Local<Value> ToResult() const {
+    if (errors.empty()) return Undefined(env()->isolate());
+    return errors.ToException(env()).ToLocalChecked();
+  }
+
+ private:
+  inline bool AddCert(X509* x509) {
+    X509_NAME* name = X509_NAME_dup(X509_get_subject_name(x509));
+    if (name == nullptr || !sk_X509_NAME_push(client_ca_names, name)) {
+      X509_NAME_free(name);
+      return false;
+    }
+    return X509_STORE_add_cert(store, x509) == 1;
+  }
+
+  // Accepts a single DER certificate or any number of PEM certificates, with
+  // the same leniency towards trailing garbage as SecureContext::AddCACert.
+  // Input that contains a PEM boundary is always read as PEM, even if the
+  // explanatory text before it happens to start with '0' (0x30). Otherwise,
+  // input that starts with an ASN.1 SEQUENCE header must be a DER certificate
+  // and fails to load if it is malformed, instead of being silently ignored.
+  inline bool AddCerts(const char* data, size_t length) {
+    static const char kPEMBoundary[] = "-----BEGIN ";
+    const char* end = data + length;
+    const bool is_pem = std::search(data, end, kPEMBoundary,
+                                    kPEMBoundary + sizeof(kPEMBoundary) - 1) !=
+                        end;
+    const unsigned char* der = reinterpret_cast<const unsigned char*>(data);
+    size_t offset, size;
+    if (!is_pem && IsASN1Sequence(der, length, &offset, &size)) {
+      X509Pointer x509(d2i_X509(nullptr, &der, length));
+      return x509 && AddCert(x509.get());
+    }
+
+    BIOPointer bio(NodeBIO::NewFixed(data, length));
+    if (!bio) return false;
+    while (X509Pointer x509 {PEM_read_bio_X509_AUX(
+        bio.get(), nullptr, NoPasswordCallback, nullptr)}) {
+      if (!AddCert(x509.get())) return false;
+    }
+    ERR_clear_error();
+    return true;
+  }
+};
+
+
+void SecureContext::LoadCACerts(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  SecureContext* sc;
+  ASSIGN_OR_RETURN_UNWRAP(&sc, args.Holder());
+
+  // CA buffers, or undefined for the root certificates. The buffers are
+  // copied because JS may modify or detach them while the job runs.
+  CHECK(args[0]->IsArray() || args[0]->IsUndefined());
+  CHECK(args[1]->IsObject());  // wrap object
+
+  std::unique_ptr<LoadCACertsJob> job(new LoadCACertsJob(env));
+  job->sc.reset(sc);
+  if (args[0]->IsUndefined()) {
+    job->use_root_certs = true;
+  } else {
+    Local<Array> list = args[0].As<Array>();
+    job->inputs.reserve(list->Length());
+    for (uint32_t i = 0; i < list->Length(); i++) {
+      Local<Value> buf;
+      if (!list->Get(env->context(), i).ToLocal(&buf))
+        return;
+      job->inputs.emplace_back();
+      CopyBuffer(buf, &job->inputs.back());
+    }
+  }
+  LoadCACertsJob::Run(std::move(job), args[1]);
+}
+
+
 struct RandomBytesJob : public CryptoJob {
   unsigned char* data;
   size_t size;
@@ -6629,10 +6777,8 @@ void ExportChallenge(const FunctionCallbackInfo<Value>& args) {
 void GetRootCertificates(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
-  if (root_cert_store == nullptr)
-    root_cert_store = NewRootCertStore();
-
-  stack_st_X509_OBJECT* objs = X509_STORE_get0_objects(root_cert_store);
+  stack_st_X509_OBJECT* objs =
+      X509_STORE_get0_objects(GetOrCreateRootCertStore());
   int num_objs = sk_X509_OBJECT_num(objs);
 
   std::vector<Local<Value>> result;
@@ -1,7 +1,9 @@
 #include "node_dir.h"
 #include "node_file-inl.h"
+#include "node_file_uring.h"
 #include "node_process.h"
 #include "memory_tracker-inl.h"
+#include "threadpoolwork-inl.h"
 #include "util.h"
 
 #include "tracing/trace_event.h"
@@ -15,6 +17,12 @@
 #include <cerrno>
 #include <climits>
 
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include <memory>
 
 namespace node {
@@ -25,6 +33,7 @@ using fs::FSReqAfterScope;
 using fs::FSReqBase;
 using fs::FSReqWrapSync;
 using fs::GetReqWrap;
+using fs::InitJobRequest;
 
 using v8::Array;
 using v8::Context;
@@ -41,6 +50,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::String;
+using v8::Uint32;
 using v8::Value;
 
 #define TRACE_NAME(name) "fs_dir.sync." #name
@@ -343,6 +353,480 @@ static void OpenDir(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+namespace {
+
+int TypeFromMode(uint64_t mode) {
+  switch (mode & S_IFMT) {
+    case S_IFREG: return UV_DIRENT_FILE;
+    case S_IFDIR: return UV_DIRENT_DIR;
+    case S_IFCHR: return UV_DIRENT_CHAR;
+#ifdef S_IFLNK
+    case S_IFLNK: return UV_DIRENT_LINK;
+#endif
+#ifdef S_IFIFO
+    case S_IFIFO: return UV_DIRENT_FIFO;
+#endif
+#ifdef S_IFSOCK
+    case S_IFSOCK: return UV_DIRENT_SOCKET;
+#endif
+#ifdef S_IFBLK
+    case S_IFBLK: return UV_DIRENT_BLOCK;
+#endif
+    default: return UV_DIRENT_UNKNOWN;
+  }
+}
+
+}  // anonymous namespace
+
+#ifdef __linux__
+
+// Reads directories with getdents64() into a large buffer, and stats their
+// entries relative to the directory's file descriptor with statx(), so that
+// no path has to be resolved more than once.
+class DirReader {
+ public:
+  DirReader() : buffer_(new char[kBufferSize]) {}
+  ~DirReader() { Close(); }
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  int Open(const std::string& path) {
+    fd_ = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd_ < 0) return -errno;
+    length_ = position_ = 0;
+    return 0;
+  }
+
+  void Close() {
+    if (fd_ < 0) return;
+    close(fd_);
+    fd_ = -1;
+  }
+
+  // Returns 1 for an entry, 0 at the end of the directory, or an error.
+  int Next(const char** name, int* type) {
+    for (;;) {
+      if (position_ >= length_) {
+        ssize_t length;
+        do {
+          length = syscall(SYS_getdents64, fd_, buffer_.get(), kBufferSize);
+        } while (length < 0 && errno == EINTR);
+        if (length < 0) return -errno;
+        if (length == 0) return 0;
+        length_ = length;
+        position_ = 0;
+      }
+
+      const Dirent64* entry =
+          reinterpret_cast<const Dirent64*>(buffer_.get() + position_);
+      position_ += entry->d_reclen;
+      if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+        continue;
+      *name = entry->d_name;
+      *type = TypeFromDType(entry->d_type);
+      return 1;
+    }
+  }
+
+  int Stat(const char* name, const std::string& path, uv_stat_t* stat) {
+#ifdef __NR_statx
+    if (!no_statx_) {
+      fs::Statx buf;
+      int err = syscall(__NR_statx, fd_, name, AT_SYMLINK_NOFOLLOW,
+                        fs::kStatxBasicStatsAndBtime, &buf);
+      if (err == 0) {
+        fs::StatxToUvStat(buf, stat);
+        return 0;
+      }
+      if (errno != ENOSYS && errno != EPERM) return -errno;
+      // Old kernels, and seccomp filters that do not know about statx().
+      no_statx_ = true;
+    }
+#endif
+    struct stat buf;
+    if (fstatat(fd_, name, &buf, AT_SYMLINK_NOFOLLOW) != 0) return -errno;
+    FromStat(buf, stat);
+    return 0;
+  }
+
+ private:
+  // The getdents64() record, as declared by <linux/dirent.h>.
+  struct Dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    uint16_t d_reclen;
+    uint8_t d_type;
+    char d_name[1];
+  };
+
+  static constexpr size_t kBufferSize = 128 * 1024;
+
+  static int TypeFromDType(uint8_t type) {
+    switch (type) {
+      case DT_REG: return UV_DIRENT_FILE;
+      case DT_DIR: return UV_DIRENT_DIR;
+      case DT_LNK: return UV_DIRENT_LINK;
+      case DT_FIFO: return UV_DIRENT_FIFO;
+      case DT_SOCK: return UV_DIRENT_SOCKET;
+      case DT_CHR: return UV_DIRENT_CHAR;
+      case DT_BLK: return UV_DIRENT_BLOCK;
+      default: return UV_DIRENT_UNKNOWN;
+    }
+  }
+
+  // Fills uv_stat_t the same way libuv does.
+  static void FromStat(const struct stat& buf, uv_stat_t* stat) {
+    stat->st_dev = buf.st_dev;
+    stat->st_mode = buf.st_mode;
+    stat->st_nlink = buf.st_nlink;
+    stat->st_uid = buf.st_uid;
+    stat->st_gid = buf.st_gid;
+    stat->st_rdev = buf.st_rdev;
+    stat->st_ino = buf.st_ino;
+    stat->st_size = buf.st_size;
+    stat->st_blksize = buf.st_blksize;
+    stat->st_blocks = buf.st_blocks;
+    stat->st_atim.tv_sec = buf.st_atim.tv_sec;
+    stat->st_atim.tv_nsec = buf.st_atim.tv_nsec;
+    stat->st_mtim.tv_sec = buf.st_mtim.tv_sec;
+    stat->st_mtim.tv_nsec = buf.st_mtim.tv_nsec;
+    stat->st_ctim.tv_sec = buf.st_ctim.tv_sec;
+    stat->st_ctim.tv_nsec = buf.st_ctim.tv_nsec;
+    stat->st_birthtim.tv_sec = buf.st_ctim.tv_sec;
+    stat->st_birthtim.tv_nsec = buf.st_ctim.tv_nsec;
+    stat->st_flags = 0;
+    stat->st_gen = 0;
+  }
+
+  int fd_ = -1;
+  std::unique_ptr<char[]> buffer_;
+  size_t length_ = 0;
+  size_t position_ = 0;
+  bool no_statx_ = false;
+};
+
+#else  // !__linux__
+
+// Reads directories through libuv, in batches of kEntries.
+class DirReader {
+ public:
+  DirReader() = default;
+  ~DirReader() { Close(); }
+
+  bool IsOpen() const { return dir_ != nullptr; }
+
+  int Open(const std::string& path) {
+    uv_fs_t req;
+    int err = uv_fs_opendir(nullptr, &req, path.c_str(), nullptr);
+    if (err == 0) {
+      dir_ = static_cast<uv_dir_t*>(req.ptr);
+      dir_->dirents = entries_;
+      dir_->nentries = kEntries;
+      count_ = position_ = 0;
+    }
+    uv_fs_req_cleanup(&req);
+    return err;
+  }
+
+  void Close() {
+    if (dir_ == nullptr) return;
+    CleanupRead();
+    uv_fs_t req;
+    uv_fs_closedir(nullptr, &req, dir_, nullptr);
+    uv_fs_req_cleanup(&req);
+    dir_ = nullptr;
+  }
+
+  // Returns 1 for an entry, 0 at the end of the directory, or an error.
+  int Next(const char** name, int* type) {
+    if (position_ >= count_) {
+      CleanupRead();
+      int count = uv_fs_readdir(nullptr, &read_req_, dir_, nullptr);
+      has_read_req_ = true;
+      if (count <= 0) return count;
+      count_ = count;
+      position_ = 0;
+    }
+    *name = entries_[position_].name;
+    *type = entries_[position_].type;
+    position_++;
+    return 1;
+  }
+
+  int Stat(const char* name, const std::string& path, uv_stat_t* stat) {
+    uv_fs_t req;
+    int err = uv_fs_lstat(nullptr, &req, path.c_str(), nullptr);
+    if (err == 0) *stat = req.statbuf;
+    uv_fs_req_cleanup(&req);
+    return err;
+  }
+
+ private:
+  static constexpr size_t kEntries = 256;
+
+  // The names of the entries belong to the last uv_fs_readdir() request.
+  void CleanupRead() {
+    if (!has_read_req_) return;
+    uv_fs_req_cleanup(&read_req_);
+    has_read_req_ = false;
+  }
+
+  uv_dir_t* dir_ = nullptr;
+  uv_dirent_t entries_[kEntries];
+  uv_fs_t read_req_;
+  bool has_read_req_ = false;
+  size_t count_ = 0;
+  size_t position_ = 0;
+};
+
+#endif  // __linux__
+
+class DirWalker::ReadJob final : public ThreadPoolWork {
+ public:
+  ReadJob(Environment* env,
+          DirWalker* walker,
+          FSReqBase* req_wrap,
+          size_t max_entries,
+          enum encoding encoding,
+          bool use_bigint)
+      : ThreadPoolWork(env),
+        walker_(walker),
+        req_wrap_(req_wrap),
+        max_entries_(max_entries),
+        encoding_(encoding),
+        use_bigint_(use_bigint) {}
+
+  void DoThreadPoolWork() override {
+    walker_->ReadBatch(max_entries_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadJob> self(this);
+    DirWalker* walker = walker_.get();
+    walker->reading_ = false;
+
+    // Entries that were read before an error are delivered first.
+    const bool failed = walker->names_.empty() && walker->err_ < 0;
+    InitJobRequest(req_wrap_,
+                   status != 0 ? status : (failed ? walker->err_ : 0),
+                   failed ? walker->syscall_ : "readdir",
+                   failed ? walker->err_path_.c_str() : nullptr);
+
+    FSReqAfterScope after(req_wrap_, req_wrap_->req());
+    if (failed) {
+      walker->err_ = 0;
+      walker->done_ = true;
+    }
+    if (!after.Proceed()) return;
+
+    Environment* env = walker->env();
+    Isolate* isolate = env->isolate();
+    const size_t count = walker->names_.size();
+    if (count == 0) {
+      req_wrap_->Resolve(Null(isolate));
+      return;
+    }
+
+    MaybeStackBuffer<Local<Value>, 64> names(count);
+    MaybeStackBuffer<Local<Value>, 64> types(count);
+    for (size_t i = 0; i < count; i++) {
+      const std::string& name = walker->names_[i];
+      Local<Value> error;
+      if (!StringBytes::Encode(isolate, name.data(), name.size(), encoding_,
+                               &error).ToLocal(&names[i])) {
+        return req_wrap_->Reject(error);
+      }
+      types[i] = Integer::New(isolate, walker->types_[i]);
+    }
+
+    Local<Value> stats = Undefined(isolate);
+    if (walker->with_stats_) {
+      const size_t fields =
+          static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+      if (use_bigint_) {
+        AliasedBigUint64Array array(isolate, count * fields);
+        for (size_t i = 0; i < count; i++)
+          fs::FillStatsArray(&array, &walker->stats_[i], i * fields);
+        stats = array.GetJSArray();
+      } else {
+        AliasedFloat64Array array(isolate, count * fields);
+        for (size_t i = 0; i < count; i++)
+          fs::FillStatsArray(&array, &walker->stats_[i], i * fields);
+        stats = array.GetJSArray();
+      }
+    }
+
+    Local<Value> result[] = {
+      Array::New(isolate, names.out(), count),
+      Array::New(isolate, types.out(), count),
+      stats
+    };
+    req_wrap_->Resolve(Array::New(isolate, result, arraysize(result)));
+  }
+
+ private:
+  BaseObjectPtr<DirWalker> walker_;
+  FSReqBase* req_wrap_;
+  const size_t max_entries_;
+  const enum encoding encoding_;
+  const bool use_bigint_;
+};
+
+DirWalker::DirWalker(Environment* env,
+                     Local<Object> obj,
+                     std::string&& root,
+                     bool with_stats)
+    : BaseObject(env, obj),
+      root_(std::move(root)),
+      with_stats_(with_stats),
+      pending_({""}),
+      current_(new DirReader()) {
+  MakeWeak();
+}
+
+DirWalker::~DirWalker() {}
+
+void DirWalker::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+  CHECK(args[1]->IsBoolean());
+
+  new DirWalker(env, args.This(), std::string(*path, path.length()),
+                args[1]->IsTrue());
+}
+
+void DirWalker::Read(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  DirWalker* walker;
+  ASSIGN_OR_RETURN_UNWRAP(&walker, args.Holder());
+  // The walker is not thread-safe, so reads have to be made one at a time.
+  CHECK(!walker->reading_);
+
+  const enum encoding encoding =
+      ParseEncoding(env->isolate(), args[0], UTF8);
+  CHECK(args[1]->IsUint32());
+  const size_t max_entries = args[1].As<Uint32>()->Value();
+  CHECK_GT(max_entries, 0);
+  const bool use_bigint = args[2]->IsTrue();
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  CHECK_NOT_NULL(req_wrap_async);
+  walker->reading_ = true;
+  ReadJob* job = new ReadJob(env, walker, req_wrap_async, max_entries,
+                             encoding, use_bigint);
+  job->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
+void DirWalker::Close(const FunctionCallbackInfo<Value>& args) {
+  DirWalker* walker;
+  ASSIGN_OR_RETURN_UNWRAP(&walker, args.Holder());
+  CHECK(!walker->reading_);
+  walker->current_->Close();
+  walker->pending_.clear();
+  walker->done_ = true;
+}
+
+void DirWalker::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackField("pending", pending_);
+  tracker->TrackField("names", names_);
+  tracker->TrackFieldWithSize("stats", stats_.capacity() * sizeof(uv_stat_t));
+}
+
+std::string DirWalker::JoinRelative(const char* name) const {
+  if (current_path_.empty()) return name;
+  std::string path;
+  path.reserve(current_path_.size() + 1 + strlen(name));
+  path += current_path_;
+  path += kPathSeparator;
+  path += name;
+  return path;
+}
+
+std::string DirWalker::FullPath(const std::string& relative) const {
+  if (relative.empty()) return root_;
+  return root_ + kPathSeparator + relative;
+}
+
+void DirWalker::SetError(int err,
+                         const char* syscall,
+                         const std::string& path) {
+  current_->Close();
+  pending_.clear();
+  err_ = err;
+  syscall_ = syscall;
+  err_path_ = path;
+}
+
+int DirWalker::OpenNextDirectory() {
+  while (!pending_.empty()) {
+    current_path_ = std::move(pending_.back());
+    pending_.pop_back();
+    const std::string path = FullPath(current_path_);
+    int err = current_->Open(path);
+    if (err == 0) return 0;
+    // Directories below the root may have been removed or replaced since
+    // they were seen.
+    if (!current_path_.empty() && (err == UV_ENOENT || err == UV_ENOTDIR))
+      continue;
+    SetError(err, "opendir", path);
+    return err;
+  }
+  done_ = true;
+  return UV_EOF;
+}
+
+void DirWalker::ReadBatch(size_t max_entries) {
+  names_.clear();
+  types_.clear();
+  stats_.clear();
+
+  while (!done_ && err_ == 0 && names_.size() < max_entries) {
+    if (!current_->IsOpen() && OpenNextDirectory() != 0)
+      return;
+
+    const char* name;
+    int type;
+    int result = current_->Next(&name, &type);
+    if (result < 0) {
+      SetError(result, "readdir", FullPath(current_path_));
+      return;
+    }
+    if (result == 0) {
+      current_->Close();
+      continue;
+    }
+
+    std::string relative = JoinRelative(name);
+    uv_stat_t stat;
+    if (with_stats_ || type == UV_DIRENT_UNKNOWN) {
+      const std::string path = FullPath(relative);
+      int err = current_->Stat(name, path, &stat);
+      // The entry was removed while the directory was read.
+      if (err == UV_ENOENT) continue;
+      if (err < 0) {
+        SetError(err, "lstat", path);
+        return;
+      }
+      type = TypeFromMode(stat.st_mode);
+    }
+
+    if (type == UV_DIRENT_DIR)
+      pending_.push_back(relative);
+    names_.push_back(std::move(relative));
+    types_.push_back(type);
+    if (with_stats_)
+      stats_.push_back(stat);
+  }
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -367,6 +851,19 @@ void Initialize(Local<Object> target,
             dir->GetFunction(env->context()).ToLocalChecked())
       .FromJust();
   env->set_dir_instance_template(dirt);
+
+  // Create FunctionTemplate for DirWalker
+  Local<FunctionTemplate> walker = env->NewFunctionTemplate(DirWalker::New);
+  env->SetProtoMethod(walker, "read", DirWalker::Read);
+  env->SetProtoMethod(walker, "close", DirWalker::Close);
+  walker->InstanceTemplate()->SetInternalFieldCount(
+      DirWalker::kInternalFieldCount);
+  Local<String> walkerString = FIXED_ONE_BYTE_STRING(isolate, "DirWalker");
+  walker->SetClassName(walkerString);
+  target
+      ->Set(context, walkerString,
+            walker->GetFunction(env->context()).ToLocalChecked())
+      .Check();
 }
 
 }  // namespace fs_dir
@@ -5,6 +5,9 @@
 
 #include "node_file.h"
 
+#include <string>
+#include <vector>
+
 namespace node {
 
 namespace fs_dir {
@@ -43,6 +46,67 @@ class DirHandle : public AsyncWrap {
   bool closed_ = false;
 };
 
+class DirReader;
+
+// Walks a directory tree, depth first, on the threadpool. Each read() returns
+// a batch of entries as flat arrays of paths (relative to the root), dirent
+// types and, optionally, lstat() results, instead of one request per entry.
+// Symbolic links are reported but not followed.
+class DirWalker : public BaseObject {
+ public:
+  ~DirWalker() override;
+
+  // new DirWalker(path, withStats)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // walker.read(encoding, maxEntries, bigint, req)
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // walker.close()
+  static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(DirWalker)
+  SET_SELF_SIZE(DirWalker)
+
+  DirWalker(const DirWalker&) = delete;
+  DirWalker& operator=(const DirWalker&) = delete;
+
+ private:
+  class ReadJob;
+
+  DirWalker(Environment* env,
+            v8::Local<v8::Object> obj,
+            std::string&& root,
+            bool with_stats);
+
+  // These run on the threadpool.
+  void ReadBatch(size_t max_entries);
+  int OpenNextDirectory();
+  void SetError(int err, const char* syscall, const std::string& path);
+
+  std::string JoinRelative(const char* name) const;
+  std::string FullPath(const std::string& relative) const;
+
+  const std::string root_;
+  const bool with_stats_;
+  // Directories, relative to root_, that are still to be read.
+  std::vector<std::string> pending_;
+  // The directory that is being read, relative to root_.
+  std::string current_path_;
+  std::unique_ptr<DirReader> current_;
+  bool reading_ = false;
+  bool done_ = false;
+
+  // The last batch.
+  std::vector<std::string> names_;
+  std::vector<int> types_;
+  std::vector<uv_stat_t> stats_;
+  // An error that ended the walk. It is reported after the entries that were
+  // read before it.
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  std::string err_path_;
+};
+
 }  // namespace fs_dir
 
 }  // namespace node
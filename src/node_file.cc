@@ -20,7 +20,10 @@
 // USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "node_file.h"  // NOLINT(build/include_inline)
 #include "node_file-inl.h"
+#include "node_file_mmap.h"
+#include "node_file_tree.h"
 #include "aliased_buffer.h"
+#include "base64.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
 #include "node_process.h"
@@ -32,6 +35,7 @@
 #include "req_wrap-inl.h"
 #include "stream_base-inl.h"
 #include "string_bytes.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -51,11 +55,14 @@ namespace node {
 namespace fs {
 
 using v8::Array;
+using v8::BackingStore;
+using v8::ArrayBufferView;
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
@@ -66,6 +73,7 @@ using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::Promise;
+using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
 using v8::Uint32;
@@ -149,6 +157,12 @@ void FileHandle::New(const FunctionCallbackInfo<Value>& args) {
     handle->read_offset_ = args[1]->IntegerValue(env->context()).FromJust();
   if (args[2]->IsNumber())
     handle->read_length_ = args[2]->IntegerValue(env->context()).FromJust();
+  if (args[3]->IsNumber()) {
+    int64_t chunk_size = args[3]->IntegerValue(env->context()).FromJust();
+    CHECK_GT(chunk_size, 0);
+    CHECK_LE(chunk_size, static_cast<int64_t>(INT32_MAX));
+    handle->read_chunk_size_ = chunk_size;
+  }
 }
 
 FileHandle::~FileHandle() {
@@ -398,7 +412,7 @@ int FileHandle::ReadStart() {
       read_wrap = std::make_unique<FileHandleReadWrap>(this, wrap_obj);
     }
   }
-  int64_t recommended_read = 65536;
+  int64_t recommended_read = read_chunk_size_;
   if (read_length_ >= 0 && read_length_ <= recommended_read)
     recommended_read = read_length_;
 
@@ -908,6 +922,26 @@ quote:
   args.GetReturnValue().Set(return_value);
 }
 
+static int ModuleStat(Environment* env, const std::string& path) {
+  if (env->module_stat_cache_enabled) {
+    auto it = env->module_stat_cache.find(path);
+    if (it != env->module_stat_cache.end())
+      return it->second;
+  }
+
+  uv_fs_t req;
+  int rc = uv_fs_stat(env->event_loop(), &req, path.c_str(), nullptr);
+  if (rc == 0) {
+    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+    rc = !!(s->st_mode & S_IFDIR);
+  }
+  uv_fs_req_cleanup(&req);
+
+  if (env->module_stat_cache_enabled)
+    env->module_stat_cache.emplace(path, rc);
+  return rc;
+}
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
@@ -917,15 +951,75 @@ static void InternalModuleStat(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsString());
   node::Utf8Value path(env->isolate(), args[0]);
 
-  uv_fs_t req;
-  int rc = uv_fs_stat(env->event_loop(), &req, *path, nullptr);
-  if (rc == 0) {
-    const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
-    rc = !!(s->st_mode & S_IFDIR);
+  args.GetReturnValue().Set(ModuleStat(env, *path));
+}
+
+// Turns the cache of internalModuleStat() results on or off, dropping the
+// results that were cached so far either way.
+static void InternalModuleStatCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsBoolean());
+  env->module_stat_cache_enabled = args[0]->IsTrue();
+  env->module_stat_cache.clear();
+}
+
+// Used to speed up the lookup of packages in node_modules directories.
+// internalModuleFilterPaths(paths, name, hasSubpath, extensions) returns the
+// indexes of the directories in `paths` that could contain the package
+// `name`: those that exist and have an entry called `name` in them, or, if
+// there is no subpath, a file called `name` plus one of the extensions. All
+// other directories are left out, since the module loader would not find
+// anything in them, which saves it from checking every candidate filename in
+// each of them.
+static void InternalModuleFilterPaths(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  CHECK(args[0]->IsArray());
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsBoolean());
+  CHECK(args[3]->IsArray());
+  Local<Array> paths = args[0].As<Array>();
+  node::Utf8Value name(isolate, args[1]);
+  bool has_subpath = args[2]->IsTrue();
+  Local<Array> extensions_array = args[3].As<Array>();
+
+  std::vector<std::string> extensions;
+  if (!has_subpath) {
+    for (uint32_t i = 0; i < extensions_array->Length(); i++) {
+      Local<Value> extension;
+      if (!extensions_array->Get(context, i).ToLocal(&extension)) return;
+      CHECK(extension->IsString());
+      extensions.emplace_back(*node::Utf8Value(isolate, extension));
+    }
+  }
+
+  std::vector<Local<Value>> indexes;
+  for (uint32_t i = 0; i < paths->Length(); i++) {
+    Local<Value> dir_value;
+    if (!paths->Get(context, i).ToLocal(&dir_value)) return;
+    if (!dir_value->IsString()) {
+      // Leave it to the module loader to deal with.
+      indexes.push_back(Integer::NewFromUnsigned(isolate, i));
+      continue;
+    }
+    node::Utf8Value dir(isolate, dir_value);
+    if (dir.length() == 0 || ModuleStat(env, *dir) != 1) continue;
+
+    std::string base(*dir);
+    base += kPathSeparator;
+    base += *name;
+    bool found = ModuleStat(env, base) >= 0;
+    for (size_t j = 0; !found && j < extensions.size(); j++)
+      found = ModuleStat(env, base + extensions[j]) == 0;
+    if (found)
+      indexes.push_back(Integer::NewFromUnsigned(isolate, i));
   }
-  uv_fs_req_cleanup(&req);
 
-  args.GetReturnValue().Set(rc);
+  args.GetReturnValue().Set(
+      Array::New(isolate, indexes.data(), indexes.size()));
 }
 
 static void Stat(const FunctionCallbackInfo<Value>& args) {
@@ -1879,12 +1973,16 @@ static void WriteString(const FunctionCallbackInfo<Value>& args) {
     len = StringBytes::Write(isolate, *stack_buffer, len, args[1], enc);
     stack_buffer.SetLengthAndZeroTerminate(len);
     uv_buf_t uvbuf = uv_buf_init(*stack_buffer, len);
-    int err = req_wrap_async->Dispatch(uv_fs_write,
-                                       fd,
-                                       &uvbuf,
-                                       1,
-                                       pos,
-                                       AfterInteger);
+    int err = 0;
+    if (!DispatchToIoUring(env, req_wrap_async, uv_fs_write,
+                           fd, &uvbuf, 1, pos, AfterInteger)) {
+      err = req_wrap_async->Dispatch(uv_fs_write,
+                                     fd,
+                                     &uvbuf,
+                                     1,
+                                     pos,
+                                     AfterInteger);
+    }
     if (err < 0) {
       uv_fs_t* uv_req = req_wrap_async->req();
       uv_req->result = err;
@@ -1976,6 +2074,438 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Wrapper for readv(2).
+//
+// bytesRead = readv(fd, buffers, position, callback)
+// 0 fd        integer. file descriptor
+// 1 buffers   array of buffers to read into
+// 2 position  if integer, position to read at in the file.
+//             if null, read from the current position
+static void ReadBuffers(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 3);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(args[1]->IsArray());
+  Local<Array> buffers = args[1].As<Array>();
+
+  int64_t pos = GetOffset(args[2]);
+
+  MaybeStackBuffer<uv_buf_t> iovs(buffers->Length());
+
+  for (uint32_t i = 0; i < iovs.length(); i++) {
+    Local<Value> buffer = buffers->Get(env->context(), i).ToLocalChecked();
+    CHECK(Buffer::HasInstance(buffer));
+    iovs[i] = uv_buf_init(Buffer::Data(buffer), Buffer::Length(buffer));
+  }
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  if (req_wrap_async != nullptr) {  // readBuffers(fd, buffers, pos, req)
+    AsyncCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
+              uv_fs_read, fd, *iovs, iovs.length(), pos);
+  } else {  // readBuffers(fd, buffers, pos, undefined, ctx)
+    CHECK_EQ(argc, 5);
+    FSReqWrapSync req_wrap_sync;
+    FS_SYNC_TRACE_BEGIN(read);
+    int bytesRead = SyncCall(env, args[4], &req_wrap_sync, "read",
+                             uv_fs_read, fd, *iovs, iovs.length(), pos);
+    FS_SYNC_TRACE_END(read, "bytesRead", bytesRead);
+    args.GetReturnValue().Set(bytesRead);
+  }
+}
+
+
+void InitJobRequest(FSReqBase* req_wrap,
+                    ssize_t result,
+                    const char* syscall,
+                    const char* path) {
+  uv_fs_t* req = req_wrap->req();
+  req->fs_type = UV_FS_UNKNOWN;
+  req->cb = nullptr;
+  req->result = result;
+  req->path = path;
+  req->new_path = nullptr;
+  req->bufs = nullptr;
+  req->ptr = nullptr;
+  req_wrap->Init(syscall, nullptr, 0, UTF8);
+}
+
+
+// Regular files up to this size are read by a single ReadFileJob. Larger
+// files, and files whose size is not known up front, are left to the chunked
+// reader in lib/internal/fs/read_file_context.js, which uses the same size
+// per read, so that no job keeps a threadpool thread busy for long.
+constexpr size_t kReadFileJobMaxSize = 512 * 1024;
+
+// Opens, fstats, reads and closes a file in one threadpool job, instead of
+// one request and one trip through the event loop for each step. hex and
+// base64 results are also encoded on the threadpool.
+class ReadFileJob final : public ThreadPoolWork {
+ public:
+  ReadFileJob(Environment* env,
+              FSReqBase* req_wrap,
+              std::string&& path,
+              uv_file fd,
+              int flags,
+              enum encoding encoding)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        path_(std::move(path)),
+        fd_(fd),
+        is_user_fd_(fd >= 0),
+        flags_(flags),
+        encoding_(encoding),
+        data_(env) {}
+
+  void DoThreadPoolWork() override {
+    uv_fs_t req;
+    if (!is_user_fd_) {
+      int fd = uv_fs_open(nullptr, &req, path_.c_str(), flags_, 0666, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (fd < 0) {
+        err_ = fd;
+        return;
+      }
+      fd_ = fd;
+    }
+
+    syscall_ = "fstat";
+    err_ = uv_fs_fstat(nullptr, &req, fd_, nullptr);
+    const bool is_regular = (req.statbuf.st_mode & S_IFMT) == S_IFREG;
+    const uint64_t size = req.statbuf.st_size;
+    uv_fs_req_cleanup(&req);
+    if (err_ < 0) return Close();
+    // Leave the file open for the chunked reader.
+    if (!is_regular || size == 0 || size > kReadFileJobMaxSize) return;
+
+    data_ = env()->AllocateManaged(size, false);
+    if (data_.data() == nullptr) return;
+
+    syscall_ = "read";
+    size_t total = 0;
+    while (total < size) {
+      uv_buf_t buf = uv_buf_init(data_.data() + total, size - total);
+      int bytes_read = uv_fs_read(nullptr, &req, fd_, &buf, 1, -1, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (bytes_read < 0) {
+        err_ = bytes_read;
+        data_.clear();
+        return Close();
+      }
+      if (bytes_read == 0) break;
+      total += bytes_read;
+    }
+    // The file was truncated while it was read.
+    if (total < size) data_.Resize(total);
+    done_ = true;
+
+    if (encoding_ == HEX || encoding_ == BASE64) {
+      size_t length = encoding_ == HEX ? total * 2 : base64_encoded_size(total);
+      AllocatedBuffer encoded = env()->AllocateManaged(length, false);
+      if (encoded.data() != nullptr) {
+        if (encoding_ == HEX)
+          StringBytes::hex_encode(data_.data(), total, encoded.data(), length);
+        else
+          base64_encode(data_.data(), total, encoded.data(), length);
+        data_ = std::move(encoded);
+        // The result is ASCII now, which latin1 leaves as it is.
+        encoding_ = LATIN1;
+      }
+    }
+
+    Close();
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadFileJob> self(this);
+    Isolate* isolate = env()->isolate();
+
+    InitJobRequest(req_wrap_,
+                   status != 0 ? status : err_,
+                   syscall_,
+                   strcmp(syscall_, "open") == 0 ? path_.c_str() : nullptr);
+
+    FSReqAfterScope after(req_wrap_, req_wrap_->req());
+    if (!after.Proceed()) return;
+
+    if (!done_) {
+      req_wrap_->Resolve(Integer::New(isolate, fd_));
+      return;
+    }
+
+    // The data is far below kMaxLength, so this cannot fail.
+    Local<Object> buffer = data_.ToBuffer().ToLocalChecked();
+    if (encoding_ == BUFFER) {
+      req_wrap_->Resolve(buffer);
+      return;
+    }
+
+    Local<Value> error;
+    MaybeLocal<Value> result = StringBytes::EncodeTransfer(
+        isolate, buffer.As<ArrayBufferView>(), encoding_, &error);
+    if (result.IsEmpty()) {
+      req_wrap_->Reject(error);
+      return;
+    }
+    req_wrap_->Resolve(result.ToLocalChecked());
+  }
+
+ private:
+  void Close() {
+    if (is_user_fd_) return;
+    uv_fs_t req;
+    int err = uv_fs_close(nullptr, &req, fd_, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0 && err_ == 0) {
+      syscall_ = "close";
+      err_ = err;
+    }
+  }
+
+  FSReqBase* req_wrap_;
+  std::string path_;
+  uv_file fd_;
+  const bool is_user_fd_;
+  const int flags_;
+  enum encoding encoding_;
+  // The syscall that the error, if any, comes from.
+  const char* syscall_ = "open";
+  int err_ = 0;
+  // False if the file is left to the chunked reader.
+  bool done_ = false;
+  AllocatedBuffer data_;
+};
+
+// fs.readFile(path | fd, flags, encoding, req)
+// Resolves with the contents of the file, or with the file descriptor if the
+// file has to be read in chunks.
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  std::string path;
+  uv_file fd = -1;
+  if (args[0]->IsInt32()) {
+    fd = args[0].As<Int32>()->Value();
+    CHECK_GE(fd, 0);
+  } else {
+    BufferValue path_value(isolate, args[0]);
+    CHECK_NOT_NULL(*path_value);
+    path.assign(*path_value, path_value.length());
+  }
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  const enum encoding encoding = ParseEncoding(isolate, args[2], BUFFER);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  CHECK_NOT_NULL(req_wrap_async);
+  ReadFileJob* job = new ReadFileJob(env, req_wrap_async, std::move(path),
+                                     fd, flags, encoding);
+  job->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
+
+// Reads many (position, buffer) pairs from one file in a single threadpool
+// job, using positioned reads that leave the file position alone. Each buffer
+// is filled completely unless the end of the file comes first.
+class ReadBatchJob final : public ThreadPoolWork {
+ public:
+  ReadBatchJob(Environment* env,
+               FSReqBase* req_wrap,
+               uv_file fd,
+               Local<Array> buffers,
+               std::vector<uv_buf_t>&& bufs,
+               std::vector<int64_t>&& positions)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        fd_(fd),
+        buffers_(env->isolate(), buffers),
+        bufs_(std::move(bufs)),
+        positions_(std::move(positions)),
+        bytes_read_(bufs_.size(), 0) {}
+
+  void DoThreadPoolWork() override {
+    for (size_t i = 0; i < bufs_.size(); i++) {
+      while (bytes_read_[i] < bufs_[i].len) {
+        uv_fs_t req;
+        uv_buf_t buf = uv_buf_init(bufs_[i].base + bytes_read_[i],
+                                   bufs_[i].len - bytes_read_[i]);
+        int result = uv_fs_read(nullptr, &req, fd_, &buf, 1,
+                                positions_[i] + bytes_read_[i], nullptr);
+        uv_fs_req_cleanup(&req);
+        if (result < 0) {
+          err_ = result;
+          return;
+        }
+        if (result == 0) break;
+        bytes_read_[i] += result;
+      }
+    }
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<ReadBatchJob> self(this);
+    Isolate* isolate = env()->isolate();
+
+    InitJobRequest(req_wrap_, status != 0 ? status : err_, "read", nullptr);
+
+    FSReqAfterScope after(req_wrap_, req_wrap_->req());
+    if (!after.Proceed()) return;
+
+    std::vector<Local<Value>> bytes_read(bytes_read_.size());
+    for (size_t i = 0; i < bytes_read_.size(); i++)
+      bytes_read[i] = Number::New(isolate, bytes_read_[i]);
+    req_wrap_->Resolve(Array::New(isolate, bytes_read.data(),
+                                  bytes_read.size()));
+  }
+
+ private:
+  FSReqBase* req_wrap_;
+  const uv_file fd_;
+  // Keeps the buffers alive while the threadpool writes into them.
+  Global<Array> buffers_;
+  std::vector<uv_buf_t> bufs_;
+  std::vector<int64_t> positions_;
+  std::vector<size_t> bytes_read_;
+  int err_ = 0;
+};
+
+// filehandle.readBatch(fd, buffers, positions, req)
+// Resolves with an array that holds the number of bytes read into each buffer.
+static void ReadBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Context> context = env->context();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 4);
+
+  CHECK(args[0]->IsInt32());
+  const int fd = args[0].As<Int32>()->Value();
+
+  CHECK(args[1]->IsArray());
+  Local<Array> buffers = args[1].As<Array>();
+  CHECK(args[2]->IsArray());
+  Local<Array> positions = args[2].As<Array>();
+  CHECK_EQ(buffers->Length(), positions->Length());
+
+  std::vector<uv_buf_t> bufs(buffers->Length());
+  std::vector<int64_t> offsets(positions->Length());
+  for (uint32_t i = 0; i < bufs.size(); i++) {
+    Local<Value> buffer = buffers->Get(context, i).ToLocalChecked();
+    CHECK(Buffer::HasInstance(buffer));
+    bufs[i] = uv_buf_init(Buffer::Data(buffer), Buffer::Length(buffer));
+    Local<Value> position = positions->Get(context, i).ToLocalChecked();
+    CHECK(IsSafeJsInt(position));
+    offsets[i] = position.As<Integer>()->Value();
+    CHECK_GE(offsets[i], 0);
+  }
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
+  CHECK_NOT_NULL(req_wrap_async);
+  ReadBatchJob* job = new ReadBatchJob(env, req_wrap_async, fd, buffers,
+                                       std::move(bufs), std::move(offsets));
+  job->ScheduleWork();
+  req_wrap_async->SetReturnValue(args);
+}
+
+
+// Maps a file into memory on the threadpool for fs.mapFile().
+class MapFileJob final : public ThreadPoolWork {
+ public:
+  MapFileJob(Environment* env,
+             FSReqBase* req_wrap,
+             std::string&& path,
+             MapFileAdvice advice)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        path_(std::move(path)),
+        advice_(advice) {}
+
+  void DoThreadPoolWork() override {
+    err_ = MapFile(path_.c_str(), advice_, &backing_store_, &syscall_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<MapFileJob> self(this);
+
+    InitJobRequest(req_wrap_, status != 0 ? status : err_, syscall_,
+                   path_.c_str());
+
+    FSReqAfterScope after(req_wrap_, req_wrap_->req());
+    if (!after.Proceed()) return;
+
+    req_wrap_->Resolve(SharedArrayBuffer::New(env()->isolate(),
+                                              std::move(backing_store_)));
+  }
+
+ private:
+  FSReqBase* req_wrap_;
+  std::string path_;
+  const MapFileAdvice advice_;
+  const char* syscall_ = "open";
+  int err_ = 0;
+  // Unmaps the file again if the result is never handed to JS.
+  std::unique_ptr<BackingStore> backing_store_;
+};
+
+// fs.mapFile(path, advice, req)
+// Resolves with a SharedArrayBuffer that is backed by a private mapping of
+// the file.
+static void MapFileBinding(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  BufferValue path(isolate, args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int advice_value = args[1].As<Int32>()->Value();
+  CHECK_GE(advice_value, kMapAdviceNormal);
+  CHECK_LE(advice_value, kMapAdviceWillNeed);
+  const MapFileAdvice advice = static_cast<MapFileAdvice>(advice_value);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2]);
+  if (req_wrap_async != nullptr) {  // mapFile(path, advice, req)
+    MapFileJob* job = new MapFileJob(
+        env, req_wrap_async, std::string(*path, path.length()), advice);
+    job->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // mapFile(path, advice, undefined, ctx)
+    CHECK_EQ(argc, 4);
+    std::unique_ptr<BackingStore> backing_store;
+    const char* syscall;
+    env->PrintSyncTrace();
+    FS_SYNC_TRACE_BEGIN(mmap);
+    int err = MapFile(*path, advice, &backing_store, &syscall);
+    FS_SYNC_TRACE_END(mmap);
+    if (err < 0) {
+      Local<Context> context = env->context();
+      Local<Object> ctx_obj = args[3].As<Object>();
+      ctx_obj->Set(context, env->errno_string(),
+                   Integer::New(isolate, err)).Check();
+      ctx_obj->Set(context, env->syscall_string(),
+                   OneByteString(isolate, syscall)).Check();
+      return;
+    }
+    args.GetReturnValue().Set(
+        SharedArrayBuffer::New(isolate, std::move(backing_store)));
+  }
+}
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2190,6 +2720,15 @@ static void FUTimes(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Turns the io_uring path for asynchronous requests on or off, and returns
+// whether it is in use. This is what the benchmarks compare with.
+static void UseIoUring(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsBoolean());
+  env->fs_io_uring_enabled = args[0]->IsTrue();
+  args.GetReturnValue().Set(IoUring::Get(env) != nullptr);
+}
+
 static void Mkdtemp(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -2239,15 +2778,24 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
   env->SetMethod(target, "read", Read);
+  env->SetMethod(target, "readFile", ReadFile);
+  env->SetMethod(target, "readBuffers", ReadBuffers);
+  env->SetMethod(target, "readBatch", ReadBatch);
+  env->SetMethod(target, "mapFile", MapFileBinding);
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
   env->SetMethod(target, "rename", Rename);
   env->SetMethod(target, "ftruncate", FTruncate);
   env->SetMethod(target, "rmdir", RMDir);
+  env->SetMethod(target, "rmTree", RmTree);
   env->SetMethod(target, "mkdir", MKDir);
   env->SetMethod(target, "readdir", ReadDir);
   env->SetMethod(target, "internalModuleReadJSON", InternalModuleReadJSON);
   env->SetMethod(target, "internalModuleStat", InternalModuleStat);
+  env->SetMethod(target, "internalModuleStatCache", InternalModuleStatCache);
+  env->SetMethod(target, "internalModuleFilterPaths",
+                 InternalModuleFilterPaths);
+  env->SetMethod(target, "useIoUring", UseIoUring);
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
@@ -2260,6 +2808,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "writeString", WriteString);
   env->SetMethod(target, "realpath", RealPath);
   env->SetMethod(target, "copyFile", CopyFile);
+  env->SetMethod(target, "copyTree", CopyTree);
 
   env->SetMethod(target, "chmod", Chmod);
   env->SetMethod(target, "fchmod", FChmod);
@@ -2360,6 +2909,11 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "kUsePromises"),
               use_promises_symbol).Check();
+
+  NODE_DEFINE_CONSTANT(target, kMapAdviceNormal);
+  NODE_DEFINE_CONSTANT(target, kMapAdviceSequential);
+  NODE_DEFINE_CONSTANT(target, kMapAdviceRandom);
+  NODE_DEFINE_CONSTANT(target, kMapAdviceWillNeed);
 }
 
 }  // namespace fs
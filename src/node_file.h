@@ -293,11 +293,21 @@ class FileHandle final : public AsyncWrap, public StreamBase {
   bool closed_ = false;
   int64_t read_offset_ = -1;
   int64_t read_length_ = -1;
+  // How much ReadStart() asks for in a single uv_fs_read().
+  int64_t read_chunk_size_ = 65536;
 
   bool reading_ = false;
   std::unique_ptr<FileHandleReadWrap> current_read_ = nullptr;
 };
 
+// Sets up a request that a ThreadPoolWork job completes in place of libuv,
+// for the fields that FSReqAfterScope and uv_fs_req_cleanup() look at. The
+// request was never dispatched, so uv_fs_*() has not done this.
+void InitJobRequest(FSReqBase* req_wrap,
+                    ssize_t result,
+                    const char* syscall,
+                    const char* path);
+
 int MKDirpSync(uv_loop_t* loop,
                uv_fs_t* req,
                const std::string& path,
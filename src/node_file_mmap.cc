@@ -0,0 +1,121 @@
+#include "node_file_mmap.h"
+#include "util-inl.h"
+#include "uv.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+
+namespace node {
+namespace fs {
+
+using v8::BackingStore;
+using v8::SharedArrayBuffer;
+
+namespace {
+
+void Unmap(void* data, size_t length, void* deleter_data) {
+#ifdef _WIN32
+  CHECK(UnmapViewOfFile(data));
+#else
+  CHECK_EQ(munmap(data, length), 0);
+#endif
+}
+
+void UnmapEmpty(void* data, size_t length, void* deleter_data) {}
+
+// Maps length bytes of fd. Returns nullptr and sets *err on failure.
+void* Map(uv_file fd, size_t length, MapFileAdvice advice, int* err) {
+#ifdef _WIN32
+  HANDLE file = reinterpret_cast<HANDLE>(uv_get_osfhandle(fd));
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    *err = uv_translate_sys_error(GetLastError());
+    return nullptr;
+  }
+  void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, length);
+  if (data == nullptr)
+    *err = uv_translate_sys_error(GetLastError());
+  // The view keeps the mapping object alive.
+  CloseHandle(mapping);
+  return data;
+#else
+  void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                    fd, 0);
+  if (data == MAP_FAILED) {
+    *err = uv_translate_sys_error(errno);
+    return nullptr;
+  }
+
+  static const int kAdvice[] = {
+    POSIX_MADV_NORMAL,
+    POSIX_MADV_SEQUENTIAL,
+    POSIX_MADV_RANDOM,
+    POSIX_MADV_WILLNEED
+  };
+  // This is only a hint, so failures do not matter.
+  USE(posix_madvise(data, length, kAdvice[advice]));
+  return data;
+#endif
+}
+
+}  // anonymous namespace
+
+int MapFile(const char* path,
+            MapFileAdvice advice,
+            std::unique_ptr<BackingStore>* backing_store,
+            const char** syscall) {
+  CHECK_GE(advice, kMapAdviceNormal);
+  CHECK_LE(advice, kMapAdviceWillNeed);
+
+  uv_fs_t req;
+  *syscall = "open";
+  const uv_file fd = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) return fd;
+
+  *syscall = "fstat";
+  int err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+  const uint64_t mode = req.statbuf.st_mode;
+  const uint64_t size = req.statbuf.st_size;
+  uv_fs_req_cleanup(&req);
+
+  void* data = nullptr;
+  if (err == 0) {
+    *syscall = "mmap";
+    if ((mode & S_IFMT) == S_IFDIR)
+      err = UV_EISDIR;
+    else if ((mode & S_IFMT) != S_IFREG)
+      err = UV_ENODEV;
+    else if (size > SIZE_MAX)
+      err = UV_ENOMEM;
+    else if (size > 0)
+      data = Map(fd, size, advice, &err);
+  }
+
+  // The mapping does not need the file descriptor.
+  uv_fs_close(nullptr, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0) return err;
+
+  if (data == nullptr) {
+    *backing_store =
+        SharedArrayBuffer::NewBackingStore(nullptr, 0, UnmapEmpty, nullptr);
+  } else {
+    *backing_store =
+        SharedArrayBuffer::NewBackingStore(data, size, Unmap, nullptr);
+  }
+  return 0;
+}
+
+}  // namespace fs
+}  // namespace node
@@ -0,0 +1,43 @@
+#ifndef SRC_NODE_FILE_MMAP_H_
+#define SRC_NODE_FILE_MMAP_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+#include <memory>
+
+namespace node {
+namespace fs {
+
+// Hints about how a mapped file is going to be accessed, passed on to
+// posix_madvise(). They are ignored on Windows.
+enum MapFileAdvice {
+  kMapAdviceNormal,
+  kMapAdviceSequential,
+  kMapAdviceRandom,
+  kMapAdviceWillNeed
+};
+
+// Maps the whole regular file at path into memory and wraps the mapping in a
+// backing store for a SharedArrayBuffer, which unmaps it once the last
+// SharedArrayBuffer that uses it is gone, in whichever isolate that happens.
+//
+// The mapping is private and copy-on-write: the pages are shared with the
+// page cache (and therefore with every other thread and process that maps or
+// reads the same file) until they are written to. Writes are never carried
+// through to the file.
+//
+// This does blocking I/O and can be called from any thread. Returns 0 on
+// success, or a libuv error code and the name of the failing syscall.
+int MapFile(const char* path,
+            MapFileAdvice advice,
+            std::unique_ptr<v8::BackingStore>* backing_store,
+            const char** syscall);
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_FILE_MMAP_H_
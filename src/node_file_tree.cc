@@ -0,0 +1,560 @@
+#include "node_file_tree.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_file-inl.h"
+#include "node_mutex.h"
+#include "threadpoolwork-inl.h"
+#include "util-inl.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace node {
+namespace fs {
+
+using v8::FunctionCallbackInfo;
+using v8::Int32;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using v8::Uint32;
+using v8::Value;
+
+namespace {
+
+// The number of files that make up a single work item.
+constexpr size_t kTreeBatchSize = 256;
+
+#if defined(__linux__) && defined(__NR_copy_file_range)
+
+// Copies a regular file with copy_file_range(), which lets the kernel (and
+// file systems that support it, the storage itself) copy the data without
+// passing it through user space. Falls back to read() and write() where
+// copy_file_range() cannot be used, for example across file systems on older
+// kernels. Like uv_fs_copyfile(), this sets the mode of dest to that of src,
+// and removes dest again if the copy fails.
+int CopyFileRange(const char* src, const char* dest, int flags) {
+  const int in = open(src, O_RDONLY | O_CLOEXEC);
+  if (in < 0) return -errno;
+
+  struct stat st;
+  if (fstat(in, &st) != 0) {
+    int err = -errno;
+    close(in);
+    return err;
+  }
+
+  int dest_flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+  dest_flags |= (flags & UV_FS_COPYFILE_EXCL) ? O_EXCL : O_TRUNC;
+  const int out = open(dest, dest_flags, st.st_mode);
+  if (out < 0) {
+    int err = -errno;
+    close(in);
+    return err;
+  }
+
+  int err = 0;
+  if (fchmod(out, st.st_mode) != 0)
+    err = -errno;
+
+  bool use_copy_file_range = true;
+  bool copied_any = false;
+  while (err == 0) {
+    ssize_t bytes;
+    if (use_copy_file_range) {
+      bytes = syscall(__NR_copy_file_range, in, nullptr, out, nullptr,
+                      SSIZE_MAX, 0);
+      if (bytes < 0 && !copied_any &&
+          (errno == ENOSYS || errno == EXDEV || errno == EINVAL ||
+           errno == EOPNOTSUPP || errno == EPERM)) {
+        use_copy_file_range = false;
+        continue;
+      }
+    } else {
+      char buffer[64 * 1024];
+      bytes = read(in, buffer, sizeof(buffer));
+      for (ssize_t written = 0; bytes > 0 && written < bytes;) {
+        ssize_t n = write(out, buffer + written, bytes - written);
+        if (n < 0) {
+          if (errno == EINTR) continue;
+          bytes = n;
+          break;
+        }
+        written += n;
+      }
+    }
+    if (bytes < 0) {
+      if (errno != EINTR) err = -errno;
+      continue;
+    }
+    if (bytes == 0) break;
+    copied_any = true;
+  }
+
+  close(in);
+  if (close(out) != 0 && err == 0)
+    err = -errno;
+  if (err < 0)
+    unlink(dest);
+  return err;
+}
+
+#endif  // defined(__linux__) && defined(__NR_copy_file_range)
+
+int CopyRegularFile(const char* src, const char* dest, int flags) {
+#if defined(__linux__) && defined(__NR_copy_file_range)
+  // uv_fs_copyfile() knows how to create reflinks.
+  if (!(flags & (UV_FS_COPYFILE_FICLONE | UV_FS_COPYFILE_FICLONE_FORCE)))
+    return CopyFileRange(src, dest, flags);
+#endif
+  uv_fs_t req;
+  int err = uv_fs_copyfile(nullptr, &req, src, dest, flags, nullptr);
+  uv_fs_req_cleanup(&req);
+  return err;
+}
+
+int CopySymlink(const char* src, const char* dest, int flags) {
+  uv_fs_t req;
+  int err = uv_fs_readlink(nullptr, &req, src, nullptr);
+  if (err < 0) {
+    uv_fs_req_cleanup(&req);
+    return err;
+  }
+  const std::string target(static_cast<const char*>(req.ptr));
+  uv_fs_req_cleanup(&req);
+
+  err = uv_fs_symlink(nullptr, &req, target.c_str(), dest, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err == UV_EEXIST && !(flags & UV_FS_COPYFILE_EXCL)) {
+    // Replace whatever is there, like copying a file would.
+    err = uv_fs_unlink(nullptr, &req, dest, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0) return err;
+    err = uv_fs_symlink(nullptr, &req, target.c_str(), dest, 0, nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  return err;
+}
+
+int LStatType(const char* path, int* type) {
+  uv_fs_t req;
+  int err = uv_fs_lstat(nullptr, &req, path, nullptr);
+  const uint64_t mode = req.statbuf.st_mode;
+  uv_fs_req_cleanup(&req);
+  if (err < 0) return err;
+  switch (mode & S_IFMT) {
+    case S_IFDIR: *type = UV_DIRENT_DIR; break;
+    case S_IFREG: *type = UV_DIRENT_FILE; break;
+#ifdef S_IFLNK
+    case S_IFLNK: *type = UV_DIRENT_LINK; break;
+#endif
+    default: *type = UV_DIRENT_UNKNOWN; break;
+  }
+  return 0;
+}
+
+class TreeOperation {
+ public:
+  enum Kind { kRemove, kCopy };
+
+  TreeOperation(Environment* env,
+                Kind kind,
+                std::string&& src,
+                std::string&& dest,
+                int copy_flags,
+                size_t concurrency)
+      : env_(env),
+        kind_(kind),
+        src_(std::move(src)),
+        dest_(std::move(dest)),
+        copy_flags_(copy_flags),
+        concurrency_(concurrency) {
+    queue_.emplace_back(Item { Item::kRoot, nullptr, {} });
+  }
+
+  TreeOperation(const TreeOperation&) = delete;
+  TreeOperation& operator=(const TreeOperation&) = delete;
+
+  // Runs the whole operation on the calling thread.
+  void RunSync() {
+    Item item;
+    while (Pop(&item))
+      Process(&item);
+  }
+
+  // Runs the operation on up to concurrency_ threadpool threads at a time,
+  // and settles req_wrap once it is done. Deletes itself afterwards.
+  void Start(FSReqBase* req_wrap) {
+    req_wrap_ = req_wrap;
+    ScheduleWorkers();
+  }
+
+  int error() const { return err_; }
+  const char* syscall() const { return syscall_; }
+  const std::string& error_path() const { return err_path_; }
+  uint64_t count() const { return count_; }
+
+ private:
+  struct Directory {
+    // Relative to the root of the tree.
+    std::string path;
+    std::shared_ptr<Directory> parent;
+    // Work items that still refer to this directory, including the one that
+    // lists it. The directory can be removed once this drops to zero.
+    std::atomic<size_t> pending { 1 };
+  };
+
+  struct Entry {
+    // Relative to the root of the tree.
+    std::string path;
+    int type;
+  };
+
+  struct Item {
+    enum Type { kRoot, kList, kEntries };
+    Type type;
+    std::shared_ptr<Directory> dir;
+    std::vector<Entry> entries;
+  };
+
+  class Worker final : public ThreadPoolWork {
+   public:
+    explicit Worker(TreeOperation* op)
+        : ThreadPoolWork(op->env_), op_(op) {}
+
+    void DoThreadPoolWork() override {
+      if (op_->Pop(&item_))
+        op_->Process(&item_);
+    }
+
+    void AfterThreadPoolWork(int status) override {
+      std::unique_ptr<Worker> self(this);
+      if (status != 0)
+        op_->Fail(status, "scandir", op_->src_);
+      op_->OnWorkerDone();
+    }
+
+   private:
+    TreeOperation* op_;
+    Item item_;
+  };
+
+  std::string Source(const std::string& relative) const {
+    return relative.empty() ? src_ : src_ + kPathSeparator + relative;
+  }
+
+  std::string Dest(const std::string& relative) const {
+    return relative.empty() ? dest_ : dest_ + kPathSeparator + relative;
+  }
+
+  bool Pop(Item* item) {
+    Mutex::ScopedLock lock(mutex_);
+    if (queue_.empty() || err_ != 0) return false;
+    *item = std::move(queue_.back());
+    queue_.pop_back();
+    return true;
+  }
+
+  void Push(Item&& item) {
+    Mutex::ScopedLock lock(mutex_);
+    queue_.emplace_back(std::move(item));
+  }
+
+  bool Failed() {
+    Mutex::ScopedLock lock(mutex_);
+    return err_ != 0;
+  }
+
+  // Records the first error. Work that is already running is finished, but
+  // no new work is started.
+  void Fail(int err, const char* syscall, const std::string& path) {
+    Mutex::ScopedLock lock(mutex_);
+    if (err_ != 0) return;
+    err_ = err;
+    syscall_ = syscall;
+    err_path_ = path;
+    queue_.clear();
+  }
+
+  void Process(Item* item) {
+    switch (item->type) {
+      case Item::kRoot: ProcessRoot(); break;
+      case Item::kList: ListDirectory(item->dir); break;
+      case Item::kEntries: ProcessEntries(item->dir, &item->entries); break;
+    }
+    *item = Item();
+  }
+
+  void ProcessRoot() {
+    int type;
+    int err = LStatType(src_.c_str(), &type);
+    if (kind_ == kRemove) {
+      // The tree is already gone.
+      if (err == UV_ENOENT) return;
+      if (err < 0) return Fail(err, "lstat", src_);
+      if (type != UV_DIRENT_DIR) {
+        std::vector<Entry> entries { Entry { "", type } };
+        return ProcessEntries(nullptr, &entries);
+      }
+    } else {
+      if (err < 0) return Fail(err, "lstat", src_);
+      if (type != UV_DIRENT_DIR) return Fail(UV_ENOTDIR, "scandir", src_);
+    }
+    ListDirectory(std::make_shared<Directory>());
+  }
+
+  void ListDirectory(const std::shared_ptr<Directory>& dir) {
+    const std::string path = Source(dir->path);
+    uv_fs_t req;
+
+    if (kind_ == kCopy) {
+      const std::string dest = Dest(dir->path);
+      int err = uv_fs_mkdir(nullptr, &req, dest.c_str(), 0777, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (err < 0 && err != UV_EEXIST) return Fail(err, "mkdir", dest);
+      count_++;
+    }
+
+    int err = uv_fs_scandir(nullptr, &req, path.c_str(), 0, nullptr);
+    if (err < 0) {
+      uv_fs_req_cleanup(&req);
+      // The directory was removed while the tree was walked.
+      if (err == UV_ENOENT && !dir->path.empty()) return Release(dir);
+      return Fail(err, "scandir", path);
+    }
+
+    std::vector<Entry> entries;
+    uv_dirent_t ent;
+    while (uv_fs_scandir_next(&req, &ent) != UV_EOF) {
+      Entry entry {
+        dir->path.empty() ? ent.name : dir->path + kPathSeparator + ent.name,
+        ent.type
+      };
+      if (entry.type == UV_DIRENT_UNKNOWN) {
+        const std::string entry_path = Source(entry.path);
+        err = LStatType(entry_path.c_str(), &entry.type);
+        if (err == UV_ENOENT) continue;
+        if (err < 0) {
+          uv_fs_req_cleanup(&req);
+          return Fail(err, "lstat", entry_path);
+        }
+      }
+
+      if (entry.type == UV_DIRENT_DIR) {
+        auto child = std::make_shared<Directory>();
+        child->path = std::move(entry.path);
+        child->parent = dir;
+        dir->pending++;
+        Push(Item { Item::kList, std::move(child), {} });
+        continue;
+      }
+
+      entries.emplace_back(std::move(entry));
+      if (entries.size() == kTreeBatchSize) {
+        dir->pending++;
+        Push(Item { Item::kEntries, dir, std::move(entries) });
+        entries = std::vector<Entry>();
+      }
+    }
+    uv_fs_req_cleanup(&req);
+
+    // Deal with what is left here, rather than in another work item.
+    ProcessEntries(dir, &entries);
+  }
+
+  void ProcessEntries(const std::shared_ptr<Directory>& dir,
+                      std::vector<Entry>* entries) {
+    for (const Entry& entry : *entries) {
+      if (Failed()) return;
+      const std::string src = Source(entry.path);
+      uv_fs_t req;
+      int err;
+      const char* syscall;
+      if (kind_ == kRemove) {
+        syscall = "unlink";
+        err = uv_fs_unlink(nullptr, &req, src.c_str(), nullptr);
+        uv_fs_req_cleanup(&req);
+        if (err == UV_ENOENT) err = 0;
+      } else {
+        const std::string dest = Dest(entry.path);
+        if (entry.type == UV_DIRENT_FILE) {
+          syscall = "copyfile";
+          err = CopyRegularFile(src.c_str(), dest.c_str(), copy_flags_);
+        } else if (entry.type == UV_DIRENT_LINK) {
+          syscall = "symlink";
+          err = CopySymlink(src.c_str(), dest.c_str(), copy_flags_);
+        } else {
+          // Sockets, FIFOs and devices are not copied.
+          syscall = "copyfile";
+          err = UV_ENOTSUP;
+        }
+        if (err == UV_ENOENT) {
+          // The file was removed while the tree was walked.
+          if (uv_fs_access(nullptr, &req, src.c_str(), F_OK, nullptr) ==
+                  UV_ENOENT) {
+            err = 0;
+          }
+          uv_fs_req_cleanup(&req);
+        }
+      }
+      if (err < 0) return Fail(err, syscall, src);
+      count_++;
+    }
+    if (dir) Release(dir);
+  }
+
+  // Drops a reference to dir. Once a directory has been dealt with
+  // completely, it is removed, which may in turn complete its parent.
+  void Release(std::shared_ptr<Directory> dir) {
+    while (dir && --dir->pending == 0) {
+      if (kind_ == kRemove && !Failed()) {
+        const std::string path = Source(dir->path);
+        uv_fs_t req;
+        int err = uv_fs_rmdir(nullptr, &req, path.c_str(), nullptr);
+        uv_fs_req_cleanup(&req);
+        if (err < 0 && err != UV_ENOENT) return Fail(err, "rmdir", path);
+        count_++;
+      }
+      dir = dir->parent;
+    }
+  }
+
+  void ScheduleWorkers() {
+    size_t queued;
+    {
+      Mutex::ScopedLock lock(mutex_);
+      queued = queue_.size();
+    }
+    while (active_ < concurrency_ && queued > 0) {
+      active_++;
+      queued--;
+      Worker* worker = new Worker(this);
+      worker->ScheduleWork();
+    }
+    if (active_ == 0) Finish();
+  }
+
+  void OnWorkerDone() {
+    CHECK_GT(active_, 0);
+    active_--;
+    ScheduleWorkers();
+  }
+
+  void Finish() {
+    std::unique_ptr<TreeOperation> self(this);
+    InitJobRequest(req_wrap_, err_, syscall_, err_ != 0 ? err_path_.c_str()
+                                                        : nullptr);
+    FSReqAfterScope after(req_wrap_, req_wrap_->req());
+    if (!after.Proceed()) return;
+    req_wrap_->Resolve(Number::New(env_->isolate(),
+                                   static_cast<double>(count_)));
+  }
+
+  Environment* const env_;
+  const Kind kind_;
+  const std::string src_;
+  const std::string dest_;
+  const int copy_flags_;
+  const size_t concurrency_;
+  FSReqBase* req_wrap_ = nullptr;
+  // Workers that are scheduled or running. Only used on the main thread.
+  size_t active_ = 0;
+  std::atomic<uint64_t> count_ { 0 };
+
+  Mutex mutex_;
+  // Used as a stack, so that the tree is walked depth first and the queue
+  // stays small.
+  std::vector<Item> queue_;
+  int err_ = 0;
+  const char* syscall_ = "scandir";
+  std::string err_path_;
+};
+
+void RunTreeOperation(const FunctionCallbackInfo<Value>& args,
+                      TreeOperation::Kind kind,
+                      std::string&& src,
+                      std::string&& dest,
+                      int copy_flags,
+                      int argn) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[argn]->IsUint32());
+  const size_t concurrency = args[argn].As<Uint32>()->Value();
+  CHECK_GT(concurrency, 0);
+
+  auto op = std::make_unique<TreeOperation>(
+      env, kind, std::move(src), std::move(dest), copy_flags, concurrency);
+
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[argn + 1]);
+  if (req_wrap_async != nullptr) {
+    req_wrap_async->Init(kind == TreeOperation::kRemove ? "rmtree"
+                                                        : "copytree",
+                         nullptr, 0, UTF8);
+    op.release()->Start(req_wrap_async);
+    req_wrap_async->SetReturnValue(args);
+    return;
+  }
+
+  CHECK_EQ(args.Length(), argn + 3);
+  env->PrintSyncTrace();
+  op->RunSync();
+  if (op->error() != 0) {
+    Local<Object> ctx = args[argn + 2].As<Object>();
+    ctx->Set(env->context(), env->errno_string(),
+             Integer::New(isolate, op->error())).Check();
+    ctx->Set(env->context(), env->syscall_string(),
+             OneByteString(isolate, op->syscall())).Check();
+    ctx->Set(env->context(), env->path_string(),
+             String::NewFromUtf8(isolate, op->error_path().c_str())
+                 .ToLocalChecked()).Check();
+    return;
+  }
+  args.GetReturnValue().Set(static_cast<double>(op->count()));
+}
+
+}  // anonymous namespace
+
+void RmTree(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_GE(args.Length(), 3);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  RunTreeOperation(args, TreeOperation::kRemove,
+                   std::string(*path, path.length()), std::string(), 0, 1);
+}
+
+void CopyTree(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK_GE(args.Length(), 5);
+
+  BufferValue src(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*src);
+  BufferValue dest(env->isolate(), args[1]);
+  CHECK_NOT_NULL(*dest);
+  CHECK(args[2]->IsInt32());
+  const int flags = args[2].As<Int32>()->Value();
+
+  RunTreeOperation(args, TreeOperation::kCopy,
+                   std::string(*src, src.length()),
+                   std::string(*dest, dest.length()), flags, 3);
+}
+
+}  // namespace fs
+}  // namespace node
@@ -0,0 +1,31 @@
+#ifndef SRC_NODE_FILE_TREE_H_
+#define SRC_NODE_FILE_TREE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "v8.h"
+
+namespace node {
+namespace fs {
+
+// Recursive removal and copying of directory trees, for fs.rmdir() with
+// { recursive: true } and fs.copyTree(). The tree is split into work items of
+// one directory listing or up to a few hundred files each, and the items are
+// spread over a bounded number of threadpool threads.
+
+// rmTree(path, concurrency, req)
+// rmTree(path, concurrency, undefined, ctx)
+// Resolves with the number of files and directories that were removed.
+void RmTree(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+// copyTree(src, dest, flags, concurrency, req)
+// copyTree(src, dest, flags, concurrency, undefined, ctx)
+// Resolves with the number of files and directories that were copied.
+void CopyTree(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_FILE_TREE_H_
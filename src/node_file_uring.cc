@@ -0,0 +1,545 @@
+#include "node_file_uring.h"
+
+#ifdef __linux__
+
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "req_wrap-inl.h"
+#include "util-inl.h"
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <vector>
+
+// The kernel headers on build machines are often older than io_uring.
+#ifndef __NR_io_uring_setup
+# if defined(__alpha__)
+#  define __NR_io_uring_setup 535
+#  define __NR_io_uring_enter 536
+#  define __NR_io_uring_register 537
+# else
+#  define __NR_io_uring_setup 425
+#  define __NR_io_uring_enter 426
+#  define __NR_io_uring_register 427
+# endif
+#endif
+
+namespace node {
+namespace fs {
+
+// The io_uring ABI, as declared by <linux/io_uring.h>.
+struct IoUringSqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  // rw_flags, fsync_flags, open_flags or statx_flags, depending on opcode.
+  uint32_t op_flags;
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct IoUringCqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+static_assert(sizeof(IoUringSqe) == 64, "io_uring_sqe has a fixed size");
+static_assert(sizeof(IoUringCqe) == 16, "io_uring_cqe has a fixed size");
+
+namespace {
+
+struct SqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct CqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint32_t flags;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct Params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t wq_fd;
+  uint32_t resv[3];
+  SqringOffsets sq_off;
+  CqringOffsets cq_off;
+};
+
+static_assert(sizeof(Params) == 120, "io_uring_params has a fixed size");
+
+struct ProbeOp {
+  uint8_t op;
+  uint8_t resv;
+  uint16_t flags;
+  uint32_t resv2;
+};
+
+struct Probe {
+  uint8_t last_op;
+  uint8_t ops_len;
+  uint16_t resv;
+  uint32_t resv2[3];
+  ProbeOp ops[256];
+};
+
+enum Opcode : uint8_t {
+  kOpReadv = 1,
+  kOpWritev = 2,
+  kOpFsync = 3,
+  kOpOpenat = 18,
+  kOpClose = 19,
+  kOpStatx = 21,
+};
+
+constexpr uint8_t kRequiredOps[] = {
+  kOpReadv, kOpWritev, kOpFsync, kOpOpenat, kOpClose, kOpStatx
+};
+
+constexpr uint32_t kFeatSingleMmap = 1 << 0;
+constexpr uint32_t kFeatNoDrop = 1 << 1;
+constexpr uint32_t kFeatRwCurPos = 1 << 3;
+constexpr uint64_t kOffSqRing = 0;
+constexpr uint64_t kOffSqes = 0x10000000;
+constexpr unsigned kRegisterEventfd = 4;
+constexpr unsigned kRegisterProbe = 8;
+constexpr uint16_t kProbeOpSupported = 1 << 0;
+constexpr uint32_t kFsyncDatasync = 1 << 0;
+constexpr uint32_t kAtEmptyPath = 0x1000;
+
+constexpr unsigned kEntries = 128;
+
+static_assert(sizeof(uv_buf_t) == sizeof(struct iovec),
+              "uv_buf_t can be passed as struct iovec");
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // anonymous namespace
+
+void StatxToUvStat(const Statx& statx, uv_stat_t* buf) {
+  buf->st_dev = 256 * statx.stx_dev_major + statx.stx_dev_minor;
+  buf->st_mode = statx.stx_mode;
+  buf->st_nlink = statx.stx_nlink;
+  buf->st_uid = statx.stx_uid;
+  buf->st_gid = statx.stx_gid;
+  buf->st_rdev = statx.stx_rdev_major;
+  buf->st_ino = statx.stx_ino;
+  buf->st_size = statx.stx_size;
+  buf->st_blksize = statx.stx_blksize;
+  buf->st_blocks = statx.stx_blocks;
+  buf->st_atim.tv_sec = statx.stx_atime.tv_sec;
+  buf->st_atim.tv_nsec = statx.stx_atime.tv_nsec;
+  buf->st_mtim.tv_sec = statx.stx_mtime.tv_sec;
+  buf->st_mtim.tv_nsec = statx.stx_mtime.tv_nsec;
+  buf->st_ctim.tv_sec = statx.stx_ctime.tv_sec;
+  buf->st_ctim.tv_nsec = statx.stx_ctime.tv_nsec;
+  buf->st_birthtim.tv_sec = statx.stx_btime.tv_sec;
+  buf->st_birthtim.tv_nsec = statx.stx_btime.tv_nsec;
+  buf->st_flags = 0;
+  buf->st_gen = 0;
+}
+
+struct IoUring::Op {
+  FSReqBase* req_wrap;
+  uv_fs_type fs_type;
+  uv_fs_cb cb;
+  IoUringSqe sqe;
+  // Copies of the arguments that have to outlive the submission.
+  std::string path;
+  std::vector<uv_buf_t> bufs;
+  Statx statx;
+  // Writes are continued after a short write, the way libuv does it.
+  size_t buf_index = 0;
+  ssize_t total = 0;
+};
+
+IoUring* IoUring::Get(Environment* env) {
+  if (!env->fs_io_uring_enabled) return nullptr;
+  if (env->fs_io_uring == nullptr && !env->fs_io_uring_unavailable) {
+    env->fs_io_uring = Create(env);
+    env->fs_io_uring_unavailable = env->fs_io_uring == nullptr;
+  }
+  return env->fs_io_uring;
+}
+
+IoUring* IoUring::Create(Environment* env) {
+  Params params;
+  memset(&params, 0, sizeof(params));
+  int ring_fd = syscall(__NR_io_uring_setup, kEntries, &params);
+  if (ring_fd < 0) {
+    Debug(env, DebugCategory::FS,
+          "[io_uring] setup failed: %s\n", uv_err_name(-errno));
+    return nullptr;
+  }
+
+  // Everything that is used here (the probe in particular) needs Linux 5.6.
+  Probe probe;
+  memset(&probe, 0, sizeof(probe));
+  bool supported =
+      (params.features & kFeatSingleMmap) != 0 &&
+      (params.features & kFeatNoDrop) != 0 &&
+      syscall(__NR_io_uring_register, ring_fd, kRegisterProbe,
+              &probe, arraysize(probe.ops)) == 0;
+  for (uint8_t op : kRequiredOps) {
+    supported = supported && op <= probe.last_op &&
+                (probe.ops[op].flags & kProbeOpSupported) != 0;
+  }
+  if (!supported) {
+    Debug(env, DebugCategory::FS, "[io_uring] kernel is too old\n");
+    close(ring_fd);
+    return nullptr;
+  }
+
+  int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd < 0 ||
+      syscall(__NR_io_uring_register, ring_fd, kRegisterEventfd,
+              &event_fd, 1) != 0) {
+    Debug(env, DebugCategory::FS,
+          "[io_uring] cannot register eventfd: %s\n", uv_err_name(-errno));
+    if (event_fd >= 0) close(event_fd);
+    close(ring_fd);
+    return nullptr;
+  }
+
+  IoUring* ring = new IoUring(env, ring_fd, event_fd);
+  ring->features_ = params.features;
+  ring->ring_size_ =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+               params.cq_off.cqes + params.cq_entries * sizeof(IoUringCqe));
+  ring->sqes_size_ = params.sq_entries * sizeof(IoUringSqe);
+  void* ring_mem = mmap(nullptr, ring->ring_size_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd, kOffSqRing);
+  void* sqes_mem = mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd, kOffSqes);
+  if (ring_mem != MAP_FAILED) ring->ring_ = ring_mem;
+  if (sqes_mem != MAP_FAILED) ring->sqes_ = static_cast<IoUringSqe*>(sqes_mem);
+  if (ring->ring_ == nullptr || ring->sqes_ == nullptr) {
+    Debug(env, DebugCategory::FS, "[io_uring] cannot map the rings\n");
+    delete ring;
+    return nullptr;
+  }
+
+  ring->sq_head_ = RingField<uint32_t>(ring_mem, params.sq_off.head);
+  ring->sq_tail_ = RingField<uint32_t>(ring_mem, params.sq_off.tail);
+  ring->sq_array_ = RingField<uint32_t>(ring_mem, params.sq_off.array);
+  ring->sq_mask_ = *RingField<uint32_t>(ring_mem, params.sq_off.ring_mask);
+  ring->sq_entries_ = params.sq_entries;
+  ring->cq_head_ = RingField<uint32_t>(ring_mem, params.cq_off.head);
+  ring->cq_tail_ = RingField<uint32_t>(ring_mem, params.cq_off.tail);
+  ring->cqes_ = RingField<IoUringCqe>(ring_mem, params.cq_off.cqes);
+  ring->cq_mask_ = *RingField<uint32_t>(ring_mem, params.cq_off.ring_mask);
+  ring->cq_entries_ = params.cq_entries;
+
+  CHECK_EQ(0, uv_prepare_init(env->event_loop(), &ring->prepare_));
+  uv_unref(reinterpret_cast<uv_handle_t*>(&ring->prepare_));
+  CHECK_EQ(0, uv_poll_init(env->event_loop(), &ring->poll_, event_fd));
+  env->AddCleanupHook(CleanupHook, ring);
+
+  Debug(env, DebugCategory::FS,
+        "[io_uring] using %d submission entries\n", params.sq_entries);
+  return ring;
+}
+
+IoUring::IoUring(Environment* env, int ring_fd, int event_fd)
+    : env_(env), ring_fd_(ring_fd), event_fd_(event_fd) {}
+
+IoUring::~IoUring() {
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (ring_ != nullptr) munmap(ring_, ring_size_);
+  close(event_fd_);
+  close(ring_fd_);
+}
+
+void IoUring::CleanupHook(void* arg) {
+  IoUring* ring = static_cast<IoUring*>(arg);
+  Environment* env = ring->env_;
+  // CleanupHandles() has already waited for our requests, since they count
+  // as waiting requests.
+  CHECK_EQ(ring->in_flight_, 0);
+  env->fs_io_uring = nullptr;
+  env->fs_io_uring_enabled = false;
+
+  env->CloseHandle(&ring->prepare_, [](uv_prepare_t* handle) {
+    IoUring* ring = ContainerOf(&IoUring::prepare_, handle);
+    if (++ring->closed_handles_ == 2) delete ring;
+  });
+  env->CloseHandle(&ring->poll_, [](uv_poll_t* handle) {
+    IoUring* ring = ContainerOf(&IoUring::poll_, handle);
+    if (++ring->closed_handles_ == 2) delete ring;
+  });
+}
+
+std::unique_ptr<IoUring::Op> IoUring::NewOp(FSReqBase* req_wrap,
+                                            uv_fs_type fs_type,
+                                            uv_fs_cb cb) {
+  std::unique_ptr<Op> op(new Op());
+  op->req_wrap = req_wrap;
+  op->fs_type = fs_type;
+  op->cb = cb;
+  memset(&op->sqe, 0, sizeof(op->sqe));
+  return op;
+}
+
+bool IoUring::Read(FSReqBase* req_wrap, uv_file fd, const uv_buf_t* bufs,
+                   unsigned int nbufs, int64_t pos, uv_fs_cb cb) {
+  return ReadWrite(req_wrap, kOpReadv, UV_FS_READ,
+                   fd, bufs, nbufs, pos, cb);
+}
+
+bool IoUring::Write(FSReqBase* req_wrap, uv_file fd, const uv_buf_t* bufs,
+                    unsigned int nbufs, int64_t pos, uv_fs_cb cb) {
+  return ReadWrite(req_wrap, kOpWritev, UV_FS_WRITE,
+                   fd, bufs, nbufs, pos, cb);
+}
+
+bool IoUring::ReadWrite(FSReqBase* req_wrap, uint8_t opcode,
+                        uv_fs_type fs_type, uv_file fd, const uv_buf_t* bufs,
+                        unsigned int nbufs, int64_t pos, uv_fs_cb cb) {
+  // Using the current file position needs Linux 5.6.
+  if (pos < 0 && (features_ & kFeatRwCurPos) == 0) return false;
+
+  std::unique_ptr<Op> op = NewOp(req_wrap, fs_type, cb);
+  // Like libuv, a single read fills no more than IOV_MAX buffers.
+  if (opcode == kOpReadv) nbufs = std::min<unsigned int>(nbufs, IOV_MAX);
+  op->bufs.assign(bufs, bufs + nbufs);
+  op->sqe.opcode = opcode;
+  op->sqe.fd = fd;
+  op->sqe.off = pos < 0 ? static_cast<uint64_t>(-1) : pos;
+  return Submit(std::move(op));
+}
+
+bool IoUring::Open(FSReqBase* req_wrap, const char* path, int flags,
+                   int mode, uv_fs_cb cb) {
+  std::unique_ptr<Op> op = NewOp(req_wrap, UV_FS_OPEN, cb);
+  op->path = path;
+  op->sqe.opcode = kOpOpenat;
+  op->sqe.fd = AT_FDCWD;
+  op->sqe.addr = reinterpret_cast<uintptr_t>(op->path.c_str());
+  op->sqe.len = mode;
+  op->sqe.op_flags = flags | O_CLOEXEC;
+  return Submit(std::move(op));
+}
+
+bool IoUring::Close(FSReqBase* req_wrap, uv_file fd, uv_fs_cb cb) {
+  std::unique_ptr<Op> op = NewOp(req_wrap, UV_FS_CLOSE, cb);
+  op->sqe.opcode = kOpClose;
+  op->sqe.fd = fd;
+  return Submit(std::move(op));
+}
+
+bool IoUring::Stat(FSReqBase* req_wrap, const char* path, bool lstat,
+                   uv_fs_cb cb) {
+  std::unique_ptr<Op> op = NewOp(req_wrap, lstat ? UV_FS_LSTAT : UV_FS_STAT,
+                                 cb);
+  op->path = path;
+  op->sqe.opcode = kOpStatx;
+  op->sqe.fd = AT_FDCWD;
+  op->sqe.addr = reinterpret_cast<uintptr_t>(op->path.c_str());
+  op->sqe.len = kStatxBasicStatsAndBtime;
+  op->sqe.off = reinterpret_cast<uintptr_t>(&op->statx);
+  op->sqe.op_flags = lstat ? AT_SYMLINK_NOFOLLOW : 0;
+  return Submit(std::move(op));
+}
+
+bool IoUring::FStat(FSReqBase* req_wrap, uv_file fd, uv_fs_cb cb) {
+  std::unique_ptr<Op> op = NewOp(req_wrap, UV_FS_FSTAT, cb);
+  op->sqe.opcode = kOpStatx;
+  op->sqe.fd = fd;
+  op->sqe.addr = reinterpret_cast<uintptr_t>("");
+  op->sqe.len = kStatxBasicStatsAndBtime;
+  op->sqe.off = reinterpret_cast<uintptr_t>(&op->statx);
+  op->sqe.op_flags = kAtEmptyPath;
+  return Submit(std::move(op));
+}
+
+bool IoUring::Fsync(FSReqBase* req_wrap, uv_file fd, bool datasync,
+                    uv_fs_cb cb) {
+  std::unique_ptr<Op> op =
+      NewOp(req_wrap, datasync ? UV_FS_FDATASYNC : UV_FS_FSYNC, cb);
+  op->sqe.opcode = kOpFsync;
+  op->sqe.fd = fd;
+  op->sqe.op_flags = datasync ? kFsyncDatasync : 0;
+  return Submit(std::move(op));
+}
+
+bool IoUring::Submit(std::unique_ptr<Op> op) {
+  // Never have more completions pending than the completion ring can hold.
+  if (in_flight_ >= cq_entries_ || !QueueSqe(op.get()))
+    return false;
+
+  op->req_wrap->StartLatencyTracking();
+  env_->IncreaseWaitingRequestCounter();
+  if (in_flight_++ == 0)
+    CHECK_EQ(0, uv_poll_start(&poll_, UV_READABLE, OnPoll));
+  op.release();
+  return true;
+}
+
+bool IoUring::QueueSqe(Op* op) {
+  uint32_t tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    Flush();
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+      return false;
+  }
+
+  if (op->sqe.opcode == kOpReadv || op->sqe.opcode == kOpWritev) {
+    size_t nbufs = std::min<size_t>(op->bufs.size() - op->buf_index, IOV_MAX);
+    op->sqe.addr = reinterpret_cast<uintptr_t>(op->bufs.data() + op->buf_index);
+    op->sqe.len = nbufs;
+  }
+
+  uint32_t index = tail & sq_mask_;
+  sqes_[index] = op->sqe;
+  sqes_[index].user_data = reinterpret_cast<uintptr_t>(op);
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  // The kernel is entered once per loop iteration, for everything that was
+  // queued during the iteration.
+  if (unsubmitted_++ == 0)
+    CHECK_EQ(0, uv_prepare_start(&prepare_, OnPrepare));
+  return true;
+}
+
+void IoUring::Flush() {
+  while (unsubmitted_ > 0) {
+    int ret = syscall(__NR_io_uring_enter, ring_fd_, unsubmitted_, 0, 0,
+                      nullptr, 0);
+    if (ret < 0 && errno == EINTR) continue;
+    // On EAGAIN or EBUSY, the kernel is short on resources; try again in the
+    // next iteration, after completions have been reaped.
+    if (ret <= 0) return;
+    unsubmitted_ -= ret;
+  }
+  uv_prepare_stop(&prepare_);
+}
+
+void IoUring::OnPrepare(uv_prepare_t* handle) {
+  IoUring* ring = ContainerOf(&IoUring::prepare_, handle);
+  ring->Flush();
+}
+
+void IoUring::OnPoll(uv_poll_t* handle, int status, int events) {
+  IoUring* ring = ContainerOf(&IoUring::poll_, handle);
+  // Only reset the eventfd; the completion ring says what has finished.
+  uint64_t count;
+  while (read(ring->event_fd_, &count, sizeof(count)) < 0 && errno == EINTR) {}
+  ring->Reap();
+}
+
+void IoUring::Reap() {
+  for (;;) {
+    uint32_t head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) break;
+    IoUringCqe cqe = cqes_[head & cq_mask_];
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    Complete(reinterpret_cast<Op*>(cqe.user_data), cqe.res);
+  }
+  if (in_flight_ == 0)
+    uv_poll_stop(&poll_);
+}
+
+void IoUring::Complete(Op* op, int result) {
+  // Do what libuv does on the threadpool: retry on EINTR (except for close),
+  // and write until everything is written or an error occurs.
+  if (result == -EINTR && op->sqe.opcode != kOpClose && QueueSqe(op))
+    return;
+  if (op->sqe.opcode == kOpWritev) {
+    if (result > 0) {
+      op->total += result;
+      size_t written = result;
+      while (op->buf_index < op->bufs.size() &&
+             written >= op->bufs[op->buf_index].len) {
+        written -= op->bufs[op->buf_index++].len;
+      }
+      if (written > 0) {
+        op->bufs[op->buf_index].base += written;
+        op->bufs[op->buf_index].len -= written;
+      }
+      if (static_cast<int64_t>(op->sqe.off) >= 0) op->sqe.off += result;
+      if (op->buf_index < op->bufs.size() && QueueSqe(op)) return;
+    }
+    if (op->total > 0) result = op->total;
+  }
+
+  std::unique_ptr<Op> done(op);
+  in_flight_--;
+
+  // Set up the request the way uv_fs_*() and the threadpool would have.
+  // The callback is left unset, so that uv_fs_req_cleanup() does not free
+  // the path, which is owned by the Op.
+  uv_fs_t* req = op->req_wrap->req();
+  req->type = UV_FS;
+  req->fs_type = op->fs_type;
+  req->loop = env_->event_loop();
+  req->cb = nullptr;
+  req->result = result;
+  req->path = op->path.empty() ? nullptr : op->path.c_str();
+  req->new_path = nullptr;
+  req->bufs = nullptr;
+  req->nbufs = 0;
+  req->ptr = nullptr;
+  if (op->sqe.opcode == kOpStatx && result == 0) {
+    StatxToUvStat(op->statx, &req->statbuf);
+    req->ptr = &req->statbuf;
+  }
+
+  env_->DecreaseWaitingRequestCounter();
+  op->req_wrap->RecordLatency();
+  op->cb(req);
+}
+
+}  // namespace fs
+}  // namespace node
+
+#else  // !__linux__
+
+namespace node {
+namespace fs {
+
+IoUring* IoUring::Get(Environment* env) {
+  return nullptr;
+}
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // __linux__
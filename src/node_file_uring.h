@@ -0,0 +1,244 @@
+#ifndef SRC_NODE_FILE_URING_H_
+#define SRC_NODE_FILE_URING_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "uv.h"
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace node {
+
+class Environment;
+
+namespace fs {
+
+class FSReqBase;
+struct IoUringSqe;
+struct IoUringCqe;
+
+#ifdef __linux__
+
+// struct statx, as declared by <linux/stat.h>. It has the same layout as
+// libuv's struct uv__statx.
+struct StatxTimestamp {
+  int64_t tv_sec;
+  uint32_t tv_nsec;
+  int32_t unused0;
+};
+
+struct Statx {
+  uint32_t stx_mask;
+  uint32_t stx_blksize;
+  uint64_t stx_attributes;
+  uint32_t stx_nlink;
+  uint32_t stx_uid;
+  uint32_t stx_gid;
+  uint16_t stx_mode;
+  uint16_t unused0;
+  uint64_t stx_ino;
+  uint64_t stx_size;
+  uint64_t stx_blocks;
+  uint64_t stx_attributes_mask;
+  StatxTimestamp stx_atime;
+  StatxTimestamp stx_btime;
+  StatxTimestamp stx_ctime;
+  StatxTimestamp stx_mtime;
+  uint32_t stx_rdev_major;
+  uint32_t stx_rdev_minor;
+  uint32_t stx_dev_major;
+  uint32_t stx_dev_minor;
+  uint64_t unused1[14];
+};
+
+static_assert(sizeof(Statx) == 256, "struct statx has a fixed size");
+
+// STATX_BASIC_STATS | STATX_BTIME, the fields that libuv asks for.
+constexpr uint32_t kStatxBasicStatsAndBtime = 0xFFF;
+
+// Does the same conversion as libuv's uv__fs_statx(), so that the results
+// cannot be told apart from those of uv_fs_stat().
+void StatxToUvStat(const Statx& statx, uv_stat_t* buf);
+
+#endif  // __linux__
+
+// Runs asynchronous fs requests through io_uring instead of the libuv
+// threadpool (--experimental-fs-io-uring, Linux 5.6 or later). Requests are
+// queued in the submission ring as they are made and are submitted together
+// once per event loop iteration. Completions are signalled through an eventfd
+// and end up in the same callbacks as requests that ran on the threadpool,
+// with the uv_fs_t filled in the way libuv would have done it.
+//
+// Only the operations below are covered. Every other operation, and every
+// request that does not fit into the rings, goes to the threadpool.
+class IoUring {
+ public:
+  // Returns nullptr if io_uring is disabled for env or not supported by the
+  // kernel. The ring is created on first use and deletes itself when env is
+  // cleaned up.
+  static IoUring* Get(Environment* env);
+
+  // Each of these returns false if the request was not submitted, in which
+  // case it has to be dispatched to the threadpool.
+  bool Read(FSReqBase* req_wrap, uv_file fd, const uv_buf_t* bufs,
+            unsigned int nbufs, int64_t pos, uv_fs_cb cb);
+  bool Write(FSReqBase* req_wrap, uv_file fd, const uv_buf_t* bufs,
+             unsigned int nbufs, int64_t pos, uv_fs_cb cb);
+  bool Open(FSReqBase* req_wrap, const char* path, int flags, int mode,
+            uv_fs_cb cb);
+  bool Close(FSReqBase* req_wrap, uv_file fd, uv_fs_cb cb);
+  bool Stat(FSReqBase* req_wrap, const char* path, bool lstat, uv_fs_cb cb);
+  bool FStat(FSReqBase* req_wrap, uv_file fd, uv_fs_cb cb);
+  bool Fsync(FSReqBase* req_wrap, uv_file fd, bool datasync, uv_fs_cb cb);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+ private:
+  struct Op;
+
+  IoUring(Environment* env, int ring_fd, int event_fd);
+  ~IoUring();
+
+  static IoUring* Create(Environment* env);
+  bool ReadWrite(FSReqBase* req_wrap, uint8_t opcode, uv_fs_type fs_type,
+                 uv_file fd, const uv_buf_t* bufs, unsigned int nbufs,
+                 int64_t pos, uv_fs_cb cb);
+  std::unique_ptr<Op> NewOp(FSReqBase* req_wrap,
+                            uv_fs_type fs_type,
+                            uv_fs_cb cb);
+  bool Submit(std::unique_ptr<Op> op);
+  bool QueueSqe(Op* op);
+  void Flush();
+  void Reap();
+  void Complete(Op* op, int result);
+
+  static void OnPrepare(uv_prepare_t* handle);
+  static void OnPoll(uv_poll_t* handle, int status, int events);
+  static void CleanupHook(void* arg);
+
+  Environment* env_;
+  int ring_fd_;
+  int event_fd_;
+  uint32_t features_ = 0;
+
+  void* ring_ = nullptr;
+  size_t ring_size_ = 0;
+  IoUringSqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  IoUringCqe* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  uint32_t cq_entries_ = 0;
+
+  // SQEs that were queued but not yet passed to the kernel.
+  uint32_t unsubmitted_ = 0;
+  // Requests that were submitted and whose callback has not run yet.
+  uint32_t in_flight_ = 0;
+
+  uv_prepare_t prepare_;
+  uv_poll_t poll_;
+  int closed_handles_ = 0;
+};
+
+#ifdef __linux__
+
+// Maps a libuv fs function to the IoUring method that does the same, based on
+// the function's type. Functions that share a type are told apart by address.
+template <typename Func>
+struct IoUringDispatch {
+  template <typename... Args>
+  static bool Submit(IoUring* ring, FSReqBase* req_wrap, Func fn,
+                     Args... args) {
+    return false;
+  }
+};
+
+template <>
+struct IoUringDispatch<decltype(&uv_fs_read)> {
+  static_assert(std::is_same<decltype(&uv_fs_read),
+                             decltype(&uv_fs_write)>::value,
+                "uv_fs_read and uv_fs_write have the same type");
+  static bool Submit(IoUring* ring, FSReqBase* req_wrap,
+                     decltype(&uv_fs_read) fn, uv_file fd,
+                     const uv_buf_t* bufs, unsigned int nbufs, int64_t pos,
+                     uv_fs_cb cb) {
+    if (fn == uv_fs_read)
+      return ring->Read(req_wrap, fd, bufs, nbufs, pos, cb);
+    if (fn == uv_fs_write)
+      return ring->Write(req_wrap, fd, bufs, nbufs, pos, cb);
+    return false;
+  }
+};
+
+template <>
+struct IoUringDispatch<decltype(&uv_fs_open)> {
+  static bool Submit(IoUring* ring, FSReqBase* req_wrap,
+                     decltype(&uv_fs_open) fn, const char* path, int flags,
+                     int mode, uv_fs_cb cb) {
+    if (fn == uv_fs_open)
+      return ring->Open(req_wrap, path, flags, mode, cb);
+    return false;
+  }
+};
+
+template <>
+struct IoUringDispatch<decltype(&uv_fs_stat)> {
+  static bool Submit(IoUring* ring, FSReqBase* req_wrap,
+                     decltype(&uv_fs_stat) fn, const char* path,
+                     uv_fs_cb cb) {
+    if (fn == uv_fs_stat)
+      return ring->Stat(req_wrap, path, false, cb);
+    if (fn == uv_fs_lstat)
+      return ring->Stat(req_wrap, path, true, cb);
+    return false;
+  }
+};
+
+template <>
+struct IoUringDispatch<decltype(&uv_fs_fstat)> {
+  static bool Submit(IoUring* ring, FSReqBase* req_wrap,
+                     decltype(&uv_fs_fstat) fn, uv_file fd, uv_fs_cb cb) {
+    if (fn == uv_fs_fstat)
+      return ring->FStat(req_wrap, fd, cb);
+    if (fn == uv_fs_close)
+      return ring->Close(req_wrap, fd, cb);
+    if (fn == uv_fs_fsync)
+      return ring->Fsync(req_wrap, fd, false, cb);
+    if (fn == uv_fs_fdatasync)
+      return ring->Fsync(req_wrap, fd, true, cb);
+    return false;
+  }
+};
+
+#endif  // __linux__
+
+// Submits the request through io_uring if that is enabled and supports it.
+// Returns false if it still has to be dispatched to the threadpool.
+template <typename Func, typename... Args>
+bool DispatchToIoUring(Environment* env, FSReqBase* req_wrap,
+                       Func fn, Args... args) {
+#ifdef __linux__
+  IoUring* ring = IoUring::Get(env);
+  return ring != nullptr &&
+         IoUringDispatch<Func>::Submit(ring, req_wrap, fn, args...);
+#else
+  return false;
+#endif
+}
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_FILE_URING_H_
@@ -234,6 +234,9 @@ class InternalCallbackScope {
   Environment* env_;
   async_context async_context_;
   v8::Local<v8::Object> object_;
+  // Only set while async context frames are in use.
+  v8::Local<v8::Value> context_frame_;
+  v8::Local<v8::Value> outer_context_frame_;
   bool skip_hooks_;
   bool skip_task_queues_;
   bool failed_ = false;
@@ -339,6 +342,7 @@ typedef struct tm TIME_TYPE;
 #endif
 
 double GetCurrentTimeInMicroseconds();
+int ReadFileSync(std::string* result, const char* path);
 int WriteFileSync(const char* path, uv_buf_t buf);
 int WriteFileSync(v8::Isolate* isolate,
                   const char* path,
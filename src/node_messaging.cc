@@ -22,16 +22,23 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Global;
 using v8::HandleScope;
+using v8::Int32;
+using v8::Integer;
 using v8::Isolate;
 using v8::Just;
+using v8::KeyConversionMode;
 using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
+using v8::PropertyFilter;
 using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Symbol;
+using v8::Uint32;
 using v8::Value;
 using v8::ValueDeserializer;
 using v8::ValueSerializer;
@@ -103,6 +110,11 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   EscapableHandleScope handle_scope(env->isolate());
   Context::Scope context_scope(context);
 
+  if (is_flat_) {
+    return handle_scope.Escape(
+        DeserializeFlat(env, context).FromMaybe(Local<Value>()));
+  }
+
   // Create all necessary MessagePort handles.
   std::vector<MessagePort*> ports(message_ports_.size());
   for (uint32_t i = 0; i < message_ports_.size(); ++i) {
@@ -290,6 +302,403 @@ class SerializerDelegate : public ValueSerializer::Delegate {
 
 }  // anonymous namespace
 
+namespace {
+
+// Tags of the flat message format used by Message::SerializeFlat().
+// Strings are stored as their length followed by their Latin-1 or (2-byte
+// aligned) UTF-16 contents, arrays and objects as their number of elements
+// followed by the elements, or by key/value pairs, respectively.
+enum class FlatTag : uint8_t {
+  kUndefined,
+  kNull,
+  kTrue,
+  kFalse,
+  kInt32,
+  kDouble,
+  kOneByteString,
+  kTwoByteString,
+  kArray,
+  kObject
+};
+
+// Writes a value in the flat message format. Nothing about the value is
+// observable from JS while doing so, so that it can still be passed on to
+// v8::ValueSerializer when it turns out not to be supported; in particular,
+// no getters are invoked.
+class FlatSerializer {
+ public:
+  FlatSerializer(Environment* env, Local<Context> context)
+      : env_(env), context_(context) {}
+
+  // Returns Just(false) if `value` cannot be written in the flat format.
+  Maybe<bool> WriteValue(Local<Value> value) {
+    if (WritePrimitive(value))
+      return Just(true);
+    if (value->IsArray())
+      return WriteArray(value.As<Array>());
+    if (value->IsObject() && IsPlainObject(value.As<Object>()))
+      return WriteObject(value.As<Object>());
+    return Just(false);
+  }
+
+  MallocedBuffer<char> Release() {
+    buffer_.Truncate(length_);
+    return std::move(buffer_);
+  }
+
+ private:
+  // Returns false, without writing anything, if `value` is not a primitive
+  // that is supported by the flat format.
+  bool WritePrimitive(Local<Value> value) {
+    if (value->IsString()) {
+      WriteString(value.As<String>());
+    } else if (value->IsInt32()) {
+      int32_t number = value.As<Int32>()->Value();
+      WriteTag(FlatTag::kInt32);
+      memcpy(Reserve(sizeof(number)), &number, sizeof(number));
+    } else if (value->IsNumber()) {
+      double number = value.As<Number>()->Value();
+      WriteTag(FlatTag::kDouble);
+      memcpy(Reserve(sizeof(number)), &number, sizeof(number));
+    } else if (value->IsUndefined()) {
+      WriteTag(FlatTag::kUndefined);
+    } else if (value->IsNull()) {
+      WriteTag(FlatTag::kNull);
+    } else if (value->IsTrue()) {
+      WriteTag(FlatTag::kTrue);
+    } else if (value->IsFalse()) {
+      WriteTag(FlatTag::kFalse);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void WriteString(Local<String> string) {
+    Isolate* isolate = env_->isolate();
+    uint32_t length = string->Length();
+    if (string->IsOneByte()) {
+      WriteTag(FlatTag::kOneByteString);
+      WriteUint32(length);
+      string->WriteOneByte(isolate,
+                           reinterpret_cast<uint8_t*>(Reserve(length)),
+                           0,
+                           length,
+                           String::NO_NULL_TERMINATION);
+    } else {
+      WriteTag(FlatTag::kTwoByteString);
+      WriteUint32(length);
+      if (length_ % sizeof(uint16_t) != 0)
+        Reserve(1);
+      string->Write(isolate,
+                    reinterpret_cast<uint16_t*>(
+                        Reserve(length * sizeof(uint16_t))),
+                    0,
+                    length,
+                    String::NO_NULL_TERMINATION);
+    }
+  }
+
+  Maybe<bool> WriteArray(Local<Array> array) {
+    // Only dense arrays without other properties are supported. Indices are
+    // listed before any other keys, so if there are as many keys as elements
+    // and the last one is an index, these are exactly the indices.
+    uint32_t length = array->Length();
+    Local<Array> keys;
+    if (!array->GetOwnPropertyNames(context_,
+                                    static_cast<PropertyFilter>(
+                                        PropertyFilter::ONLY_ENUMERABLE |
+                                        PropertyFilter::SKIP_SYMBOLS),
+                                    KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return Nothing<bool>();
+    }
+    if (keys->Length() != length)
+      return Just(false);
+    if (length > 0) {
+      Local<Value> last;
+      if (!keys->Get(context_, length - 1).ToLocal(&last))
+        return Nothing<bool>();
+      if (last.As<String>()->ToArrayIndex(context_).IsEmpty())
+        return Just(false);
+    }
+
+    size_t start = length_;
+    WriteTag(FlatTag::kArray);
+    WriteUint32(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> key;
+      Local<Value> value;
+      bool is_accessor;
+      if (!keys->Get(context_, i).ToLocal(&key) ||
+          !array->HasRealNamedCallbackProperty(context_, key.As<String>())
+               .To(&is_accessor)) {
+        return Nothing<bool>();
+      }
+      if (is_accessor) {
+        length_ = start;
+        return Just(false);
+      }
+      if (!array->Get(context_, i).ToLocal(&value))
+        return Nothing<bool>();
+      if (!WritePrimitive(value)) {
+        length_ = start;
+        return Just(false);
+      }
+    }
+    return Just(true);
+  }
+
+  Maybe<bool> WriteObject(Local<Object> object) {
+    Local<Array> keys;
+    if (!object->GetOwnPropertyNames(context_,
+                                     static_cast<PropertyFilter>(
+                                         PropertyFilter::ONLY_ENUMERABLE |
+                                         PropertyFilter::SKIP_SYMBOLS),
+                                     KeyConversionMode::kConvertToString)
+             .ToLocal(&keys)) {
+      return Nothing<bool>();
+    }
+
+    size_t start = length_;
+    uint32_t length = keys->Length();
+    WriteTag(FlatTag::kObject);
+    WriteUint32(length);
+    for (uint32_t i = 0; i < length; i++) {
+      Local<Value> key;
+      Local<Value> value;
+      bool is_accessor;
+      if (!keys->Get(context_, i).ToLocal(&key) ||
+          !object->HasRealNamedCallbackProperty(context_, key.As<String>())
+               .To(&is_accessor)) {
+        return Nothing<bool>();
+      }
+      if (is_accessor) {
+        length_ = start;
+        return Just(false);
+      }
+      if (!object->Get(context_, key).ToLocal(&value))
+        return Nothing<bool>();
+      WriteString(key.As<String>());
+      if (!WritePrimitive(value)) {
+        length_ = start;
+        return Just(false);
+      }
+    }
+    return Just(true);
+  }
+
+  // Whether `object` is an ordinary object from the current context that
+  // v8::ValueSerializer would copy property by property.
+  bool IsPlainObject(Local<Object> object) {
+    if (object->InternalFieldCount() != 0 ||
+        object->HasNamedLookupInterceptor() ||
+        object->HasIndexedLookupInterceptor() ||
+        object->IsProxy() ||
+        object->IsFunction() ||
+        object->IsArgumentsObject() ||
+        object->IsBooleanObject() ||
+        object->IsNumberObject() ||
+        object->IsStringObject() ||
+        object->IsSymbolObject() ||
+        object->IsBigIntObject() ||
+        object->IsNativeError() ||
+        object->IsDate() ||
+        object->IsRegExp() ||
+        object->IsPromise() ||
+        object->IsGeneratorObject() ||
+        object->IsMap() ||
+        object->IsSet() ||
+        object->IsMapIterator() ||
+        object->IsSetIterator() ||
+        object->IsWeakMap() ||
+        object->IsWeakSet() ||
+        object->IsArrayBuffer() ||
+        object->IsArrayBufferView() ||
+        object->IsSharedArrayBuffer() ||
+        object->IsWasmModuleObject() ||
+        object->IsModuleNamespaceObject()) {
+      return false;
+    }
+    if (object_prototype_.IsEmpty())
+      object_prototype_ = Object::New(env_->isolate())->GetPrototype();
+    return object->GetPrototype() == object_prototype_;
+  }
+
+  void WriteTag(FlatTag tag) {
+    *Reserve(1) = static_cast<char>(tag);
+  }
+
+  void WriteUint32(uint32_t value) {
+    memcpy(Reserve(sizeof(value)), &value, sizeof(value));
+  }
+
+  char* Reserve(size_t size) {
+    if (length_ + size > buffer_.size) {
+      size_t capacity = std::max(length_ + size, 2 * buffer_.size + 64);
+      buffer_ = MallocedBuffer<char>(Realloc(buffer_.release(), capacity),
+                                     capacity);
+    }
+    char* position = buffer_.data + length_;
+    length_ += size;
+    return position;
+  }
+
+  Environment* env_;
+  Local<Context> context_;
+  Local<Value> object_prototype_;
+  MallocedBuffer<char> buffer_;
+  size_t length_ = 0;
+};
+
+// Reads a value written by FlatSerializer.
+class FlatDeserializer {
+ public:
+  FlatDeserializer(Environment* env,
+                   Local<Context> context,
+                   const MallocedBuffer<char>& buffer)
+      : env_(env),
+        context_(context),
+        start_(buffer.data),
+        position_(buffer.data),
+        end_(buffer.data + buffer.size) {}
+
+  MaybeLocal<Value> ReadValue() {
+    FlatTag tag = ReadTag();
+    if (tag == FlatTag::kArray)
+      return ReadArray();
+    if (tag == FlatTag::kObject)
+      return ReadObject();
+    return ReadPrimitive(tag);
+  }
+
+ private:
+  MaybeLocal<Value> ReadPrimitive(FlatTag tag) {
+    Isolate* isolate = env_->isolate();
+    switch (tag) {
+      case FlatTag::kUndefined:
+        return v8::Undefined(isolate);
+      case FlatTag::kNull:
+        return v8::Null(isolate);
+      case FlatTag::kTrue:
+        return v8::True(isolate);
+      case FlatTag::kFalse:
+        return v8::False(isolate);
+      case FlatTag::kInt32: {
+        int32_t number;
+        memcpy(&number, Read(sizeof(number)), sizeof(number));
+        return Integer::New(isolate, number);
+      }
+      case FlatTag::kDouble: {
+        double number;
+        memcpy(&number, Read(sizeof(number)), sizeof(number));
+        return Number::New(isolate, number);
+      }
+      case FlatTag::kOneByteString:
+      case FlatTag::kTwoByteString: {
+        Local<String> string;
+        if (!ReadString(tag, NewStringType::kNormal).ToLocal(&string))
+          return MaybeLocal<Value>();
+        return string;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+
+  MaybeLocal<String> ReadString(FlatTag tag, NewStringType type) {
+    Isolate* isolate = env_->isolate();
+    uint32_t length = ReadUint32();
+    if (tag == FlatTag::kOneByteString) {
+      return String::NewFromOneByte(
+          isolate,
+          reinterpret_cast<const uint8_t*>(Read(length)),
+          type,
+          length);
+    }
+    CHECK_EQ(tag, FlatTag::kTwoByteString);
+    if ((position_ - start_) % sizeof(uint16_t) != 0)
+      Read(1);
+    return String::NewFromTwoByte(
+        isolate,
+        reinterpret_cast<const uint16_t*>(Read(length * sizeof(uint16_t))),
+        type,
+        length);
+  }
+
+  MaybeLocal<Value> ReadArray() {
+    uint32_t length = ReadUint32();
+    MaybeStackBuffer<Local<Value>, 16> elements(length);
+    for (uint32_t i = 0; i < length; i++) {
+      if (!ReadPrimitive(ReadTag()).ToLocal(&elements[i]))
+        return MaybeLocal<Value>();
+    }
+    return Array::New(env_->isolate(), elements.out(), length);
+  }
+
+  MaybeLocal<Value> ReadObject() {
+    uint32_t length = ReadUint32();
+    // Building the object one property at a time, with internalized keys,
+    // lets all messages of the same shape share V8's hidden classes.
+    Local<Object> object = Object::New(env_->isolate());
+    for (uint32_t i = 0; i < length; i++) {
+      Local<String> key;
+      Local<Value> value;
+      if (!ReadString(ReadTag(), NewStringType::kInternalized).ToLocal(&key) ||
+          !ReadPrimitive(ReadTag()).ToLocal(&value) ||
+          object->CreateDataProperty(context_, key, value).IsNothing()) {
+        return MaybeLocal<Value>();
+      }
+    }
+    return object;
+  }
+
+  FlatTag ReadTag() {
+    return static_cast<FlatTag>(*Read(1));
+  }
+
+  uint32_t ReadUint32() {
+    uint32_t value;
+    memcpy(&value, Read(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  const char* Read(size_t size) {
+    CHECK_LE(size, static_cast<size_t>(end_ - position_));
+    const char* position = position_;
+    position_ += size;
+    return position;
+  }
+
+  Environment* env_;
+  Local<Context> context_;
+  const char* start_;
+  const char* position_;
+  const char* end_;
+};
+
+}  // anonymous namespace
+
+Maybe<bool> Message::SerializeFlat(Environment* env,
+                                   Local<Context> context,
+                                   Local<Value> input) {
+  FlatSerializer serializer(env, context);
+  bool written;
+  if (!serializer.WriteValue(input).To(&written))
+    return Nothing<bool>();
+  if (written) {
+    main_message_buf_ = serializer.Release();
+    is_flat_ = true;
+  }
+  return Just(written);
+}
+
+MaybeLocal<Value> Message::DeserializeFlat(Environment* env,
+                                           Local<Context> context) {
+  FlatDeserializer deserializer(env, context, main_message_buf_);
+  return deserializer.ReadValue();
+}
+
 Maybe<bool> Message::Serialize(Environment* env,
                                Local<Context> context,
                                Local<Value> input,
@@ -301,6 +710,14 @@ Maybe<bool> Message::Serialize(Environment* env,
   // Verify that we're not silently overwriting an existing message.
   CHECK(main_message_buf_.is_empty());
 
+  if (transfer_list_v.length() == 0) {
+    bool written;
+    if (!SerializeFlat(env, context, input).To(&written))
+      return Nothing<bool>();
+    if (written)
+      return Just(true);
+  }
+
   SerializerDelegate delegate(env, context, this);
   ValueSerializer serializer(env->isolate(), &delegate);
   delegate.serializer = &serializer;
@@ -430,6 +847,14 @@ void MessagePortData::AddToIncomingQueue(Message&& message) {
   Mutex::ScopedLock lock(mutex_);
   incoming_messages_.emplace_back(std::move(message));
 
+  // If there already were messages in the queue, the receiving side has
+  // either been notified about them and picks this one up in the same
+  // OnMessage() call, or it is not receiving messages and will be notified
+  // again once it starts doing so. This way, a burst of messages costs only
+  // a single uv_async_send() call.
+  if (incoming_messages_.size() > 1)
+    return;
+
   if (owner_ != nullptr) {
     Debug(owner_, "Adding message to incoming queue");
     owner_->TriggerAsync();
@@ -643,7 +1068,13 @@ void MessagePort::OnMessage() {
     Context::Scope context_scope(context);
 
     Local<Value> payload;
-    if (!ReceiveMessage(context, true).ToLocal(&payload)) break;
+    if (!ReceiveMessage(context, true).ToLocal(&payload)) {
+      // Messages queued up behind this one did not trigger the uv_async_t
+      // handle again, so make sure that they are not left behind.
+      if (data_ && env()->can_call_into_js())
+        TriggerAsync();
+      break;
+    }
     if (payload == env()->no_message_symbol()) break;
 
     if (!env()->can_call_into_js()) {
@@ -950,6 +1381,74 @@ Local<FunctionTemplate> GetMessagePortConstructorTemplate(Environment* env) {
 
 namespace {
 
+// All RingChannelWaker handles that have not been closed yet, by id.
+Mutex ring_channel_wakers_mutex;
+std::unordered_map<uint32_t, RingChannelWaker*> ring_channel_wakers;
+uint32_t next_ring_channel_waker_id = 1;
+
+}  // anonymous namespace
+
+RingChannelWaker::RingChannelWaker(Environment* env, Local<Object> wrap)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_RINGCHANNEL) {
+  auto onwake = [](uv_async_t* handle) {
+    RingChannelWaker* waker = ContainerOf(&RingChannelWaker::async_, handle);
+    waker->OnWake();
+  };
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, onwake), 0);
+
+  Mutex::ScopedLock lock(ring_channel_wakers_mutex);
+  // Zero marks a channel without a waiting reader.
+  if (next_ring_channel_waker_id == 0)
+    next_ring_channel_waker_id++;
+  id_ = next_ring_channel_waker_id++;
+  ring_channel_wakers[id_] = this;
+}
+
+void RingChannelWaker::Wake(uint32_t id) {
+  // Holding the lock keeps Close() from running concurrently, so the handle
+  // cannot go away while it is being triggered.
+  Mutex::ScopedLock lock(ring_channel_wakers_mutex);
+  auto it = ring_channel_wakers.find(id);
+  if (it != ring_channel_wakers.end())
+    CHECK_EQ(uv_async_send(&it->second->async_), 0);
+}
+
+void RingChannelWaker::Close(Local<Value> close_callback) {
+  {
+    Mutex::ScopedLock lock(ring_channel_wakers_mutex);
+    ring_channel_wakers.erase(id_);
+  }
+  HandleWrap::Close(close_callback);
+}
+
+void RingChannelWaker::OnWake() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  MakeCallback(env()->onmessage_string(), 0, nullptr);
+}
+
+void RingChannelWaker::New(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args.IsConstructCall());
+  Environment* env = Environment::GetCurrent(args);
+  new RingChannelWaker(env, args.This());
+}
+
+void RingChannelWaker::GetId(const FunctionCallbackInfo<Value>& args) {
+  RingChannelWaker* waker;
+  ASSIGN_OR_RETURN_UNWRAP(&waker, args.Holder());
+  args.GetReturnValue().Set(waker->id());
+}
+
+void RingChannelWaker::Wake(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  Wake(args[0].As<Uint32>()->Value());
+}
+
+namespace {
+
 static void MessageChannel(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   if (!args.IsConstructCall()) {
@@ -1005,6 +1504,21 @@ static void InitMessaging(Local<Object> target,
   env->SetMethod(target, "moveMessagePortToContext",
                  MessagePort::MoveToContext);
 
+  {
+    Local<String> ring_channel_waker_string =
+        FIXED_ONE_BYTE_STRING(env->isolate(), "RingChannelWaker");
+    Local<FunctionTemplate> t = env->NewFunctionTemplate(RingChannelWaker::New);
+    t->InstanceTemplate()->SetInternalFieldCount(
+        RingChannelWaker::kInternalFieldCount);
+    t->SetClassName(ring_channel_waker_string);
+    t->Inherit(HandleWrap::GetConstructorTemplate(env));
+    env->SetProtoMethodNoSideEffect(t, "getId", RingChannelWaker::GetId);
+    target->Set(context,
+                ring_channel_waker_string,
+                t->GetFunction(context).ToLocalChecked()).Check();
+  }
+  env->SetMethod(target, "wakeRingChannel", RingChannelWaker::Wake);
+
   {
     Local<Function> domexception = GetDOMException(context).ToLocalChecked();
     target
@@ -72,7 +72,18 @@ class Message : public MemoryRetainer {
   SET_SELF_SIZE(Message)
 
  private:
+  // Messages without transferables that consist only of primitives, or of a
+  // plain object or array whose own properties are all primitives, are not
+  // written with v8::ValueSerializer but in a simpler, flat format that is
+  // cheaper to produce and to turn back into JS values.
+  v8::Maybe<bool> SerializeFlat(Environment* env,
+                                v8::Local<v8::Context> context,
+                                v8::Local<v8::Value> input);
+  v8::MaybeLocal<v8::Value> DeserializeFlat(Environment* env,
+                                            v8::Local<v8::Context> context);
+
   MallocedBuffer<char> main_message_buf_;
+  bool is_flat_ = false;
   std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
   std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
   std::vector<std::unique_ptr<MessagePortData>> message_ports_;
@@ -214,6 +225,39 @@ class MessagePort : public HandleWrap {
   friend class MessagePortData;
 };
 
+// The native part of a RingChannel: a handle that lets the thread writing
+// into the channel's SharedArrayBuffer wake up the event loop of the thread
+// reading from it once that has run out of records. The two sides share
+// nothing but that SharedArrayBuffer, so writers look up the handle through
+// a process-wide id that the reading side stores in there.
+class RingChannelWaker : public HandleWrap {
+ public:
+  RingChannelWaker(Environment* env, v8::Local<v8::Object> wrap);
+
+  // Trigger the handle with the given id, if it still exists.
+  // This may be called from any thread.
+  static void Wake(uint32_t id);
+
+  uint32_t id() const { return id_; }
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetId(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Wake(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RingChannelWaker)
+  SET_SELF_SIZE(RingChannelWaker)
+
+ private:
+  void OnWake();
+
+  uv_async_t async_;
+  uint32_t id_;
+};
+
 v8::Local<v8::FunctionTemplate> GetMessagePortConstructorTemplate(
     Environment* env);
 
@@ -0,0 +1,288 @@
+#include "node_module_bundle.h"
+#include "blob_serializer.h"
+#include "debug_utils-inl.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "node_version.h"
+#include "util-inl.h"
+
+#include <cstring>
+
+namespace node {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+namespace per_process {
+const ModuleBundle* module_bundle = nullptr;
+}  // namespace per_process
+
+namespace {
+
+constexpr char kMagic[] = "NODEBNDL";
+constexpr size_t kMagicLength = sizeof(kMagic) - 1;
+constexpr uint32_t kFormatVersion = 1;
+
+int StatFile(const std::string& filename, uv_stat_t* stat) {
+  uv_fs_t req;
+  int err = uv_fs_stat(nullptr, &req, filename.c_str(), nullptr);
+  if (err == 0)
+    *stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  return err;
+}
+
+// A file that has been edited since the bundle was built is read from disk
+// again instead of being shadowed by the stale source in the bundle.
+bool IsUnchanged(const BundledModule& module) {
+  uv_stat_t stat;
+  return StatFile(module.filename, &stat) == 0 &&
+         stat.st_size == module.source.size() &&
+         stat.st_mtim.tv_sec == module.mtime_sec &&
+         stat.st_mtim.tv_nsec == module.mtime_nsec;
+}
+
+}  // anonymous namespace
+
+void ModuleBundle::Assign(
+    const std::string& entry,
+    std::vector<std::pair<std::string, std::string>>&& resolutions,
+    std::vector<BundledModule>&& modules) {
+  entry_ = entry;
+  resolutions_ = std::move(resolutions);
+  modules_ = std::move(modules);
+}
+
+std::string ModuleBundle::Serialize() const {
+  std::string out(kMagic, kMagicLength);
+  BlobWrite<uint32_t>(&out, kFormatVersion);
+  BlobWriteString(&out, NODE_VERSION, strlen(NODE_VERSION));
+  BlobWriteString(&out, entry_);
+  BlobWrite<uint32_t>(&out, static_cast<uint32_t>(resolutions_.size()));
+  for (const auto& resolution : resolutions_) {
+    BlobWriteString(&out, resolution.first);
+    BlobWriteString(&out, resolution.second);
+  }
+  BlobWrite<uint32_t>(&out, static_cast<uint32_t>(modules_.size()));
+  for (const BundledModule& module : modules_) {
+    BlobWriteString(&out, module.filename);
+    BlobWriteString(&out, module.source);
+    BlobWrite<int64_t>(&out, module.mtime_sec);
+    BlobWrite<int64_t>(&out, module.mtime_nsec);
+  }
+  return out;
+}
+
+std::string ModuleBundle::ReadFromFile(const std::string& path) {
+  std::string contents;
+  int err = ReadFileSync(&contents, path.c_str());
+  if (err != 0) {
+    return SPrintF("Cannot read module bundle: %s", uv_strerror(err));
+  }
+
+  BlobReader reader(contents);
+  const char* magic;
+  uint32_t format_version;
+  if (!reader.ReadBytes(kMagicLength, &magic) ||
+      memcmp(magic, kMagic, kMagicLength) != 0 ||
+      !reader.Read(&format_version) ||
+      format_version != kFormatVersion) {
+    return "Not a Node.js module bundle";
+  }
+
+  // Module resolution may differ between versions.
+  std::string node_version;
+  if (!reader.ReadString(&node_version))
+    return "Module bundle is malformed";
+  if (node_version != NODE_VERSION) {
+    return SPrintF("Module bundle was built by Node.js %s, which does not "
+                   "match Node.js %s", node_version, NODE_VERSION);
+  }
+
+  std::string entry;
+  uint32_t resolution_count;
+  if (!reader.ReadString(&entry) || entry.empty() ||
+      !reader.ReadCount(&resolution_count)) {
+    return "Module bundle is malformed";
+  }
+  std::vector<std::pair<std::string, std::string>> resolutions(
+      resolution_count);
+  for (auto& resolution : resolutions) {
+    if (!reader.ReadString(&resolution.first) ||
+        !reader.ReadString(&resolution.second)) {
+      return "Module bundle is malformed";
+    }
+  }
+
+  uint32_t module_count;
+  if (!reader.ReadCount(&module_count))
+    return "Module bundle is malformed";
+  std::vector<BundledModule> modules(module_count);
+  for (BundledModule& module : modules) {
+    if (!reader.ReadString(&module.filename) ||
+        !reader.ReadString(&module.source) ||
+        !reader.Read(&module.mtime_sec) ||
+        !reader.Read(&module.mtime_nsec)) {
+      return "Module bundle is malformed";
+    }
+  }
+  if (!reader.AtEnd())
+    return "Module bundle is malformed";
+
+  Assign(entry, std::move(resolutions), std::move(modules));
+  return "";
+}
+
+namespace {
+
+// Returns undefined if the process was not started from a bundle. Only the
+// main thread uses the bundle, since Workers run other code.
+void GetModuleBundle(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  const ModuleBundle* bundle = per_process::module_bundle;
+  if (bundle == nullptr || !env->is_main_thread())
+    return;
+
+  std::vector<std::string> keys;
+  std::vector<std::string> filenames;
+  for (const auto& resolution : bundle->resolutions()) {
+    keys.push_back(resolution.first);
+    filenames.push_back(resolution.second);
+  }
+  std::vector<std::string> module_filenames;
+  for (const BundledModule& module : bundle->modules())
+    module_filenames.push_back(module.filename);
+
+  Local<Context> context = env->context();
+  Local<Value> result[] = {
+    ToV8Value(context, keys).ToLocalChecked(),
+    ToV8Value(context, filenames).ToLocalChecked(),
+    ToV8Value(context, module_filenames).ToLocalChecked(),
+  };
+  args.GetReturnValue().Set(Array::New(env->isolate(),
+                                       result,
+                                       arraysize(result)));
+}
+
+// Returns the source of the module at an index of the filenames returned by
+// GetModuleBundle(), or undefined if its file has changed since the bundle
+// was built.
+void GetBundledSource(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  const ModuleBundle* bundle = per_process::module_bundle;
+  CHECK_NOT_NULL(bundle);
+  CHECK(args[0]->IsUint32());
+  uint32_t index = args[0].As<v8::Uint32>()->Value();
+  CHECK_LT(index, bundle->modules().size());
+  const BundledModule& module = bundle->modules()[index];
+
+  if (!IsUnchanged(module)) {
+    Debug(env, DebugCategory::MODULE_BUNDLE,
+          "[module bundle] %s has changed\n", module.filename);
+    return;
+  }
+
+  Local<String> source;
+  if (String::NewFromUtf8(env->isolate(),
+                          module.source.data(),
+                          v8::NewStringType::kNormal,
+                          static_cast<int>(module.source.size()))
+          .ToLocal(&source)) {
+    args.GetReturnValue().Set(source);
+  }
+}
+
+bool ReadStrings(Environment* env,
+                 Local<Value> value,
+                 std::vector<std::string>* out) {
+  CHECK(value->IsArray());
+  Local<Array> array = value.As<Array>();
+  for (uint32_t i = 0; i < array->Length(); i++) {
+    Local<Value> element;
+    if (!array->Get(env->context(), i).ToLocal(&element))
+      return false;
+    CHECK(element->IsString());
+    Utf8Value str(env->isolate(), element);
+    out->emplace_back(*str, str.length());
+  }
+  return true;
+}
+
+// writeModuleBundle(path, entry, keys, filenames, moduleFilenames, sources)
+// writes a bundle with the entry point and the modules that
+// --build-module-bundle has recorded, and returns 0 or a libuv error code.
+// A module is only bundled if its file still has the source that the loader
+// read, so that the modification time which is stored belongs to that source.
+void WriteModuleBundle(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsString());
+
+  std::vector<std::string> keys;
+  std::vector<std::string> filenames;
+  std::vector<std::string> module_filenames;
+  std::vector<std::string> sources;
+  if (!ReadStrings(env, args[2], &keys) ||
+      !ReadStrings(env, args[3], &filenames) ||
+      !ReadStrings(env, args[4], &module_filenames) ||
+      !ReadStrings(env, args[5], &sources)) {
+    return;
+  }
+  CHECK_EQ(keys.size(), filenames.size());
+  CHECK_EQ(module_filenames.size(), sources.size());
+
+  std::vector<std::pair<std::string, std::string>> resolutions;
+  for (size_t i = 0; i < keys.size(); i++)
+    resolutions.emplace_back(std::move(keys[i]), std::move(filenames[i]));
+
+  std::vector<BundledModule> modules;
+  for (size_t i = 0; i < sources.size(); i++) {
+    BundledModule module;
+    module.filename = std::move(module_filenames[i]);
+    module.source = std::move(sources[i]);
+
+    uv_stat_t stat;
+    std::string contents;
+    if (StatFile(module.filename, &stat) != 0 ||
+        ReadFileSync(&contents, module.filename.c_str()) != 0 ||
+        contents != module.source) {
+      Debug(env, DebugCategory::MODULE_BUNDLE,
+            "[module bundle] leaving out %s\n", module.filename);
+      continue;
+    }
+    module.mtime_sec = stat.st_mtim.tv_sec;
+    module.mtime_nsec = stat.st_mtim.tv_nsec;
+    modules.push_back(std::move(module));
+  }
+
+  ModuleBundle bundle;
+  Utf8Value entry(env->isolate(), args[1]);
+  bundle.Assign(*entry, std::move(resolutions), std::move(modules));
+  std::string contents = bundle.Serialize();
+
+  Utf8Value path(env->isolate(), args[0]);
+  uv_buf_t buf = uv_buf_init(&contents[0],
+                             static_cast<unsigned int>(contents.size()));
+  args.GetReturnValue().Set(WriteFileSync(*path, buf));
+}
+
+void Initialize(Local<Object> target,
+                Local<Value> unused,
+                Local<Context> context,
+                void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethod(target, "getModuleBundle", GetModuleBundle);
+  env->SetMethod(target, "getBundledSource", GetBundledSource);
+  env->SetMethod(target, "writeModuleBundle", WriteModuleBundle);
+}
+
+}  // anonymous namespace
+
+}  // namespace node
+
+NODE_MODULE_CONTEXT_AWARE_INTERNAL(module_bundle, node::Initialize)
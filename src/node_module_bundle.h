@@ -0,0 +1,71 @@
+#ifndef SRC_NODE_MODULE_BUNDLE_H_
+#define SRC_NODE_MODULE_BUNDLE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace node {
+
+// A CommonJS module that the entry point of a module bundle has loaded, with
+// the modification time that its file had when the source was read.
+struct BundledModule {
+  std::string filename;
+  std::string source;
+  int64_t mtime_sec = 0;
+  int64_t mtime_nsec = 0;
+};
+
+// The CommonJS modules that an application entry point loads, as written by
+// `node --module-bundle=file --build-module-bundle entry.js` and loaded at
+// startup with --module-bundle. The bundle holds the entry point's filename,
+// the filenames that the CommonJS loader resolved while running it, and the
+// sources of the modules that it loaded. Starting up from the bundle runs the
+// entry point again without resolving these requests, and takes the source of
+// every module whose file is unchanged from the bundle instead of reading it.
+//
+// This is not a heap snapshot: the entry point and all of its modules are
+// still compiled and run on every startup. Their code cache is left to
+// --compile-cache-dir.
+class ModuleBundle {
+ public:
+  ModuleBundle() = default;
+
+  void Assign(const std::string& entry,
+              std::vector<std::pair<std::string, std::string>>&& resolutions,
+              std::vector<BundledModule>&& modules);
+  // Returns an empty string on success, or a description of the error.
+  std::string ReadFromFile(const std::string& path);
+  // Returns the contents of the file that ReadFromFile() accepts.
+  std::string Serialize() const;
+
+  const std::string& entry() const { return entry_; }
+  // Pairs of a key that the CommonJS loader builds from the request and the
+  // parent module, and the filename that the request resolved to.
+  const std::vector<std::pair<std::string, std::string>>& resolutions() const {
+    return resolutions_;
+  }
+  const std::vector<BundledModule>& modules() const { return modules_; }
+
+  ModuleBundle(const ModuleBundle&) = delete;
+  ModuleBundle& operator=(const ModuleBundle&) = delete;
+
+ private:
+  std::string entry_;
+  std::vector<std::pair<std::string, std::string>> resolutions_;
+  std::vector<BundledModule> modules_;
+};
+
+namespace per_process {
+// The bundle that the process was started from, if any.
+extern const ModuleBundle* module_bundle;
+}  // namespace per_process
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_MODULE_BUNDLE_H_
@@ -71,6 +71,12 @@ void PerProcessOptions::CheckOptions(std::vector<std::string>* errors) {
       use_largepages != "silent") {
     errors->push_back("invalid value for --use-largepages");
   }
+  if (worker_isolate_pool_size < 0) {
+    errors->push_back("--worker-isolate-pool-size must not be negative");
+  }
+  if (build_module_bundle && module_bundle.empty()) {
+    errors->push_back("--build-module-bundle requires --module-bundle");
+  }
   per_isolate->CheckOptions(errors);
 }
 
@@ -271,10 +277,19 @@ DebugOptionsParser::DebugOptionsParser() {
 }
 
 EnvironmentOptionsParser::EnvironmentOptionsParser() {
+  AddOption("--compile-cache-dir",
+            "directory where the V8 code cache of user-land modules is "
+            "stored and reused across runs",
+            &EnvironmentOptions::compile_cache_dir,
+            kAllowedInEnvironment);
   AddOption("--enable-source-maps",
             "experimental Source Map V3 support",
             &EnvironmentOptions::enable_source_maps,
             kAllowedInEnvironment);
+  AddOption("--experimental-fs-io-uring",
+            "experimental io_uring support for asynchronous fs operations",
+            &EnvironmentOptions::experimental_fs_io_uring,
+            kAllowedInEnvironment);
   AddOption("--experimental-json-modules",
             "experimental JSON interop support for the ES Module loader",
             &EnvironmentOptions::experimental_json_modules,
@@ -611,6 +626,19 @@ PerIsolateOptionsParser::PerIsolateOptionsParser(
 
 PerProcessOptionsParser::PerProcessOptionsParser(
   const PerIsolateOptionsParser& iop) {
+  AddOption("--build-module-bundle",
+            "run the main script and write the modules it loads to the "
+            "--module-bundle file",
+            &PerProcessOptions::build_module_bundle);
+  AddOption("--module-bundle",
+            "run the entry point of the module bundle in the given file, or "
+            "write it with --build-module-bundle",
+            &PerProcessOptions::module_bundle);
+  AddOption("--snapshot-blob",
+            "start up from the snapshot in the given file, which was "
+            "built by node_mksnapshot, instead of the embedded one",
+            &PerProcessOptions::snapshot_blob,
+            kAllowedInEnvironment);
   AddOption("--title",
             "the process title to use on startup",
             &PerProcessOptions::title,
@@ -630,6 +658,10 @@ PerProcessOptionsParser::PerProcessOptionsParser(
             "set V8's thread pool size",
             &PerProcessOptions::v8_thread_pool_size,
             kAllowedInEnvironment);
+  AddOption("--worker-isolate-pool-size",
+            "number of Isolates kept ready for new Worker threads",
+            &PerProcessOptions::worker_isolate_pool_size,
+            kAllowedInEnvironment);
   AddOption("--zero-fill-buffers",
             "automatically zero-fill all newly allocated Buffer and "
             "SlowBuffer instances",
@@ -3,7 +3,10 @@
 #include "node_internals.h"
 #include "node_perf.h"
 #include "node_buffer.h"
+#include "node_platform.h"
 #include "node_process.h"
+#include "node_v8_platform-inl.h"
+#include "request_latency.h"
 #include "util-inl.h"
 
 #include <cinttypes>
@@ -14,6 +17,7 @@ namespace performance {
 using v8::Array;
 using v8::Context;
 using v8::DontDelete;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -53,6 +57,55 @@ void performance_state::Mark(enum PerformanceMilestone milestone,
       TRACE_EVENT_SCOPE_THREAD, ts / 1000);
 }
 
+void performance_state::LoopPrepare() {
+  uint64_t now = PERFORMANCE_NOW();
+  if (loop_check_time_ != 0) {
+    // Whatever the loop did since the end of the previous poll phase that
+    // was not spent running timers or immediates.
+    double timers = loop_timing[NODE_PERFORMANCE_LOOP_TIMING_TIMERS] -
+                    loop_timers_mark_;
+    double check = loop_timing[NODE_PERFORMANCE_LOOP_TIMING_CHECK] -
+                   loop_check_mark_;
+    double other = static_cast<double>(now - loop_check_time_) -
+                   timers - check;
+    if (other > 0)
+      loop_timing[NODE_PERFORMANCE_LOOP_TIMING_OTHER] += other;
+
+    // The durations of the iteration that has just ended, in microseconds.
+    TRACE_COUNTER1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                   "pollIdle", loop_poll_idle_ / 1000);
+    TRACE_COUNTER1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                   "pollActive", loop_poll_active_ / 1000);
+    TRACE_COUNTER1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                   "check", check / 1000);
+    TRACE_COUNTER1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                   "timers", timers / 1000);
+    TRACE_COUNTER1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                   "other", other > 0 ? other / 1000 : 0);
+  }
+  loop_prepare_time_ = now;
+  loop_wakeup_time_ = 0;
+}
+
+void performance_state::LoopCheck() {
+  if (loop_prepare_time_ == 0)
+    return;
+  uint64_t now = PERFORMANCE_NOW();
+  // If nothing called into JS, the whole poll phase counts as idle.
+  uint64_t wakeup = loop_wakeup_time_ != 0 ? loop_wakeup_time_ : now;
+  loop_poll_idle_ = wakeup - loop_prepare_time_;
+  loop_poll_active_ = now - wakeup;
+  loop_timing[NODE_PERFORMANCE_LOOP_TIMING_POLL_IDLE] +=
+      static_cast<double>(loop_poll_idle_);
+  loop_timing[NODE_PERFORMANCE_LOOP_TIMING_POLL_ACTIVE] +=
+      static_cast<double>(loop_poll_active_);
+  loop_timing[NODE_PERFORMANCE_LOOP_TIMING_ITERATIONS] += 1;
+  loop_timers_mark_ = loop_timing[NODE_PERFORMANCE_LOOP_TIMING_TIMERS];
+  loop_check_mark_ = loop_timing[NODE_PERFORMANCE_LOOP_TIMING_CHECK];
+  loop_check_time_ = now;
+  loop_prepare_time_ = 0;
+}
+
 // Initialize the performance entry object properties
 inline void InitObject(const PerformanceEntry& entry, Local<Object> obj) {
   Environment* env = entry.env();
@@ -547,6 +600,38 @@ bool ELDHistogram::Disable() {
   return true;
 }
 
+// The number of fields per lane that GetWorkerTaskStats() reports.
+constexpr size_t kWorkerTaskStatsFields = 5;
+
+// getWorkerTaskStats(fields)
+// Fills a Float64Array with the statistics of each lane of the platform's
+// worker thread task queue, in the order of WorkerTaskPriority. Times are in
+// milliseconds. Returns false if the platform is not Node.js' own.
+static void GetWorkerTaskStats(const FunctionCallbackInfo<Value>& args) {
+  NodePlatform* platform = per_process::v8_platform.Platform();
+  if (platform == nullptr)
+    return args.GetReturnValue().Set(false);
+
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), kWorkerTaskPriorityCount * kWorkerTaskStatsFields);
+  double* fields = reinterpret_cast<double*>(
+      static_cast<char*>(array->Buffer()->GetBackingStore()->Data()) +
+      array->ByteOffset());
+
+  for (size_t i = 0; i < kWorkerTaskPriorityCount; i++) {
+    const WorkerTaskStats stats =
+        platform->GetWorkerTaskStats(static_cast<WorkerTaskPriority>(i));
+    double* lane = fields + i * kWorkerTaskStatsFields;
+    lane[0] = static_cast<double>(stats.tasks);
+    lane[1] = static_cast<double>(stats.steals);
+    lane[2] = stats.wait_time / 1e6;
+    lane[3] = stats.max_wait_time / 1e6;
+    lane[4] = stats.run_time / 1e6;
+  }
+  args.GetReturnValue().Set(true);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -561,6 +646,9 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).Check();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "loopTiming"),
+              state->loop_timing.GetJSArray()).Check();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -584,6 +672,7 @@ void Initialize(Local<Object> target,
                  "removeGarbageCollectionTracking",
                  RemoveGarbageCollectionTracking);
   env->SetMethod(target, "notify", Notify);
+  env->SetMethod(target, "getWorkerTaskStats", GetWorkerTaskStats);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -617,6 +706,11 @@ void Initialize(Local<Object> target,
   NODE_PERFORMANCE_MILESTONES(V)
 #undef V
 
+#define V(name, _)                                                            \
+  NODE_DEFINE_HIDDEN_CONSTANT(constants, NODE_PERFORMANCE_LOOP_TIMING_##name);
+  NODE_PERFORMANCE_LOOP_TIMING_FIELDS(V)
+#undef V
+
   PropertyAttribute attr =
       static_cast<PropertyAttribute>(ReadOnly | DontDelete);
 
@@ -654,6 +748,9 @@ void Initialize(Local<Object> target,
   env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
   target->Set(context, eldh_classname,
               eldh->GetFunction(env->context()).ToLocalChecked()).Check();
+
+  RecordableHistogram::Initialize(env, target);
+  RequestLatencyRecorder::Initialize(env, target);
 }
 
 }  // namespace performance
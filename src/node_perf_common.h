@@ -38,6 +38,20 @@ extern uint64_t performance_v8_start;
   V(HTTP2, "http2")                                                           \
   V(HTTP, "http")
 
+// Cumulative time, in nanoseconds, that the event loop of an Environment has
+// spent in each of its phases, and the number of iterations it has run.
+// The poll phase is split into the time spent waiting for I/O and the time
+// spent handling it; OTHER is what the loop spent outside of the poll phase
+// that is not accounted for by the timers and check phases, i.e. the pending,
+// idle, prepare and close phases.
+#define NODE_PERFORMANCE_LOOP_TIMING_FIELDS(V)                                \
+  V(TIMERS, "timers")                                                         \
+  V(POLL_IDLE, "pollIdle")                                                    \
+  V(POLL_ACTIVE, "pollActive")                                                \
+  V(CHECK, "check")                                                           \
+  V(OTHER, "other")                                                           \
+  V(ITERATIONS, "iterations")
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -52,6 +66,13 @@ enum PerformanceEntryType {
   NODE_PERFORMANCE_ENTRY_TYPE_INVALID
 };
 
+enum PerformanceLoopTimingField {
+#define V(name, _) NODE_PERFORMANCE_LOOP_TIMING_##name,
+  NODE_PERFORMANCE_LOOP_TIMING_FIELDS(V)
+#undef V
+  NODE_PERFORMANCE_LOOP_TIMING_INVALID
+};
+
 class performance_state {
  public:
   explicit performance_state(v8::Isolate* isolate) :
@@ -63,6 +84,11 @@ class performance_state {
       offsetof(performance_state_internal, milestones),
       NODE_PERFORMANCE_MILESTONE_INVALID,
       root),
+    loop_timing(
+      isolate,
+      offsetof(performance_state_internal, loop_timing),
+      NODE_PERFORMANCE_LOOP_TIMING_INVALID,
+      root),
     observers(
       isolate,
       offsetof(performance_state_internal, observers),
@@ -70,10 +96,13 @@ class performance_state {
       root) {
     for (size_t i = 0; i < milestones.Length(); i++)
       milestones[i] = -1.;
+    for (size_t i = 0; i < loop_timing.Length(); i++)
+      loop_timing[i] = 0;
   }
 
   AliasedUint8Array root;
   AliasedFloat64Array milestones;
+  AliasedFloat64Array loop_timing;
   AliasedUint32Array observers;
 
   uint64_t performance_last_gc_start_mark = 0;
@@ -81,12 +110,55 @@ class performance_state {
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
 
+  // These are called by the Environment right before and right after the
+  // poll phase of each event loop iteration.
+  void LoopPrepare();
+  void LoopCheck();
+
+  // Called whenever the event loop calls into JS. The first call during the
+  // poll phase is taken as the point where the loop stopped waiting for I/O.
+  inline void LoopWakeup() {
+    if (loop_prepare_time_ != 0 && loop_wakeup_time_ == 0)
+      loop_wakeup_time_ = PERFORMANCE_NOW();
+  }
+
  private:
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double loop_timing[NODE_PERFORMANCE_LOOP_TIMING_INVALID];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
+
+  uint64_t loop_prepare_time_ = 0;
+  uint64_t loop_wakeup_time_ = 0;
+  uint64_t loop_check_time_ = 0;
+  // The values of the TIMERS and CHECK fields, and the length of the poll
+  // phase, as of the end of the last poll phase.
+  double loop_timers_mark_ = 0;
+  double loop_check_mark_ = 0;
+  uint64_t loop_poll_idle_ = 0;
+  uint64_t loop_poll_active_ = 0;
+};
+
+// Adds the time from its creation until it goes out of scope to one of the
+// loop_timing fields.
+class LoopPhaseScope {
+ public:
+  LoopPhaseScope(performance_state* state, PerformanceLoopTimingField field)
+      : state_(state), field_(field), start_(PERFORMANCE_NOW()) {}
+  ~LoopPhaseScope() {
+    state_->loop_timing[field_] +=
+        static_cast<double>(PERFORMANCE_NOW() - start_);
+  }
+
+  LoopPhaseScope(const LoopPhaseScope&) = delete;
+  LoopPhaseScope& operator=(const LoopPhaseScope&) = delete;
+
+ private:
+  performance_state* state_;
+  PerformanceLoopTimingField field_;
+  uint64_t start_;
 };
 
 }  // namespace performance
@@ -18,7 +18,7 @@ using node::tracing::TracingController;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkStealingTaskQueue* task_queue;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
@@ -29,7 +29,7 @@ static void PlatformWorkerThread(void* data) {
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
+  WorkStealingTaskQueue* pending_worker_tasks = worker_data->task_queue;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
 
@@ -40,17 +40,146 @@ static void PlatformWorkerThread(void* data) {
     worker_data->platform_workers_ready->Signal(lock);
   }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
-    task->Run();
-    pending_worker_tasks->NotifyOfCompletion();
-  }
+  pending_worker_tasks->RunWorkerThread(worker_data->id);
 }
 
+// The queue whose worker the current thread is, and its index there.
+thread_local WorkStealingTaskQueue* current_worker_queue = nullptr;
+thread_local size_t current_worker_index = 0;
+
 }  // namespace
 
+WorkStealingTaskQueue::WorkStealingTaskQueue(int thread_count) {
+  const int count = std::max(thread_count, 1);
+  for (int i = 0; i < count; i++)
+    queues_.emplace_back(std::make_unique<ThreadQueue>());
+}
+
+void WorkStealingTaskQueue::Push(std::unique_ptr<Task> task,
+                                 WorkerTaskPriority priority) {
+  const size_t index = current_worker_queue == this ?
+      current_worker_index :
+      next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  ThreadQueue* queue = queues_[index].get();
+
+  outstanding_++;
+  {
+    Mutex::ScopedLock lock(queue->mutex);
+    queue->lanes[static_cast<size_t>(priority)].push_back(
+        QueuedTask { std::move(task), uv_hrtime() });
+  }
+  queued_++;
+
+  // Idle threads register themselves while holding idle_mutex_, and check
+  // queued_ before they wait, so a thread cannot miss this task.
+  if (idle_threads_ > 0) {
+    Mutex::ScopedLock lock(idle_mutex_);
+    tasks_available_.Signal(lock);
+  }
+}
+
+bool WorkStealingTaskQueue::TryPop(size_t index,
+                                   QueuedTask* task,
+                                   size_t* lane,
+                                   bool* stolen) {
+  const size_t count = queues_.size();
+  for (*lane = 0; *lane < kWorkerTaskPriorityCount; ++*lane) {
+    for (size_t i = 0; i < count; i++) {
+      ThreadQueue* queue = queues_[(index + i) % count].get();
+      Mutex::ScopedLock lock(queue->mutex);
+      std::deque<QueuedTask>& tasks = queue->lanes[*lane];
+      if (tasks.empty())
+        continue;
+      *stolen = i != 0;
+      if (*stolen) {
+        *task = std::move(tasks.back());
+        tasks.pop_back();
+      } else {
+        *task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      queued_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingTaskQueue::Run(QueuedTask&& task, size_t lane, bool stolen) {
+  const uint64_t start = uv_hrtime();
+  task.task->Run();
+  task.task.reset();
+  const uint64_t end = uv_hrtime();
+
+  LaneStats& stats = stats_[lane];
+  const uint64_t wait_time = start - task.queued_at;
+  stats.tasks.fetch_add(1, std::memory_order_relaxed);
+  if (stolen)
+    stats.steals.fetch_add(1, std::memory_order_relaxed);
+  stats.wait_time.fetch_add(wait_time, std::memory_order_relaxed);
+  stats.run_time.fetch_add(end - start, std::memory_order_relaxed);
+  uint64_t max_wait_time = stats.max_wait_time.load(std::memory_order_relaxed);
+  while (wait_time > max_wait_time &&
+         !stats.max_wait_time.compare_exchange_weak(
+             max_wait_time, wait_time, std::memory_order_relaxed)) {}
+
+  if (--outstanding_ == 0) {
+    Mutex::ScopedLock lock(drain_mutex_);
+    tasks_drained_.Broadcast(lock);
+  }
+}
+
+void WorkStealingTaskQueue::RunWorkerThread(int index) {
+  current_worker_queue = this;
+  current_worker_index = static_cast<size_t>(index) % queues_.size();
+
+  // Tasks that are still queued on shutdown are dropped, not run.
+  while (!stopped_) {
+    QueuedTask task;
+    size_t lane;
+    bool stolen;
+    if (TryPop(current_worker_index, &task, &lane, &stolen)) {
+      Run(std::move(task), lane, stolen);
+      continue;
+    }
+
+    Mutex::ScopedLock lock(idle_mutex_);
+    idle_threads_++;
+    while (queued_ == 0 && !stopped_)
+      tasks_available_.Wait(lock);
+    idle_threads_--;
+  }
+
+  current_worker_queue = nullptr;
+}
+
+void WorkStealingTaskQueue::BlockingDrain() {
+  Mutex::ScopedLock lock(drain_mutex_);
+  while (outstanding_ > 0)
+    tasks_drained_.Wait(lock);
+}
+
+void WorkStealingTaskQueue::Stop() {
+  Mutex::ScopedLock lock(idle_mutex_);
+  stopped_ = true;
+  tasks_available_.Broadcast(lock);
+}
+
+WorkerTaskStats WorkStealingTaskQueue::GetStats(
+    WorkerTaskPriority priority) const {
+  const LaneStats& stats = stats_[static_cast<size_t>(priority)];
+  WorkerTaskStats result;
+  result.tasks = stats.tasks.load(std::memory_order_relaxed);
+  result.steals = stats.steals.load(std::memory_order_relaxed);
+  result.wait_time = stats.wait_time.load(std::memory_order_relaxed);
+  result.max_wait_time = stats.max_wait_time.load(std::memory_order_relaxed);
+  result.run_time = stats.run_time.load(std::memory_order_relaxed);
+  return result;
+}
+
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
+  explicit DelayedTaskScheduler(WorkStealingTaskQueue* tasks)
     : pending_worker_tasks_(tasks) {}
 
   std::unique_ptr<uv_thread_t> Start() {
@@ -142,7 +271,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   static void RunTask(uv_timer_t* timer) {
     DelayedTaskScheduler* scheduler =
         ContainerOf(&DelayedTaskScheduler::loop_, timer->loop);
-    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer));
+    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer),
+                                           WorkerTaskPriority::kNormal);
   }
 
   std::unique_ptr<Task> TakeTimerTask(uv_timer_t* timer) {
@@ -156,7 +286,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
   uv_sem_t ready_;
-  TaskQueue<Task>* pending_worker_tasks_;
+  WorkStealingTaskQueue* pending_worker_tasks_;
 
   TaskQueue<Task> tasks_;
   uv_loop_t loop_;
@@ -164,7 +294,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   std::unordered_set<uv_timer_t*> timers_;
 };
 
-WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
+WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size)
+    : pending_worker_tasks_(thread_pool_size) {
   Mutex platform_workers_mutex;
   ConditionVariable platform_workers_ready;
 
@@ -195,8 +326,9 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   }
 }
 
-void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task) {
-  pending_worker_tasks_.Push(std::move(task));
+void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task,
+                                       WorkerTaskPriority priority) {
+  pending_worker_tasks_.Push(std::move(task), priority);
 }
 
 void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
@@ -220,6 +352,11 @@ int WorkerThreadsTaskRunner::NumberOfWorkerThreads() const {
   return threads_.size();
 }
 
+WorkerTaskStats WorkerThreadsTaskRunner::GetStats(
+    WorkerTaskPriority priority) const {
+  return pending_worker_tasks_.GetStats(priority);
+}
+
 PerIsolatePlatformData::PerIsolatePlatformData(
     Isolate* isolate, uv_loop_t* loop)
   : loop_(loop) {
@@ -472,6 +609,17 @@ void NodePlatform::CallOnWorkerThread(std::unique_ptr<Task> task) {
   worker_thread_task_runner_->PostTask(std::move(task));
 }
 
+void NodePlatform::CallBlockingTaskOnWorkerThread(std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       WorkerTaskPriority::kUserBlocking);
+}
+
+void NodePlatform::CallLowPriorityTaskOnWorkerThread(
+    std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       WorkerTaskPriority::kLowPriority);
+}
+
 void NodePlatform::CallDelayedOnWorkerThread(std::unique_ptr<Task> task,
                                              double delay_in_seconds) {
   worker_thread_task_runner_->PostDelayedTask(std::move(task),
@@ -521,6 +669,11 @@ TracingController* NodePlatform::GetTracingController() {
   return tracing_controller_;
 }
 
+WorkerTaskStats NodePlatform::GetWorkerTaskStats(
+    WorkerTaskPriority priority) const {
+  return worker_thread_task_runner_->GetStats(priority);
+}
+
 Platform::StackTracePrinter NodePlatform::GetStackTracePrinter() {
   return []() {
     fprintf(stderr, "\n");
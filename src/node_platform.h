@@ -3,6 +3,8 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
+#include <deque>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -43,6 +45,84 @@ class TaskQueue {
   std::queue<std::unique_ptr<T>> task_queue_;
 };
 
+// Priority lanes of the worker thread task queue. A task is only started
+// when there is no task in a higher lane.
+enum class WorkerTaskPriority {
+  kUserBlocking,  // CallBlockingTaskOnWorkerThread()
+  kNormal,        // CallOnWorkerThread(), CallDelayedOnWorkerThread()
+  kLowPriority,   // CallLowPriorityTaskOnWorkerThread()
+};
+constexpr size_t kWorkerTaskPriorityCount = 3;
+
+struct WorkerTaskStats {
+  // Tasks that were started, and how many of them were stolen from the queue
+  // of another thread.
+  uint64_t tasks = 0;
+  uint64_t steals = 0;
+  // In nanoseconds. The wait time is the time from posting to starting.
+  uint64_t wait_time = 0;
+  uint64_t max_wait_time = 0;
+  uint64_t run_time = 0;
+};
+
+// The task queue of the platform worker threads. Each thread has its own
+// deque of tasks per priority, so that threads do not contend on a single
+// lock. Tasks posted from a worker thread go to the deque of that thread,
+// tasks posted from other threads are spread over the deques round-robin.
+// A thread takes tasks from the front of its own deques, and steals from the
+// back of the other threads' deques when its own are empty.
+class WorkStealingTaskQueue {
+ public:
+  explicit WorkStealingTaskQueue(int thread_count);
+
+  void Push(std::unique_ptr<v8::Task> task, WorkerTaskPriority priority);
+  // Runs tasks on the calling thread, as worker `index`, until Stop().
+  void RunWorkerThread(int index);
+  void BlockingDrain();
+  void Stop();
+
+  WorkerTaskStats GetStats(WorkerTaskPriority priority) const;
+
+ private:
+  struct QueuedTask {
+    std::unique_ptr<v8::Task> task;
+    uint64_t queued_at;
+  };
+
+  struct ThreadQueue {
+    Mutex mutex;
+    std::deque<QueuedTask> lanes[kWorkerTaskPriorityCount];
+  };
+
+  struct LaneStats {
+    std::atomic<uint64_t> tasks { 0 };
+    std::atomic<uint64_t> steals { 0 };
+    std::atomic<uint64_t> wait_time { 0 };
+    std::atomic<uint64_t> max_wait_time { 0 };
+    std::atomic<uint64_t> run_time { 0 };
+  };
+
+  bool TryPop(size_t index, QueuedTask* task, size_t* lane, bool* stolen);
+  void Run(QueuedTask&& task, size_t lane, bool stolen);
+
+  std::vector<std::unique_ptr<ThreadQueue>> queues_;
+  std::atomic<size_t> next_queue_ { 0 };
+  // Tasks that are in one of the deques.
+  std::atomic<size_t> queued_ { 0 };
+  // Tasks that are queued or running, for BlockingDrain().
+  std::atomic<size_t> outstanding_ { 0 };
+
+  Mutex idle_mutex_;
+  ConditionVariable tasks_available_;
+  std::atomic<int> idle_threads_ { 0 };
+  std::atomic<bool> stopped_ { false };
+
+  Mutex drain_mutex_;
+  ConditionVariable tasks_drained_;
+
+  LaneStats stats_[kWorkerTaskPriorityCount];
+};
+
 struct DelayedTask {
   std::unique_ptr<v8::Task> task;
   uv_timer_t timer;
@@ -117,7 +197,8 @@ class WorkerThreadsTaskRunner {
  public:
   explicit WorkerThreadsTaskRunner(int thread_pool_size);
 
-  void PostTask(std::unique_ptr<v8::Task> task);
+  void PostTask(std::unique_ptr<v8::Task> task,
+                WorkerTaskPriority priority = WorkerTaskPriority::kNormal);
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds);
 
@@ -125,9 +206,10 @@ class WorkerThreadsTaskRunner {
   void Shutdown();
 
   int NumberOfWorkerThreads() const;
+  WorkerTaskStats GetStats(WorkerTaskPriority priority) const;
 
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  WorkStealingTaskQueue pending_worker_tasks_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -147,6 +229,9 @@ class NodePlatform : public MultiIsolatePlatform {
   // v8::Platform implementation.
   int NumberOfWorkerThreads() override;
   void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallLowPriorityTaskOnWorkerThread(
+      std::unique_ptr<v8::Task> task) override;
   void CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task,
                                  double delay_in_seconds) override;
   bool IdleTasksEnabled(v8::Isolate* isolate) override;
@@ -168,6 +253,9 @@ class NodePlatform : public MultiIsolatePlatform {
 
   Platform::StackTracePrinter GetStackTracePrinter() override;
 
+  // Statistics about the tasks that ran on the worker threads, for node_perf.
+  WorkerTaskStats GetWorkerTaskStats(WorkerTaskPriority priority) const;
+
  private:
   IsolatePlatformDelegate* ForIsolate(v8::Isolate* isolate);
   std::shared_ptr<PerIsolatePlatformData> ForNodeIsolate(v8::Isolate* isolate);
@@ -0,0 +1,1168 @@
+#include "node_simd.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#define NODE_SIMD_X86 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NODE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NODE_SIMD_TARGET(features) __attribute__((target(features)))
+#else
+#define NODE_SIMD_TARGET(features)
+#endif
+
+namespace node {
+namespace simd {
+
+namespace {
+
+inline unsigned CountTrailingZeros(uint32_t value) {
+#ifdef _MSC_VER
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanForward(&index, value);
+  return index;
+#else
+  return __builtin_ctz(value);
+#endif
+}
+
+inline unsigned CountTrailingZeros64(uint64_t value) {
+  const uint32_t low = static_cast<uint32_t>(value);
+  if (low != 0) return CountTrailingZeros(low);
+  return 32 + CountTrailingZeros(static_cast<uint32_t>(value >> 32));
+}
+
+inline unsigned HighestBit(uint32_t value) {
+#ifdef _MSC_VER
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanReverse(&index, value);
+  return index;
+#else
+  return 31 - __builtin_clz(value);
+#endif
+}
+
+inline unsigned HighestBit64(uint64_t value) {
+  const uint32_t high = static_cast<uint32_t>(value >> 32);
+  if (high != 0) return 32 + HighestBit(high);
+  return HighestBit(static_cast<uint32_t>(value));
+}
+
+// The search kernels first find the positions at which both the first and
+// the last byte of the needle match, and only compare the bytes in between
+// for those. `mask` has a bit set for each such position relative to
+// `haystack`; these helpers return the first or last one that is a match.
+inline bool FirstCandidateMatch(const char* haystack,
+                                const char* needle,
+                                size_t nlen,
+                                uint32_t mask,
+                                size_t* pos) {
+  while (mask != 0) {
+    const unsigned bit = CountTrailingZeros(mask);
+    if (memcmp(haystack + bit + 1, needle + 1, nlen - 2) == 0) {
+      *pos = bit;
+      return true;
+    }
+    mask &= mask - 1;
+  }
+  return false;
+}
+
+inline bool LastCandidateMatch(const char* haystack,
+                               const char* needle,
+                               size_t nlen,
+                               uint32_t mask,
+                               size_t* pos) {
+  while (mask != 0) {
+    const unsigned bit = HighestBit(mask);
+    if (memcmp(haystack + bit + 1, needle + 1, nlen - 2) == 0) {
+      *pos = bit;
+      return true;
+    }
+    mask &= ~(1u << bit);
+  }
+  return false;
+}
+
+// The number of candidate positions in a haystack of `hlen` bytes for which
+// a full block of `width` positions can be checked, given that the last byte
+// of the needle is loaded from `nlen - 1` bytes further in.
+inline size_t SearchableCandidates(size_t hlen, size_t nlen, size_t width) {
+  if (hlen < nlen + width - 1)
+    return 0;
+  const size_t candidates = hlen - nlen + 1;
+  return candidates - candidates % width;
+}
+
+size_t NoBase64Encode(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t NoBase64Decode(char* dst, size_t dlen, const char* src, size_t slen) {
+  return 0;
+}
+
+size_t NoHexEncode(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t NoHexDecode(char* dst, size_t dlen, const char* src, size_t slen) {
+  return 0;
+}
+
+size_t NoAsciiPrefixLength(const char* src, size_t len) {
+  return 0;
+}
+
+size_t NoUtf8Length(const uint16_t* src, size_t len, size_t* utf8_length) {
+  return 0;
+}
+
+bool NoSearch(const char* haystack,
+              size_t hlen,
+              const char* needle,
+              size_t nlen,
+              size_t* pos) {
+  *pos = 0;
+  return false;
+}
+
+// Every UTF-16 code unit takes up three bytes in UTF-8, minus one if it is
+// below 0x800, minus another one if it is below 0x80, and minus two if it is
+// a trail surrogate that completes a pair (which is four bytes in total).
+// The kernels accumulate these corrections in 16-bit lanes, which are flushed
+// before they can overflow.
+constexpr size_t kUtf8LengthBlocksPerFlush = 8192;
+
+#if NODE_SIMD_X86
+
+// Base64 encoding and decoding follow the approach described by Wojciech Muła
+// and Daniel Lemire in "Faster Base64 Encoding and Decoding using AVX2
+// Instructions", with a range-based classifier for decoding so that both the
+// regular and the URL-safe alphabet are accepted, like the scalar decoder.
+
+// Splits 12 input bytes into 16 six-bit indices, one per output byte.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Base64EncodeIndices128(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                         4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+// Maps six-bit indices to the characters of the base64 alphabet.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Base64EncodeLookup128(__m128i indices) {
+  __m128i offset = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  offset = _mm_or_si128(offset, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i shift_lut = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, offset), indices);
+}
+
+// Maps base64 characters to their six-bit values. Bits in `*invalid` are set
+// for every byte that is not part of either base64 alphabet.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Base64DecodeLookup128(__m128i c, uint32_t* invalid) {
+  const __m128i upper =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+  const __m128i lower =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+  const __m128i digit =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+  const __m128i c62 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('+')),
+                                   _mm_cmpeq_epi8(c, _mm_set1_epi8('-')));
+  const __m128i c63 = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('/')),
+                                   _mm_cmpeq_epi8(c, _mm_set1_epi8('_')));
+  const __m128i alnum = _mm_or_si128(_mm_or_si128(upper, lower), digit);
+  const __m128i valid = _mm_or_si128(alnum, _mm_or_si128(c62, c63));
+  *invalid = ~static_cast<uint32_t>(_mm_movemask_epi8(valid)) & 0xffff;
+
+  __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+  shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+  shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+  __m128i values = _mm_and_si128(_mm_add_epi8(c, shift), alnum);
+  values = _mm_or_si128(values, _mm_and_si128(c62, _mm_set1_epi8(62)));
+  return _mm_or_si128(values, _mm_and_si128(c63, _mm_set1_epi8(63)));
+}
+
+// Packs 16 six-bit values into 12 bytes at the start of the vector.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Base64DecodePack128(__m128i values) {
+  const __m128i ab_cd = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i abcd = _mm_madd_epi16(ab_cd, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(abcd, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                              14, 13, 12, -1, -1, -1, -1));
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t Base64EncodeSSSE3(const char* src, size_t slen, char* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  // Each iteration reads 16 bytes but only consumes 12 of them.
+  while (slen - i >= 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     Base64EncodeLookup128(Base64EncodeIndices128(in)));
+    i += 12;
+    k += 16;
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t Base64DecodeSSSE3(char* dst, size_t dlen, const char* src, size_t slen) {
+  size_t i = 0;
+  size_t k = 0;
+  while (slen - i >= 16 && dlen - k >= 12) {
+    uint32_t invalid;
+    const __m128i values = Base64DecodeLookup128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &invalid);
+    alignas(16) char out[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(out),
+                    Base64DecodePack128(values));
+    if (invalid != 0) {
+      const size_t groups = CountTrailingZeros(invalid) / 4;
+      memcpy(dst + k, out, groups * 3);
+      return i + groups * 4;
+    }
+    memcpy(dst + k, out, 12);
+    i += 16;
+    k += 12;
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t Base64EncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i shuffle = _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m256i shift_lut = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  size_t i = 0;
+  size_t k = 0;
+  // Each iteration reads 28 bytes but only consumes 24 of them.
+  while (slen - i >= 28) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    in = _mm256_shuffle_epi8(in, shuffle);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i offset = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    offset =
+        _mm256_or_si256(offset, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i out =
+        _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, offset), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+    i += 24;
+    k += 32;
+  }
+  return i + Base64EncodeSSSE3(src + i, slen - i, dst + k);
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t Base64DecodeAVX2(char* dst, size_t dlen, const char* src, size_t slen) {
+  const __m256i pack_shuffle = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i pack_permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+  size_t i = 0;
+  size_t k = 0;
+  while (slen - i >= 32 && dlen - k >= 24) {
+    const __m256i c =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i upper =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+    const __m256i lower =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+    const __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i c62 =
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('+')),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-')));
+    const __m256i c63 =
+        _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('/')),
+                        _mm256_cmpeq_epi8(c, _mm256_set1_epi8('_')));
+    const __m256i alnum =
+        _mm256_or_si256(_mm256_or_si256(upper, lower), digit);
+    const __m256i valid = _mm256_or_si256(alnum, _mm256_or_si256(c62, c63));
+    const uint32_t invalid =
+        ~static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+
+    __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    shift = _mm256_or_si256(
+        shift, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    shift = _mm256_or_si256(
+        shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    __m256i values = _mm256_and_si256(_mm256_add_epi8(c, shift), alnum);
+    values = _mm256_or_si256(
+        values, _mm256_and_si256(c62, _mm256_set1_epi8(62)));
+    values = _mm256_or_si256(
+        values, _mm256_and_si256(c63, _mm256_set1_epi8(63)));
+
+    const __m256i ab_cd =
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i abcd =
+        _mm256_madd_epi16(ab_cd, _mm256_set1_epi32(0x00011000));
+    const __m256i packed = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(abcd, pack_shuffle), pack_permute);
+
+    alignas(32) char out[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(out), packed);
+    if (invalid != 0) {
+      const size_t groups = CountTrailingZeros(invalid) / 4;
+      memcpy(dst + k, out, groups * 3);
+      return i + groups * 4;
+    }
+    memcpy(dst + k, out, 24);
+    i += 32;
+    k += 24;
+  }
+  return i + Base64DecodeSSSE3(dst + k, dlen - k, src + i, slen - i);
+}
+
+// Maps nibbles (0-15) to lowercase hex characters.
+NODE_SIMD_TARGET("sse2")
+inline __m128i HexEncodeLookup128(__m128i nibbles) {
+  const __m128i letter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+  return _mm_add_epi8(
+      _mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+      _mm_and_si128(letter, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+// Maps hex characters to nibbles. Bits in `*invalid` are set for every byte
+// that is not a hex character.
+NODE_SIMD_TARGET("sse2")
+inline __m128i HexDecodeLookup128(__m128i c, uint32_t* invalid) {
+  const __m128i digit =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+  const __m128i upper =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('F' + 1)));
+  const __m128i lower =
+      _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(c, _mm_set1_epi8('f' + 1)));
+  const __m128i valid = _mm_or_si128(_mm_or_si128(digit, upper), lower);
+  *invalid = ~static_cast<uint32_t>(_mm_movemask_epi8(valid)) & 0xffff;
+
+  __m128i shift = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+  shift = _mm_or_si128(shift, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+  shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+  return _mm_add_epi8(c, shift);
+}
+
+// Combines pairs of nibbles (high nibble first) into bytes, one per 16-bit
+// lane.
+NODE_SIMD_TARGET("sse2")
+inline __m128i HexDecodeCombine128(__m128i nibbles) {
+  return _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4),
+      _mm_srli_epi16(nibbles, 8));
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t HexEncodeSSE2(const char* src, size_t slen, char* dst) {
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; slen - i >= 16; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        HexEncodeLookup128(_mm_and_si128(_mm_srli_epi16(in, 4), mask));
+    const __m128i lo = HexEncodeLookup128(_mm_and_si128(in, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t HexDecodeSSE2(char* dst, size_t dlen, const char* src, size_t slen) {
+  size_t k = 0;
+  while (dlen - k >= 16 && slen / 2 - k >= 16) {
+    uint32_t invalid_lo;
+    uint32_t invalid_hi;
+    const __m128i lo = HexDecodeLookup128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * k)),
+        &invalid_lo);
+    const __m128i hi = HexDecodeLookup128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * k + 16)),
+        &invalid_hi);
+    const __m128i out =
+        _mm_packus_epi16(HexDecodeCombine128(lo), HexDecodeCombine128(hi));
+    const uint32_t invalid = invalid_lo | (invalid_hi << 16);
+    if (invalid != 0) {
+      alignas(16) char tmp[16];
+      _mm_store_si128(reinterpret_cast<__m128i*>(tmp), out);
+      const size_t pairs = CountTrailingZeros(invalid) / 2;
+      memcpy(dst + k, tmp, pairs);
+      return k + pairs;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+    k += 16;
+  }
+  return k;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; slen - i >= 32; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i nibbles[2] = {
+      _mm256_and_si256(_mm256_srli_epi16(in, 4), mask),
+      _mm256_and_si256(in, mask),
+    };
+    for (__m256i& n : nibbles) {
+      const __m256i letter = _mm256_cmpgt_epi8(n, _mm256_set1_epi8(9));
+      n = _mm256_add_epi8(
+          _mm256_add_epi8(n, _mm256_set1_epi8('0')),
+          _mm256_and_si256(letter, _mm256_set1_epi8('a' - '0' - 10)));
+    }
+    // Interleaving works within 128-bit lanes, so the halves need to be
+    // put back in order.
+    const __m256i first = _mm256_unpacklo_epi8(nibbles[0], nibbles[1]);
+    const __m256i second = _mm256_unpackhi_epi8(nibbles[0], nibbles[1]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i + HexEncodeSSE2(src + i, slen - i, dst + 2 * i);
+}
+
+NODE_SIMD_TARGET("avx2")
+inline __m256i HexDecodeLookup256(__m256i c, uint32_t* invalid) {
+  const __m256i digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+  const __m256i upper =
+      _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('F' + 1), c));
+  const __m256i lower =
+      _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), c));
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(digit, upper), lower);
+  *invalid = ~static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+
+  __m256i shift = _mm256_and_si256(digit, _mm256_set1_epi8(-'0'));
+  shift = _mm256_or_si256(
+      shift, _mm256_and_si256(upper, _mm256_set1_epi8(10 - 'A')));
+  shift = _mm256_or_si256(
+      shift, _mm256_and_si256(lower, _mm256_set1_epi8(10 - 'a')));
+  const __m256i nibbles = _mm256_add_epi8(c, shift);
+  return _mm256_or_si256(
+      _mm256_slli_epi16(
+          _mm256_and_si256(nibbles, _mm256_set1_epi16(0x00ff)), 4),
+      _mm256_srli_epi16(nibbles, 8));
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t HexDecodeAVX2(char* dst, size_t dlen, const char* src, size_t slen) {
+  size_t k = 0;
+  while (dlen - k >= 32 && slen / 2 - k >= 32) {
+    uint32_t invalid_lo;
+    uint32_t invalid_hi;
+    const __m256i lo = HexDecodeLookup256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * k)),
+        &invalid_lo);
+    const __m256i hi = HexDecodeLookup256(
+        _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + 2 * k + 32)),
+        &invalid_hi);
+    // Packing works within 128-bit lanes; reorder the 64-bit quarters.
+    const __m256i out =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xd8);
+    const uint64_t invalid =
+        invalid_lo | (static_cast<uint64_t>(invalid_hi) << 32);
+    if (invalid != 0) {
+      alignas(32) char tmp[32];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), out);
+      const size_t pairs = CountTrailingZeros64(invalid) / 2;
+      memcpy(dst + k, tmp, pairs);
+      return k + pairs;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+    k += 32;
+  }
+  if (dlen - k >= 16 && slen / 2 - k >= 16)
+    return k + HexDecodeSSE2(dst + k, dlen - k, src + 2 * k, slen - 2 * k);
+  return k;
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t AsciiPrefixLengthSSE2(const char* src, size_t len) {
+  size_t i = 0;
+  for (; len - i >= 16; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const uint32_t mask = _mm_movemask_epi8(in);
+    if (mask != 0)
+      return i + CountTrailingZeros(mask);
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t AsciiPrefixLengthAVX2(const char* src, size_t len) {
+  size_t i = 0;
+  for (; len - i >= 64; i += 64) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+    if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0) {
+      const uint64_t mask =
+          static_cast<uint32_t>(_mm256_movemask_epi8(a)) |
+          static_cast<uint64_t>(
+              static_cast<uint32_t>(_mm256_movemask_epi8(b))) << 32;
+      return i + CountTrailingZeros64(mask);
+    }
+  }
+  return i + AsciiPrefixLengthSSE2(src + i, len - i);
+}
+
+NODE_SIMD_TARGET("sse2")
+inline __m128i Utf8LengthCorrection128(__m128i units, __m128i previous) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i surrogate_mask = _mm_set1_epi16(static_cast<int16_t>(0xfc00));
+  const __m128i below_80 =
+      _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(
+          static_cast<int16_t>(0xff80))), zero);
+  const __m128i below_800 =
+      _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(
+          static_cast<int16_t>(0xf800))), zero);
+  const __m128i pair = _mm_and_si128(
+      _mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask),
+                      _mm_set1_epi16(static_cast<int16_t>(0xdc00))),
+      _mm_cmpeq_epi16(_mm_and_si128(previous, surrogate_mask),
+                      _mm_set1_epi16(static_cast<int16_t>(0xd800))));
+  return _mm_add_epi16(_mm_add_epi16(below_80, below_800),
+                       _mm_add_epi16(pair, pair));
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t Utf8LengthSSE2(const uint16_t* src, size_t len, size_t* utf8_length) {
+  int64_t correction = 0;
+  size_t i = 0;
+  while (len - i >= 8) {
+    __m128i acc = _mm_setzero_si128();
+    for (size_t n = 0; n < kUtf8LengthBlocksPerFlush && len - i >= 8;
+         ++n, i += 8) {
+      const __m128i units =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      const __m128i previous = i == 0 ?
+          _mm_slli_si128(units, 2) :
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i - 1));
+      acc = _mm_add_epi16(acc, Utf8LengthCorrection128(units, previous));
+    }
+    const __m128i sums = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+    int32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sums);
+    correction += static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] +
+                  lanes[3];
+  }
+  *utf8_length += 3 * i + correction;
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t Utf8LengthAVX2(const uint16_t* src, size_t len, size_t* utf8_length) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i surrogate_mask =
+      _mm256_set1_epi16(static_cast<int16_t>(0xfc00));
+  int64_t correction = 0;
+  size_t i = 0;
+  while (len - i >= 16) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t n = 0; n < kUtf8LengthBlocksPerFlush && len - i >= 16;
+         ++n, i += 16) {
+      const __m256i units =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+      // Shift the units up by one across the two 128-bit lanes.
+      const __m256i previous = i == 0 ?
+          _mm256_alignr_epi8(units,
+                             _mm256_permute2x128_si256(units, units, 0x08),
+                             14) :
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i - 1));
+      const __m256i below_80 =
+          _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(
+              static_cast<int16_t>(0xff80))), zero);
+      const __m256i below_800 =
+          _mm256_cmpeq_epi16(_mm256_and_si256(units, _mm256_set1_epi16(
+              static_cast<int16_t>(0xf800))), zero);
+      const __m256i pair = _mm256_and_si256(
+          _mm256_cmpeq_epi16(_mm256_and_si256(units, surrogate_mask),
+                             _mm256_set1_epi16(static_cast<int16_t>(0xdc00))),
+          _mm256_cmpeq_epi16(_mm256_and_si256(previous, surrogate_mask),
+                             _mm256_set1_epi16(static_cast<int16_t>(0xd800))));
+      acc = _mm256_add_epi16(acc, _mm256_add_epi16(
+          _mm256_add_epi16(below_80, below_800),
+          _mm256_add_epi16(pair, pair)));
+    }
+    const __m256i sums = _mm256_madd_epi16(acc, _mm256_set1_epi16(1));
+    int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    for (int32_t lane : lanes)
+      correction += lane;
+  }
+  *utf8_length += 3 * i + correction;
+  return i;
+}
+
+NODE_SIMD_TARGET("sse2")
+bool IndexOfSSE2(const char* haystack,
+                 size_t hlen,
+                 const char* needle,
+                 size_t nlen,
+                 size_t* pos) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[nlen - 1]);
+  const size_t end = SearchableCandidates(hlen, nlen, 16);
+  for (size_t i = 0; i < end; i += 16) {
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i + nlen - 1));
+    const uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+    if (FirstCandidateMatch(haystack + i, needle, nlen, mask, pos)) {
+      *pos += i;
+      return true;
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+NODE_SIMD_TARGET("sse2")
+bool LastIndexOfSSE2(const char* haystack,
+                     size_t hlen,
+                     const char* needle,
+                     size_t nlen,
+                     size_t* pos) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[nlen - 1]);
+  const size_t candidates = hlen < nlen ? 0 : hlen - nlen + 1;
+  const size_t end = SearchableCandidates(hlen, nlen, 16);
+  for (size_t done = 0; done < end; done += 16) {
+    const size_t i = candidates - done - 16;
+    const __m128i a =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    const __m128i b = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i + nlen - 1));
+    const uint32_t mask = _mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+    if (LastCandidateMatch(haystack + i, needle, nlen, mask, pos)) {
+      *pos += i;
+      return true;
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+NODE_SIMD_TARGET("avx2")
+bool IndexOfAVX2(const char* haystack,
+                 size_t hlen,
+                 const char* needle,
+                 size_t nlen,
+                 size_t* pos) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[nlen - 1]);
+  const size_t end = SearchableCandidates(hlen, nlen, 32);
+  for (size_t i = 0; i < end; i += 32) {
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    const __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i + nlen - 1));
+    const uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+    if (FirstCandidateMatch(haystack + i, needle, nlen, mask, pos)) {
+      *pos += i;
+      return true;
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+NODE_SIMD_TARGET("avx2")
+bool LastIndexOfAVX2(const char* haystack,
+                     size_t hlen,
+                     const char* needle,
+                     size_t nlen,
+                     size_t* pos) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[nlen - 1]);
+  const size_t candidates = hlen < nlen ? 0 : hlen - nlen + 1;
+  const size_t end = SearchableCandidates(hlen, nlen, 32);
+  for (size_t done = 0; done < end; done += 32) {
+    const size_t i = candidates - done - 32;
+    const __m256i a =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+    const __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i + nlen - 1));
+    const uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last)));
+    if (LastCandidateMatch(haystack + i, needle, nlen, mask, pos)) {
+      *pos += i;
+      return true;
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+bool CPUSupports(const char* feature) {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  __cpuid(info, 1);
+  const bool sse2 = (info[3] & (1 << 26)) != 0;
+  const bool ssse3 = (info[2] & (1 << 9)) != 0;
+  const bool osxsave_avx = (info[2] & (3 << 27)) == (3 << 27);
+  bool avx2 = false;
+  if (max_leaf >= 7 && osxsave_avx && (_xgetbv(0) & 6) == 6) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+  if (strcmp(feature, "sse2") == 0) return sse2;
+  if (strcmp(feature, "ssse3") == 0) return ssse3;
+  if (strcmp(feature, "avx2") == 0) return avx2;
+  return false;
+#else
+  __builtin_cpu_init();
+  if (strcmp(feature, "sse2") == 0) return __builtin_cpu_supports("sse2");
+  if (strcmp(feature, "ssse3") == 0) return __builtin_cpu_supports("ssse3");
+  if (strcmp(feature, "avx2") == 0) return __builtin_cpu_supports("avx2");
+  return false;
+#endif
+}
+
+#endif  // NODE_SIMD_X86
+
+#if NODE_SIMD_NEON
+
+// Maps base64 characters to their six-bit values and accumulates the bytes
+// that are not part of either base64 alphabet in `*invalid`.
+inline uint8x16_t Base64DecodeLookupNEON(uint8x16_t c, uint8x16_t* invalid) {
+  const uint8x16_t upper = vandq_u8(vcgeq_u8(c, vdupq_n_u8('A')),
+                                    vcleq_u8(c, vdupq_n_u8('Z')));
+  const uint8x16_t lower = vandq_u8(vcgeq_u8(c, vdupq_n_u8('a')),
+                                    vcleq_u8(c, vdupq_n_u8('z')));
+  const uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')),
+                                    vcleq_u8(c, vdupq_n_u8('9')));
+  const uint8x16_t c62 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('+')),
+                                  vceqq_u8(c, vdupq_n_u8('-')));
+  const uint8x16_t c63 = vorrq_u8(vceqq_u8(c, vdupq_n_u8('/')),
+                                  vceqq_u8(c, vdupq_n_u8('_')));
+  const uint8x16_t alnum = vorrq_u8(vorrq_u8(upper, lower), digit);
+  const uint8x16_t valid = vorrq_u8(alnum, vorrq_u8(c62, c63));
+  *invalid = vorrq_u8(*invalid, vmvnq_u8(valid));
+
+  uint8x16_t shift = vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(-'A')));
+  shift = vorrq_u8(shift,
+                   vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(26 - 'a'))));
+  shift = vorrq_u8(shift,
+                   vandq_u8(digit, vdupq_n_u8(static_cast<uint8_t>(52 - '0'))));
+  uint8x16_t values = vandq_u8(vaddq_u8(c, shift), alnum);
+  values = vorrq_u8(values, vandq_u8(c62, vdupq_n_u8(62)));
+  return vorrq_u8(values, vandq_u8(c63, vdupq_n_u8(63)));
+}
+
+// Maps hex characters to nibbles and accumulates the bytes that are not hex
+// characters in `*invalid`.
+inline uint8x16_t HexDecodeLookupNEON(uint8x16_t c, uint8x16_t* invalid) {
+  const uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')),
+                                    vcleq_u8(c, vdupq_n_u8('9')));
+  const uint8x16_t upper = vandq_u8(vcgeq_u8(c, vdupq_n_u8('A')),
+                                    vcleq_u8(c, vdupq_n_u8('F')));
+  const uint8x16_t lower = vandq_u8(vcgeq_u8(c, vdupq_n_u8('a')),
+                                    vcleq_u8(c, vdupq_n_u8('f')));
+  *invalid = vorrq_u8(*invalid,
+                      vmvnq_u8(vorrq_u8(vorrq_u8(digit, upper), lower)));
+
+  uint8x16_t shift = vandq_u8(digit, vdupq_n_u8(static_cast<uint8_t>(-'0')));
+  shift = vorrq_u8(shift,
+                   vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(10 - 'A'))));
+  shift = vorrq_u8(shift,
+                   vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(10 - 'a'))));
+  return vaddq_u8(c, shift);
+}
+
+size_t Base64EncodeNEON(const char* src, size_t slen, char* dst) {
+  static const uint8_t kAlphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  uint8x16x4_t alphabet;
+  alphabet.val[0] = vld1q_u8(kAlphabet);
+  alphabet.val[1] = vld1q_u8(kAlphabet + 16);
+  alphabet.val[2] = vld1q_u8(kAlphabet + 32);
+  alphabet.val[3] = vld1q_u8(kAlphabet + 48);
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+  size_t i = 0;
+  size_t k = 0;
+  for (; slen - i >= 48; i += 48, k += 64) {
+    const uint8x16x3_t bytes = vld3q_u8(in + i);
+    uint8x16x4_t chars;
+    chars.val[0] = vshrq_n_u8(bytes.val[0], 2);
+    chars.val[1] = vorrq_u8(
+        vshlq_n_u8(vandq_u8(bytes.val[0], vdupq_n_u8(0x03)), 4),
+        vshrq_n_u8(bytes.val[1], 4));
+    chars.val[2] = vorrq_u8(
+        vshlq_n_u8(vandq_u8(bytes.val[1], vdupq_n_u8(0x0f)), 2),
+        vshrq_n_u8(bytes.val[2], 6));
+    chars.val[3] = vandq_u8(bytes.val[2], vdupq_n_u8(0x3f));
+    chars.val[0] = vqtbl4q_u8(alphabet, chars.val[0]);
+    chars.val[1] = vqtbl4q_u8(alphabet, chars.val[1]);
+    chars.val[2] = vqtbl4q_u8(alphabet, chars.val[2]);
+    chars.val[3] = vqtbl4q_u8(alphabet, chars.val[3]);
+    vst4q_u8(out + k, chars);
+  }
+  return i;
+}
+
+size_t Base64DecodeNEON(char* dst, size_t dlen, const char* src, size_t slen) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+  size_t i = 0;
+  size_t k = 0;
+  // Blocks that contain anything but base64 characters are left to the
+  // scalar decoder in their entirety.
+  for (; slen - i >= 64 && dlen - k >= 48; i += 64, k += 48) {
+    const uint8x16x4_t chars = vld4q_u8(in + i);
+    uint8x16_t invalid = vdupq_n_u8(0);
+    const uint8x16_t a = Base64DecodeLookupNEON(chars.val[0], &invalid);
+    const uint8x16_t b = Base64DecodeLookupNEON(chars.val[1], &invalid);
+    const uint8x16_t c = Base64DecodeLookupNEON(chars.val[2], &invalid);
+    const uint8x16_t d = Base64DecodeLookupNEON(chars.val[3], &invalid);
+    if (vmaxvq_u8(invalid) != 0)
+      break;
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+    vst3q_u8(out + k, bytes);
+  }
+  return i;
+}
+
+size_t HexEncodeNEON(const char* src, size_t slen, char* dst) {
+  static const uint8_t kDigits[] = "0123456789abcdef";
+  const uint8x16_t digits = vld1q_u8(kDigits);
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+  size_t i = 0;
+  for (; slen - i >= 16; i += 16) {
+    const uint8x16_t bytes = vld1q_u8(in + i);
+    uint8x16x2_t chars;
+    chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+    chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0f)));
+    vst2q_u8(out + 2 * i, chars);
+  }
+  return i;
+}
+
+size_t HexDecodeNEON(char* dst, size_t dlen, const char* src, size_t slen) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+  size_t k = 0;
+  for (; dlen - k >= 16 && slen / 2 - k >= 16; k += 16) {
+    const uint8x16x2_t chars = vld2q_u8(in + 2 * k);
+    uint8x16_t invalid = vdupq_n_u8(0);
+    const uint8x16_t hi = HexDecodeLookupNEON(chars.val[0], &invalid);
+    const uint8x16_t lo = HexDecodeLookupNEON(chars.val[1], &invalid);
+    if (vmaxvq_u8(invalid) != 0)
+      break;
+    vst1q_u8(out + k, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  }
+  return k;
+}
+
+size_t AsciiPrefixLengthNEON(const char* src, size_t len) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  for (; len - i >= 32; i += 32) {
+    const uint8x16_t bytes = vorrq_u8(vld1q_u8(in + i), vld1q_u8(in + i + 16));
+    if (vmaxvq_u8(bytes) >= 0x80)
+      break;
+  }
+  return i;
+}
+
+size_t Utf8LengthNEON(const uint16_t* src, size_t len, size_t* utf8_length) {
+  const uint16x8_t surrogate_mask = vdupq_n_u16(0xfc00);
+  uint64_t extra = 0;
+  uint16x8_t previous = vdupq_n_u16(0);
+  size_t i = 0;
+  while (len - i >= 8) {
+    uint16x8_t acc = vdupq_n_u16(0);
+    for (size_t n = 0; n < kUtf8LengthBlocksPerFlush && len - i >= 8;
+         ++n, i += 8) {
+      const uint16x8_t units = vld1q_u16(src + i);
+      const uint16x8_t before = vextq_u16(previous, units, 7);
+      const uint16x8_t pair = vandq_u16(
+          vceqq_u16(vandq_u16(units, surrogate_mask), vdupq_n_u16(0xdc00)),
+          vceqq_u16(vandq_u16(before, surrogate_mask), vdupq_n_u16(0xd800)));
+      // The comparison results are all ones, i.e. -1, when they match.
+      acc = vsubq_u16(acc, vcgeq_u16(units, vdupq_n_u16(0x80)));
+      acc = vsubq_u16(acc, vcgeq_u16(units, vdupq_n_u16(0x800)));
+      acc = vaddq_u16(acc, vaddq_u16(pair, pair));
+      previous = units;
+    }
+    extra += vaddlvq_u16(acc);
+  }
+  *utf8_length += i + extra;
+  return i;
+}
+
+// Narrows the per-byte comparison results in `matches` into a 64-bit mask
+// with four bits per byte.
+inline uint64_t SearchMaskNEON(uint8x16_t matches) {
+  return vget_lane_u64(vreinterpret_u64_u8(
+      vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+bool IndexOfNEON(const char* haystack,
+                 size_t hlen,
+                 const char* needle,
+                 size_t nlen,
+                 size_t* pos) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(haystack);
+  const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+  const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[nlen - 1]));
+  const size_t end = SearchableCandidates(hlen, nlen, 16);
+  for (size_t i = 0; i < end; i += 16) {
+    uint64_t mask = SearchMaskNEON(vandq_u8(
+        vceqq_u8(vld1q_u8(in + i), first),
+        vceqq_u8(vld1q_u8(in + i + nlen - 1), last)));
+    while (mask != 0) {
+      const unsigned bit = CountTrailingZeros64(mask) / 4;
+      if (memcmp(haystack + i + bit + 1, needle + 1, nlen - 2) == 0) {
+        *pos = i + bit;
+        return true;
+      }
+      mask &= ~(uint64_t{0xf} << (4 * bit));
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+bool LastIndexOfNEON(const char* haystack,
+                     size_t hlen,
+                     const char* needle,
+                     size_t nlen,
+                     size_t* pos) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(haystack);
+  const uint8x16_t first = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+  const uint8x16_t last = vdupq_n_u8(static_cast<uint8_t>(needle[nlen - 1]));
+  const size_t candidates = hlen < nlen ? 0 : hlen - nlen + 1;
+  const size_t end = SearchableCandidates(hlen, nlen, 16);
+  for (size_t done = 0; done < end; done += 16) {
+    const size_t i = candidates - done - 16;
+    uint64_t mask = SearchMaskNEON(vandq_u8(
+        vceqq_u8(vld1q_u8(in + i), first),
+        vceqq_u8(vld1q_u8(in + i + nlen - 1), last)));
+    while (mask != 0) {
+      const unsigned bit = HighestBit64(mask) / 4;
+      if (memcmp(haystack + i + bit + 1, needle + 1, nlen - 2) == 0) {
+        *pos = i + bit;
+        return true;
+      }
+      mask &= ~(uint64_t{0xf} << (4 * bit));
+    }
+  }
+  *pos = end;
+  return false;
+}
+
+#endif  // NODE_SIMD_NEON
+
+struct Kernels {
+  const char* name;
+  size_t (*base64_encode)(const char* src, size_t slen, char* dst);
+  size_t (*base64_decode)(char* dst, size_t dlen, const char* src, size_t slen);
+  size_t (*hex_encode)(const char* src, size_t slen, char* dst);
+  size_t (*hex_decode)(char* dst, size_t dlen, const char* src, size_t slen);
+  size_t (*ascii_prefix_length)(const char* src, size_t len);
+  size_t (*utf8_length)(const uint16_t* src, size_t len, size_t* utf8_length);
+  bool (*index_of)(const char* haystack,
+                   size_t hlen,
+                   const char* needle,
+                   size_t nlen,
+                   size_t* pos);
+  bool (*last_index_of)(const char* haystack,
+                        size_t hlen,
+                        const char* needle,
+                        size_t nlen,
+                        size_t* pos);
+};
+
+Kernels SelectKernels() {
+  Kernels kernels = {
+    "scalar",
+    NoBase64Encode,
+    NoBase64Decode,
+    NoHexEncode,
+    NoHexDecode,
+    NoAsciiPrefixLength,
+    NoUtf8Length,
+    NoSearch,
+    NoSearch,
+  };
+#if NODE_SIMD_X86
+  if (CPUSupports("sse2")) {
+    kernels.name = "sse2";
+    kernels.hex_encode = HexEncodeSSE2;
+    kernels.hex_decode = HexDecodeSSE2;
+    kernels.ascii_prefix_length = AsciiPrefixLengthSSE2;
+    kernels.utf8_length = Utf8LengthSSE2;
+    kernels.index_of = IndexOfSSE2;
+    kernels.last_index_of = LastIndexOfSSE2;
+  }
+  if (CPUSupports("ssse3")) {
+    kernels.name = "ssse3";
+    kernels.base64_encode = Base64EncodeSSSE3;
+    kernels.base64_decode = Base64DecodeSSSE3;
+  }
+  if (CPUSupports("avx2")) {
+    kernels.name = "avx2";
+    kernels.base64_encode = Base64EncodeAVX2;
+    kernels.base64_decode = Base64DecodeAVX2;
+    kernels.hex_encode = HexEncodeAVX2;
+    kernels.hex_decode = HexDecodeAVX2;
+    kernels.ascii_prefix_length = AsciiPrefixLengthAVX2;
+    kernels.utf8_length = Utf8LengthAVX2;
+    kernels.index_of = IndexOfAVX2;
+    kernels.last_index_of = LastIndexOfAVX2;
+  }
+#elif NODE_SIMD_NEON
+  kernels.name = "neon";
+  kernels.base64_encode = Base64EncodeNEON;
+  kernels.base64_decode = Base64DecodeNEON;
+  kernels.hex_encode = HexEncodeNEON;
+  kernels.hex_decode = HexDecodeNEON;
+  kernels.ascii_prefix_length = AsciiPrefixLengthNEON;
+  kernels.utf8_length = Utf8LengthNEON;
+  kernels.index_of = IndexOfNEON;
+  kernels.last_index_of = LastIndexOfNEON;
+#endif
+  return kernels;
+}
+
+inline const Kernels& GetKernels() {
+  static const Kernels kernels = SelectKernels();
+  return kernels;
+}
+
+}  // anonymous namespace
+
+size_t Base64Encode(const char* src, size_t slen, char* dst) {
+  return GetKernels().base64_encode(src, slen, dst);
+}
+
+size_t Base64Decode(char* dst, size_t dlen, const char* src, size_t slen) {
+  return GetKernels().base64_decode(dst, dlen, src, slen);
+}
+
+size_t HexEncode(const char* src, size_t slen, char* dst) {
+  return GetKernels().hex_encode(src, slen, dst);
+}
+
+size_t HexDecode(char* dst, size_t dlen, const char* src, size_t slen) {
+  return GetKernels().hex_decode(dst, dlen, src, slen);
+}
+
+size_t AsciiPrefixLength(const char* src, size_t len) {
+  return GetKernels().ascii_prefix_length(src, len);
+}
+
+size_t Utf8Length(const uint16_t* src, size_t len) {
+  size_t length = 0;
+  size_t i = GetKernels().utf8_length(src, len, &length);
+  for (; i < len; ++i) {
+    const uint16_t c = src[i];
+    if (c < 0x80) {
+      length += 1;
+    } else if (c < 0x800) {
+      length += 2;
+    } else if ((c & 0xfc00) == 0xdc00 && i > 0 &&
+               (src[i - 1] & 0xfc00) == 0xd800) {
+      // The lead surrogate has already been counted as three bytes.
+      length += 1;
+    } else {
+      length += 3;
+    }
+  }
+  return length;
+}
+
+bool IndexOf(const char* haystack,
+             size_t hlen,
+             const char* needle,
+             size_t nlen,
+             size_t* pos) {
+  return GetKernels().index_of(haystack, hlen, needle, nlen, pos);
+}
+
+bool LastIndexOf(const char* haystack,
+                 size_t hlen,
+                 const char* needle,
+                 size_t nlen,
+                 size_t* pos) {
+  return GetKernels().last_index_of(haystack, hlen, needle, nlen, pos);
+}
+
+const char* GetImplementationName() {
+  return GetKernels().name;
+}
+
+}  // namespace simd
+}  // namespace node
@@ -0,0 +1,77 @@
+#ifndef SRC_NODE_SIMD_H_
+#define SRC_NODE_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <cstdint>
+
+namespace node {
+namespace simd {
+
+// Vectorized kernels for the string encoders and decoders. The implementation
+// is picked once per process based on the CPU features that are available at
+// runtime (SSSE3/AVX2 on x86, NEON on arm64).
+//
+// Every kernel only handles a prefix of its input and returns how far it got;
+// the caller is expected to finish the remainder with its scalar code. On
+// CPUs without a suitable vector unit the kernels simply return 0.
+
+// Encodes groups of three bytes from `src` into four base64 characters in
+// `dst`. Returns the number of bytes consumed from `src`, which is always a
+// multiple of three; `dst` receives four characters per three bytes.
+size_t Base64Encode(const char* src, size_t slen, char* dst);
+
+// Decodes groups of four (regular or URL-safe) base64 characters from `src`
+// and stops before the first group that contains any other character, such
+// as whitespace or padding. Returns the number of characters consumed, which
+// is always a multiple of four; three bytes per group are written to `dst`,
+// and never more than `dlen` bytes in total.
+size_t Base64Decode(char* dst, size_t dlen, const char* src, size_t slen);
+
+// Encodes bytes from `src` as lowercase hex characters in `dst`. Returns the
+// number of bytes consumed from `src`; `dst` receives two characters each.
+size_t HexEncode(const char* src, size_t slen, char* dst);
+
+// Decodes pairs of hex characters from `src` and stops before the first pair
+// that contains a non-hex character. Returns the number of bytes written to
+// `dst`, which is never more than `dlen`.
+size_t HexDecode(char* dst, size_t dlen, const char* src, size_t slen);
+
+// Returns the length of a prefix of `src` that consists of ASCII characters
+// only. The scan may stop a few bytes short of the first non-ASCII byte.
+size_t AsciiPrefixLength(const char* src, size_t len);
+
+// Returns the number of bytes that the UTF-16 data in `src` takes up when it
+// is encoded as UTF-8, counting unpaired surrogates as three bytes each (the
+// size of U+FFFD). Unlike the kernels above, this always covers all of `src`.
+size_t Utf8Length(const uint16_t* src, size_t len);
+
+// Looks for `needle`, which must be at least two bytes long, at the positions
+// in `haystack` that the kernel can check in full vector blocks. Returns true
+// and sets `*pos` to the first match if there is one among them. Otherwise,
+// returns false and sets `*pos` to the number of leading positions that have
+// been ruled out.
+bool IndexOf(const char* haystack,
+             size_t hlen,
+             const char* needle,
+             size_t nlen,
+             size_t* pos);
+
+// Like IndexOf(), but looks for the last match. When there is none, `*pos`
+// is the number of trailing positions that have been ruled out.
+bool LastIndexOf(const char* haystack,
+                 size_t hlen,
+                 const char* needle,
+                 size_t nlen,
+                 size_t* pos);
+
+// Returns the name of the selected implementation, e.g. "avx2" or "scalar".
+const char* GetImplementationName();
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SIMD_H_
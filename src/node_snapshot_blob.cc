@@ -0,0 +1,92 @@
+#include "node_snapshot_blob.h"
+#include "blob_serializer.h"
+#include "debug_utils-inl.h"
+#include "node_internals.h"
+#include "node_version.h"
+#include "util-inl.h"
+
+#include <cstring>
+
+namespace node {
+
+using v8::StartupData;
+
+namespace {
+
+constexpr char kMagic[] = "NODESNAP";
+constexpr size_t kMagicLength = sizeof(kMagic) - 1;
+constexpr uint32_t kFormatVersion = 1;
+
+}  // anonymous namespace
+
+void SnapshotBlob::Assign(const StartupData& blob,
+                          const std::vector<size_t>& isolate_data_indexes) {
+  data_.assign(blob.data, blob.raw_size);
+  isolate_data_indexes_ = isolate_data_indexes;
+  startup_data_ = { data_.data(), static_cast<int>(data_.size()) };
+}
+
+std::string SnapshotBlob::Serialize() const {
+  std::string out(kMagic, kMagicLength);
+  BlobWrite<uint32_t>(&out, kFormatVersion);
+  BlobWriteString(&out, NODE_VERSION, strlen(NODE_VERSION));
+  BlobWriteString(&out, v8::V8::GetVersion(), strlen(v8::V8::GetVersion()));
+  BlobWrite<uint32_t>(&out,
+                      static_cast<uint32_t>(isolate_data_indexes_.size()));
+  for (size_t index : isolate_data_indexes_)
+    BlobWrite<uint64_t>(&out, index);
+  BlobWriteString(&out, data_);
+  return out;
+}
+
+std::string SnapshotBlob::ReadFromFile(const std::string& path) {
+  std::string contents;
+  int err = ReadFileSync(&contents, path.c_str());
+  if (err != 0) {
+    return SPrintF("Cannot read snapshot blob: %s", uv_strerror(err));
+  }
+
+  BlobReader reader(contents);
+  const char* magic;
+  uint32_t format_version;
+  if (!reader.ReadBytes(kMagicLength, &magic) ||
+      memcmp(magic, kMagic, kMagicLength) != 0 ||
+      !reader.Read(&format_version) ||
+      format_version != kFormatVersion) {
+    return "Not a Node.js snapshot blob";
+  }
+
+  std::string node_version;
+  std::string v8_version;
+  if (!reader.ReadString(&node_version) || !reader.ReadString(&v8_version))
+    return "Snapshot blob is malformed";
+  if (node_version != NODE_VERSION ||
+      v8_version != v8::V8::GetVersion()) {
+    return SPrintF("Snapshot blob was built by Node.js %s (V8 %s), which "
+                   "does not match Node.js %s (V8 %s)",
+                   node_version, v8_version,
+                   NODE_VERSION, v8::V8::GetVersion());
+  }
+
+  uint32_t index_count;
+  if (!reader.ReadCount(&index_count))
+    return "Snapshot blob is malformed";
+  std::vector<size_t> indexes;
+  for (uint32_t i = 0; i < index_count; i++) {
+    uint64_t index;
+    if (!reader.Read(&index))
+      return "Snapshot blob is malformed";
+    indexes.push_back(static_cast<size_t>(index));
+  }
+
+  std::string data;
+  if (!reader.ReadString(&data) || !reader.AtEnd())
+    return "Snapshot blob is malformed";
+
+  data_ = std::move(data);
+  isolate_data_indexes_ = std::move(indexes);
+  startup_data_ = { data_.data(), static_cast<int>(data_.size()) };
+  return "";
+}
+
+}  // namespace node
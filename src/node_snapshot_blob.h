@@ -0,0 +1,48 @@
+#ifndef SRC_NODE_SNAPSHOT_BLOB_H_
+#define SRC_NODE_SNAPSHOT_BLOB_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "v8.h"
+
+namespace node {
+
+// A startup snapshot that is kept in a file rather than embedded into the
+// binary. It is written by `node_mksnapshot --blob` and loaded at startup
+// with --snapshot-blob. Besides the V8 startup data, it records the per-Isolate
+// data indexes and the Node.js and V8 versions that it was built with, since
+// V8 cannot deserialize snapshots from other builds.
+class SnapshotBlob {
+ public:
+  SnapshotBlob() = default;
+
+  // Takes a copy of the V8 startup data.
+  void Assign(const v8::StartupData& blob,
+              const std::vector<size_t>& isolate_data_indexes);
+  // Returns an empty string on success, or a description of the error.
+  std::string ReadFromFile(const std::string& path);
+  // Returns the contents of the file that ReadFromFile() accepts.
+  std::string Serialize() const;
+
+  v8::StartupData* startup_data() { return &startup_data_; }
+  const std::vector<size_t>* isolate_data_indexes() const {
+    return &isolate_data_indexes_;
+  }
+
+  SnapshotBlob(const SnapshotBlob&) = delete;
+  SnapshotBlob& operator=(const SnapshotBlob&) = delete;
+
+ private:
+  std::string data_;
+  v8::StartupData startup_data_ = { nullptr, 0 };
+  std::vector<size_t> isolate_data_indexes_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_SNAPSHOT_BLOB_H_
@@ -5,6 +5,7 @@
 #include "node_buffer.h"
 #include "node_options-inl.h"
 #include "node_perf.h"
+#include "threadpoolwork-inl.h"
 #include "util-inl.h"
 #include "async_wrap-inl.h"
 
@@ -12,6 +13,7 @@
 #include "inspector/worker_inspector.h"  // ParentInspectorHandle
 #endif
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,7 +28,9 @@ using v8::Context;
 using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
+using v8::HeapStatistics;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
@@ -134,8 +138,14 @@ void Worker::UpdateResourceConstraints(ResourceConstraints* constraints) {
 class WorkerThreadData {
  public:
   explicit WorkerThreadData(Worker* w)
-    : w_(w) {
-    int ret = uv_loop_init(&loop_);
+    : w_(w), warm_(std::move(w->warm_isolate_)) {
+    if (warm_) {
+      AdoptWarmIsolate();
+      return;
+    }
+
+    loop_ = &own_loop_;
+    int ret = uv_loop_init(loop_);
     if (ret != 0) {
       char err_buf[128];
       uv_err_name_r(ret, err_buf, sizeof(err_buf));
@@ -162,7 +172,7 @@ class WorkerThreadData {
       return;
     }
 
-    w->platform_->RegisterIsolate(isolate, &loop_);
+    w->platform_->RegisterIsolate(isolate, loop_);
     Isolate::Initialize(isolate, params);
     SetIsolateUpForNode(isolate);
 
@@ -177,7 +187,7 @@ class WorkerThreadData {
 
       HandleScope handle_scope(isolate);
       isolate_data_.reset(CreateIsolateData(isolate,
-                                            &loop_,
+                                            loop_,
                                             w_->platform_,
                                             allocator.get()));
       CHECK(isolate_data_);
@@ -201,6 +211,10 @@ class WorkerThreadData {
     if (isolate != nullptr) {
       bool platform_finished = false;
 
+      if (!warm_context_.IsEmpty()) {
+        Locker locker(isolate);
+        warm_context_.Reset();
+      }
       isolate_data_.reset();
 
       w_->platform_->AddIsolateFinishedCallback(isolate, [](void* data) {
@@ -218,18 +232,52 @@ class WorkerThreadData {
       // Wait until the platform has cleaned up all relevant resources.
       while (!platform_finished) {
         CHECK(!w_->loop_init_failed_);
-        uv_run(&loop_, UV_RUN_ONCE);
+        uv_run(loop_, UV_RUN_ONCE);
       }
     }
     if (!w_->loop_init_failed_) {
-      CheckedUvLoopClose(&loop_);
+      CheckedUvLoopClose(loop_);
     }
   }
 
  private:
+  // Take over an Isolate that was set up by a WorkerIsolatePool. Everything
+  // that depends on the Worker itself is done here, on the worker thread.
+  void AdoptWarmIsolate() {
+    // This is what the Isolate was created with, but the values still need to
+    // be reported as the Worker's resource limits.
+    Isolate::CreateParams params;
+    SetIsolateCreateParamsForNode(&params);
+    w_->UpdateResourceConstraints(&params.constraints);
+
+    loop_ = &warm_->loop;
+    Isolate* isolate = warm_->isolate;
+    isolate->AddNearHeapLimitCallback(Worker::NearHeapLimit, w_);
+
+    {
+      Locker locker(isolate);
+      Isolate::Scope isolate_scope(isolate);
+      // As above, reset the stack limit that V8 computed for this thread.
+      isolate->SetStackLimit(w_->stack_base_);
+
+      isolate_data_ = std::move(warm_->isolate_data);
+      warm_context_ = std::move(warm_->context);
+      if (w_->per_isolate_opts_)
+        isolate_data_->set_options(std::move(w_->per_isolate_opts_));
+    }
+
+    Mutex::ScopedLock lock(w_->mutex_);
+    w_->isolate_ = isolate;
+  }
+
   Worker* const w_;
-  uv_loop_t loop_;
+  // Only set if the Isolate came from a WorkerIsolatePool. In that case,
+  // this also holds the event loop.
+  std::unique_ptr<WarmIsolate> warm_;
+  uv_loop_t own_loop_;
+  uv_loop_t* loop_;
   DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data_;
+  Global<Context> warm_context_;
 
   friend class Worker;
 };
@@ -302,7 +350,12 @@ void Worker::Run() {
         // resource constraints, we need something in place to handle it,
         // though.
         TryCatch try_catch(isolate_);
-        context = NewContext(isolate_);
+        if (!data.warm_context_.IsEmpty()) {
+          context = data.warm_context_.Get(isolate_);
+          data.warm_context_.Reset();
+        } else {
+          context = NewContext(isolate_);
+        }
         if (context.IsEmpty()) {
           custom_error_ = "ERR_WORKER_OUT_OF_MEMORY";
           custom_error_str_ = "Failed to create new Context";
@@ -361,19 +414,19 @@ void Worker::Run() {
             node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_START);
         do {
           if (is_stopped()) break;
-          uv_run(&data.loop_, UV_RUN_DEFAULT);
+          uv_run(data.loop_, UV_RUN_DEFAULT);
           if (is_stopped()) break;
 
           platform_->DrainTasks(isolate_);
 
-          more = uv_loop_alive(&data.loop_);
+          more = uv_loop_alive(data.loop_);
           if (more && !is_stopped()) continue;
 
           EmitBeforeExit(env_.get());
 
           // Emit `beforeExit` if the loop became alive either after emitting
           // event, or after running some callbacks.
-          more = uv_loop_alive(&data.loop_);
+          more = uv_loop_alive(data.loop_);
         } while (more == true && !is_stopped());
         env_->performance_state()->Mark(
             node::performance::NODE_PERFORMANCE_MILESTONE_LOOP_EXIT);
@@ -617,6 +670,15 @@ void Worker::StartThread(const FunctionCallbackInfo<Value>& args) {
   w->stopped_ = false;
   w->thread_joined_ = false;
 
+  // Pooled Isolates are created with the default resource constraints.
+  WorkerIsolatePool* pool = w->env()->worker_isolate_pool();
+  if (pool != nullptr &&
+      std::all_of(std::begin(w->resource_limits_),
+                  std::end(w->resource_limits_),
+                  [](double limit) { return limit <= 0; })) {
+    w->warm_isolate_ = pool->Take();
+  }
+
   if (w->has_ref_)
     w->env()->add_refs(1);
 
@@ -703,6 +765,140 @@ void Worker::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("parent_port", parent_port_);
 }
 
+namespace {
+
+// This runs on the threadpool, so nothing in here may depend on the
+// Environment that the pool belongs to.
+std::unique_ptr<WarmIsolate> CreateWarmIsolate(MultiIsolatePlatform* platform) {
+  std::unique_ptr<WarmIsolate> warm = std::make_unique<WarmIsolate>();
+  if (uv_loop_init(&warm->loop) != 0)
+    return nullptr;
+
+  std::shared_ptr<ArrayBufferAllocator> allocator =
+      ArrayBufferAllocator::Create();
+  Isolate::CreateParams params;
+  SetIsolateCreateParamsForNode(&params);
+  params.array_buffer_allocator_shared = allocator;
+
+  Isolate* isolate = Isolate::Allocate();
+  if (isolate == nullptr) {
+    CheckedUvLoopClose(&warm->loop);
+    return nullptr;
+  }
+
+  platform->RegisterIsolate(isolate, &warm->loop);
+  Isolate::Initialize(isolate, params);
+  SetIsolateUpForNode(isolate);
+  warm->isolate = isolate;
+
+  Locker locker(isolate);
+  Isolate::Scope isolate_scope(isolate);
+  HandleScope handle_scope(isolate);
+  warm->isolate_data.reset(
+      CreateIsolateData(isolate, &warm->loop, platform, allocator.get()));
+  CHECK(warm->isolate_data);
+
+  // If this fails, the Worker that gets this Isolate creates the Context
+  // itself and reports the error.
+  TryCatch try_catch(isolate);
+  Local<Context> context = NewContext(isolate);
+  if (!context.IsEmpty())
+    warm->context.Reset(isolate, context);
+
+  HeapStatistics heap_statistics;
+  isolate->GetHeapStatistics(&heap_statistics);
+  warm->heap_size = heap_statistics.total_heap_size();
+  return warm;
+}
+
+void DisposeWarmIsolate(MultiIsolatePlatform* platform,
+                        std::unique_ptr<WarmIsolate> warm) {
+  Isolate* isolate = warm->isolate;
+  {
+    Locker locker(isolate);
+    warm->context.Reset();
+    warm->isolate_data.reset();
+  }
+
+  // See ~WorkerThreadData() for why this happens in this order.
+  bool platform_finished = false;
+  platform->AddIsolateFinishedCallback(isolate, [](void* data) {
+    *static_cast<bool*>(data) = true;
+  }, &platform_finished);
+  platform->UnregisterIsolate(isolate);
+  isolate->Dispose();
+  while (!platform_finished)
+    uv_run(&warm->loop, UV_RUN_ONCE);
+  CheckedUvLoopClose(&warm->loop);
+}
+
+}  // anonymous namespace
+
+class WorkerIsolatePool::CreateIsolateWork : public ThreadPoolWork {
+ public:
+  CreateIsolateWork(Environment* env, WorkerIsolatePool* pool)
+    : ThreadPoolWork(env),
+      pool_(pool),
+      platform_(env->isolate_data()->platform()) {}
+
+  void DoThreadPoolWork() override {
+    warm_ = CreateWarmIsolate(platform_);
+  }
+
+  void AfterThreadPoolWork(int status) override {
+    std::unique_ptr<CreateIsolateWork> self(this);
+    pool_->pending_--;
+    // Stop once an Isolate could not be created, rather than retrying
+    // forever while memory is short.
+    if (!warm_) return;
+    pool_->isolates_.emplace_back(std::move(warm_));
+    pool_->Fill();
+  }
+
+ private:
+  WorkerIsolatePool* const pool_;
+  MultiIsolatePlatform* const platform_;
+  std::unique_ptr<WarmIsolate> warm_;
+};
+
+WorkerIsolatePool::WorkerIsolatePool(Environment* env, size_t size)
+    : env_(env), size_(size) {
+  Fill();
+}
+
+WorkerIsolatePool::~WorkerIsolatePool() {
+  // The Environment waits for all threadpool work before it goes away.
+  CHECK_EQ(pending_, 0);
+  for (std::unique_ptr<WarmIsolate>& warm : isolates_)
+    DisposeWarmIsolate(env_->isolate_data()->platform(), std::move(warm));
+}
+
+std::unique_ptr<WarmIsolate> WorkerIsolatePool::Take() {
+  if (isolates_.empty()) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  std::unique_ptr<WarmIsolate> warm = std::move(isolates_.back());
+  isolates_.pop_back();
+  Fill();
+  return warm;
+}
+
+void WorkerIsolatePool::Fill() {
+  if (!env_->can_call_into_js())
+    return;
+  while (isolates_.size() + pending_ < size_) {
+    pending_++;
+    (new CreateIsolateWork(env_, this))->ScheduleWork();
+  }
+}
+
+void WorkerIsolatePool::MemoryInfo(MemoryTracker* tracker) const {
+  for (const std::unique_ptr<WarmIsolate>& warm : isolates_)
+    tracker->TrackFieldWithSize("isolate", warm->heap_size, "WarmIsolate");
+}
+
 class WorkerHeapSnapshotTaker : public AsyncWrap {
  public:
   WorkerHeapSnapshotTaker(Environment* env, Local<Object> obj)
@@ -763,6 +959,21 @@ void GetEnvMessagePort(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Returns [ready, hits, misses] for the WorkerIsolatePool of this
+// Environment, or undefined if it does not have one.
+void GetIsolatePoolStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  WorkerIsolatePool* pool = env->worker_isolate_pool();
+  if (pool == nullptr) return;
+  Local<Value> stats[] = {
+    Number::New(env->isolate(), static_cast<double>(pool->ready())),
+    Number::New(env->isolate(), static_cast<double>(pool->hits())),
+    Number::New(env->isolate(), static_cast<double>(pool->misses()))
+  };
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), stats, arraysize(stats)));
+}
+
 void InitWorker(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -805,6 +1016,7 @@ void InitWorker(Local<Object> target,
   }
 
   env->SetMethod(target, "getEnvMessagePort", GetEnvMessagePort);
+  env->SetMethod(target, "getIsolatePoolStats", GetIsolatePoolStats);
 
   target
       ->Set(env->context(),
@@ -11,6 +11,7 @@ namespace node {
 namespace worker {
 
 class WorkerThreadData;
+struct WarmIsolate;
 
 enum ResourceLimits {
   kMaxYoungGenerationSizeMb,
@@ -103,6 +104,10 @@ class Worker : public AsyncWrap {
   std::unique_ptr<MessagePortData> child_port_data_;
   std::shared_ptr<KVStore> env_vars_;
 
+  // An Isolate taken from the parent's WorkerIsolatePool, if any. This is
+  // handed over to the worker thread when it starts.
+  std::unique_ptr<WarmIsolate> warm_isolate_;
+
   // This is always kept alive because the JS object associated with the Worker
   // instance refers to it via its [kPort] property.
   MessagePort* parent_port_ = nullptr;
@@ -124,6 +129,54 @@ class Worker : public AsyncWrap {
   friend class WorkerThreadData;
 };
 
+// An Isolate with its event loop, IsolateData and an empty Context that has
+// been set up ahead of time, so that a Worker can skip doing that on startup.
+struct WarmIsolate {
+  uv_loop_t loop;
+  v8::Isolate* isolate = nullptr;
+  DeleteFnPtr<IsolateData, FreeIsolateData> isolate_data;
+  v8::Global<v8::Context> context;
+  size_t heap_size = 0;
+};
+
+// Keeps up to a fixed number of WarmIsolates parked for Workers started by
+// one Environment, and creates new ones on the threadpool as they are used.
+// This is only touched from the thread of that Environment.
+// TODO(agent): Also bootstrap an Environment for every pooled Isolate, so
+// that Workers skip the Node.js bootstrap as well. That first needs the
+// bootstrap to stop depending on what is only known once a Worker starts:
+// its thread id, argv, env, per-Worker options and the parent's MessagePort.
+class WorkerIsolatePool : public MemoryRetainer {
+ public:
+  WorkerIsolatePool(Environment* env, size_t size);
+  ~WorkerIsolatePool() override;
+
+  // Returns nullptr if no Isolate is ready yet.
+  std::unique_ptr<WarmIsolate> Take();
+
+  // The number of Isolates that are ready, and how often Take() did and did
+  // not return one.
+  size_t ready() const { return isolates_.size(); }
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(WorkerIsolatePool)
+  SET_SELF_SIZE(WorkerIsolatePool)
+
+ private:
+  class CreateIsolateWork;
+
+  void Fill();
+
+  Environment* const env_;
+  const size_t size_;
+  size_t pending_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  std::vector<std::unique_ptr<WarmIsolate>> isolates_;
+};
+
 template <typename Fn>
 bool Worker::RequestInterrupt(Fn&& cb) {
   Mutex::ScopedLock lock(mutex_);
@@ -5,6 +5,7 @@
 
 #include "req_wrap.h"
 #include "async_wrap-inl.h"
+#include "request_latency.h"
 #include "uv.h"
 
 namespace node {
@@ -39,6 +40,21 @@ void ReqWrap<T>::Reset() {
   req_.data = nullptr;
 }
 
+template <typename T>
+void ReqWrap<T>::StartLatencyTracking() {
+  dispatch_time_ =
+      env()->request_latency_recorder() != nullptr ? uv_hrtime() : 0;
+}
+
+template <typename T>
+void ReqWrap<T>::RecordLatency() {
+  if (dispatch_time_ == 0) return;
+  RequestLatencyRecorder* recorder = env()->request_latency_recorder();
+  if (recorder != nullptr)
+    recorder->Record(provider_type(), dispatch_time_);
+  dispatch_time_ = 0;
+}
+
 template <typename T>
 ReqWrap<T>* ReqWrap<T>::from_req(T* req) {
   return ContainerOf(&ReqWrap<T>::req_, req);
@@ -122,6 +138,7 @@ struct MakeLibuvRequestCallback<ReqT, void(*)(ReqT*, Args...)> {
   static void Wrapper(ReqT* req, Args... args) {
     ReqWrap<ReqT>* req_wrap = ReqWrap<ReqT>::from_req(req);
     req_wrap->env()->DecreaseWaitingRequestCounter();
+    req_wrap->RecordLatency();
     F original_callback = reinterpret_cast<F>(req_wrap->original_callback_);
     original_callback(req, args...);
   }
@@ -138,6 +155,7 @@ template <typename T>
 template <typename LibuvFunction, typename... Args>
 int ReqWrap<T>::Dispatch(LibuvFunction fn, Args... args) {
   Dispatched();
+  StartLatencyTracking();
 
   // This expands as:
   //
@@ -48,6 +48,12 @@ class ReqWrap : public AsyncWrap, public ReqWrapBase {
   template <typename LibuvFunction, typename... Args>
   inline int Dispatch(LibuvFunction fn, Args... args);
 
+  // Called by Dispatch() and by the callback wrapper that it installs, and
+  // by code that starts requests without going through Dispatch(), so that
+  // the request's latency is recorded while tracking is enabled.
+  inline void StartLatencyTracking();
+  inline void RecordLatency();
+
  private:
   friend int GenDebugSymbols();
 
@@ -56,6 +62,9 @@ class ReqWrap : public AsyncWrap, public ReqWrapBase {
  public:
   typedef void (*callback_t)();
   callback_t original_callback_ = nullptr;
+  // Set by StartLatencyTracking() while request latency tracking is
+  // enabled.
+  uint64_t dispatch_time_ = 0;
 
  protected:
   // req_wrap_queue_ needs to be at a fixed offset from the start of the class
@@ -0,0 +1,98 @@
+#include "request_latency.h"
+#include "env-inl.h"
+#include "histogram-inl.h"
+#include "memory_tracker-inl.h"
+#include "util-inl.h"
+
+namespace node {
+
+using v8::Array;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Object;
+using v8::Undefined;
+using v8::Value;
+
+void RequestLatencyRecorder::Record(AsyncWrap::ProviderType provider,
+                                    uint64_t dispatch_time) {
+  uint64_t now = uv_hrtime();
+  if (now < dispatch_time)
+    return;
+  Entry* entry = &entries_[provider];
+  if (!entry->histogram)
+    entry->histogram.reset(new Histogram(kLowest, kHighest));
+  int64_t latency = static_cast<int64_t>(now - dispatch_time);
+  if (!entry->histogram->Record(latency > 0 ? latency : kLowest) &&
+      entry->exceeds < 0xFFFFFFFF) {
+    entry->exceeds++;
+  }
+}
+
+void RequestLatencyRecorder::Reset() {
+  for (Entry& entry : entries_) {
+    entry.histogram.reset();
+    entry.exceeds = 0;
+  }
+}
+
+void RequestLatencyRecorder::MemoryInfo(MemoryTracker* tracker) const {
+  size_t size = 0;
+  for (const Entry& entry : entries_) {
+    if (entry.histogram)
+      size += entry.histogram->GetMemorySize();
+  }
+  tracker->TrackFieldWithSize("histograms", size);
+}
+
+void RequestLatencyRecorder::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (env->request_latency_recorder() == nullptr) {
+    env->set_request_latency_recorder(
+        std::make_unique<RequestLatencyRecorder>());
+  }
+}
+
+void RequestLatencyRecorder::Stop(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->set_request_latency_recorder(nullptr);
+}
+
+// Returns an Array with a Histogram for each provider type that requests
+// have completed for, or undefined if tracking is not enabled. The
+// Histograms are copies, and with a true first argument the recorded values
+// are removed at the same time.
+void RequestLatencyRecorder::Get(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  RequestLatencyRecorder* recorder = env->request_latency_recorder();
+  if (recorder == nullptr)
+    return;
+
+  Local<Value> histograms[AsyncWrap::PROVIDERS_LENGTH];
+  for (size_t i = 0; i < AsyncWrap::PROVIDERS_LENGTH; i++) {
+    Entry* entry = &recorder->entries_[i];
+    histograms[i] = Undefined(env->isolate());
+    if (!entry->histogram)
+      continue;
+    BaseObjectPtr<HistogramBase> histogram =
+        HistogramBase::New(env, kLowest, kHighest);
+    if (!histogram)
+      return;
+    histogram->AddExceeds(entry->exceeds + histogram->Add(*entry->histogram));
+    histograms[i] = histogram->object();
+  }
+  if (args[0]->IsTrue())
+    recorder->Reset();
+
+  args.GetReturnValue().Set(
+      Array::New(env->isolate(), histograms, arraysize(histograms)));
+}
+
+void RequestLatencyRecorder::Initialize(Environment* env,
+                                        Local<Object> target) {
+  HistogramBase::Initialize(env);
+  env->SetMethod(target, "startRequestLatencyTracking", Start);
+  env->SetMethod(target, "stopRequestLatencyTracking", Stop);
+  env->SetMethod(target, "getRequestLatency", Get);
+}
+
+}  // namespace node
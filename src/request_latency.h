@@ -0,0 +1,53 @@
+#ifndef SRC_REQUEST_LATENCY_H_
+#define SRC_REQUEST_LATENCY_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "async_wrap.h"
+#include "histogram.h"
+#include "memory_tracker.h"
+
+#include <memory>
+
+namespace node {
+
+class Environment;
+
+// Records how long libuv requests take from being dispatched through
+// ReqWrap::Dispatch(), or submitted to io_uring for fs requests, until their
+// callback is called, separately for each AsyncWrap provider type. An
+// Environment only has one of these while tracking is enabled, so that
+// ReqWrap only has to check for a null pointer otherwise.
+class RequestLatencyRecorder : public MemoryRetainer {
+ public:
+  // Latencies are recorded in nanoseconds, from 1ns up to one hour.
+  static constexpr int64_t kLowest = 1;
+  static constexpr int64_t kHighest = 3600LL * 1000 * 1000 * 1000;
+
+  void Record(AsyncWrap::ProviderType provider, uint64_t dispatch_time);
+  void Reset();
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(RequestLatencyRecorder)
+  SET_SELF_SIZE(RequestLatencyRecorder)
+
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Stop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Get(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+ private:
+  struct Entry {
+    // Only created once the first request of the type has completed.
+    std::unique_ptr<Histogram> histogram;
+    int64_t exceeds = 0;
+  };
+
+  Entry entries_[AsyncWrap::PROVIDERS_LENGTH];
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_REQUEST_LATENCY_H_
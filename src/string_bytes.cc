@@ -25,12 +25,14 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "node_simd.h"
 #include "util.h"
 
 #include <climits>
 #include <cstring>  // memcpy
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 // When creating strings >= this length v8's gc spins up and consumes
@@ -40,6 +42,9 @@
 
 namespace node {
 
+using v8::ArrayBuffer;
+using v8::ArrayBufferView;
+using v8::BackingStore;
 using v8::HandleScope;
 using v8::Isolate;
 using v8::Just;
@@ -198,6 +203,61 @@ MaybeLocal<Value> ExternTwoByteString::NewSimpleFromCopy(Isolate* isolate,
   return str.ToLocalChecked();
 }
 
+// An external one-byte string that takes over (part of) the memory of a
+// detached ArrayBuffer instead of copying it.
+class ExternBackingStoreString : public String::ExternalOneByteStringResource {
+ public:
+  ~ExternBackingStoreString() override {
+    isolate_->AdjustAmountOfExternalAllocatedMemory(-byte_length());
+  }
+
+  const char* data() const override {
+    return static_cast<const char*>(store_->Data()) + offset_;
+  }
+
+  size_t length() const override {
+    return length_;
+  }
+
+  int64_t byte_length() const {
+    return length_;
+  }
+
+  static MaybeLocal<Value> New(Isolate* isolate,
+                               std::shared_ptr<BackingStore> store,
+                               size_t offset,
+                               size_t length,
+                               Local<Value>* error) {
+    ExternBackingStoreString* h_str =
+        new ExternBackingStoreString(isolate, std::move(store), offset, length);
+    MaybeLocal<String> str = String::NewExternalOneByte(isolate, h_str);
+    isolate->AdjustAmountOfExternalAllocatedMemory(h_str->byte_length());
+
+    if (str.IsEmpty()) {
+      delete h_str;
+      *error = node::ERR_STRING_TOO_LONG(isolate);
+      return MaybeLocal<Value>();
+    }
+
+    return str.ToLocalChecked();
+  }
+
+ private:
+  ExternBackingStoreString(Isolate* isolate,
+                           std::shared_ptr<BackingStore> store,
+                           size_t offset,
+                           size_t length)
+    : isolate_(isolate),
+      store_(std::move(store)),
+      offset_(offset),
+      length_(length) { }
+
+  Isolate* isolate_;
+  std::shared_ptr<BackingStore> store_;
+  size_t offset_;
+  size_t length_;
+};
+
 }  // anonymous namespace
 
 // supports regular and URL-safe base64
@@ -244,13 +304,38 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+// The vectorized decoder only handles one-byte input.
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const char* src,
+                                     const size_t srcLen) {
+  return simd::HexDecode(buf, len, src, srcLen);
+}
+
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const uint8_t* src,
+                                     const size_t srcLen) {
+  return simd::HexDecode(buf, len, reinterpret_cast<const char*>(src), srcLen);
+}
+
+template <typename TypeName>
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const TypeName* src,
+                                     const size_t srcLen) {
+  return 0;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
   size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  for (i = hex_decode_simd(buf, len, src, srcLen);
+       i < len && i * 2 + 1 < srcLen;
+       ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -365,6 +450,12 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = base64_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        // Flatten into a one-byte copy so that the SIMD decoder can be used.
+        MaybeStackBuffer<uint8_t> value(str->Length());
+        str->WriteOneByte(isolate, *value, 0, value.length(),
+                          String::NO_NULL_TERMINATION);
+        nbytes = base64_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -376,6 +467,12 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = hex_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        // Flatten into a one-byte copy so that the SIMD decoder can be used.
+        MaybeStackBuffer<uint8_t> value(str->Length());
+        str->WriteOneByte(isolate, *value, 0, value.length(),
+                          String::NO_NULL_TERMINATION);
+        nbytes = hex_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = hex_decode(buf, buflen, *value, value.length());
@@ -470,8 +567,18 @@ Maybe<size_t> StringBytes::Size(Isolate* isolate,
       return Just(str->Length() * sizeof(uint16_t));
 
     case BASE64: {
-      String::Value value(isolate, str);
-      return Just(base64_decoded_size(*value, value.length()));
+      // Only the padding at the end matters, so avoid copying the string.
+      const int tail_length = std::min(str->Length(), 2);
+      uint16_t tail[2];
+      str->Write(isolate, tail, str->Length() - tail_length, tail_length,
+                 String::NO_NULL_TERMINATION);
+      size_t length = str->Length();
+      if (tail_length > 0 && tail[tail_length - 1] == '=') {
+        length--;
+        if (tail_length > 1 && tail[0] == '=')
+          length--;
+      }
+      return Just(base64_decoded_size_fast(length));
     }
 
     case HEX:
@@ -494,6 +601,11 @@ static bool contains_non_ascii_slow(const char* buf, size_t len) {
 
 
 static bool contains_non_ascii(const char* src, size_t len) {
+  // Skip the prefix that the vectorized scan has already verified.
+  const size_t ascii = simd::AsciiPrefixLength(src, len);
+  src += ascii;
+  len -= ascii;
+
   if (len < 16) {
     return contains_non_ascii_slow(src, len);
   }
@@ -559,7 +671,7 @@ static void force_ascii(const char* src, char* dst, size_t len) {
       force_ascii_slow(src, dst, unalign);
       src += unalign;
       dst += unalign;
-      len -= src_unalign;
+      len -= unalign;
     } else {
       force_ascii_slow(src, dst, len);
       return;
@@ -597,7 +709,8 @@ size_t StringBytes::hex_encode(
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t done = simd::HexEncode(src, slen, dst);
+  for (size_t i = done, k = done * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -665,6 +778,11 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
       }
 
     case UTF8:
+      // Pure ASCII data can skip V8's UTF-8 decoder and, like latin1 data,
+      // ends up in an external string when it is large.
+      if (!contains_non_ascii(buf, buflen))
+        return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
+
       val = String::NewFromUtf8(isolate,
                                 buf,
                                 v8::NewStringType::kNormal,
@@ -745,6 +863,50 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
 }
 
 
+MaybeLocal<Value> StringBytes::EncodeTransfer(Isolate* isolate,
+                                              Local<ArrayBufferView> view,
+                                              enum encoding encoding,
+                                              Local<Value>* error) {
+  Local<ArrayBuffer> ab = view->Buffer();
+  std::shared_ptr<BackingStore> store = ab->GetBackingStore();
+  const size_t offset = view->ByteOffset();
+  const size_t length = view->ByteLength();
+  char* data = static_cast<char*>(store->Data()) + offset;
+
+  // Small results are cheaper to copy onto the V8 heap, so only large ones
+  // take over the memory. Anything that is not one-byte data as-is is copied.
+  bool adopt = false;
+  if (length >= EXTERN_APEX && ab->IsDetachable()) {
+    switch (encoding) {
+      case ASCII:
+        // The caller no longer needs the data, so strip it in place.
+        if (contains_non_ascii(data, length))
+          force_ascii(data, data, length);
+        adopt = true;
+        break;
+      case LATIN1:
+        adopt = true;
+        break;
+      case UTF8:
+        adopt = !contains_non_ascii(data, length);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (!adopt)
+    return Encode(isolate, data, length, encoding, error);
+
+  ab->Detach();
+  return ExternBackingStoreString::New(isolate,
+                                       std::move(store),
+                                       offset,
+                                       length,
+                                       error);
+}
+
+
 MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
                                       const uint16_t* buf,
                                       size_t buflen,
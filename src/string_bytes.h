@@ -85,6 +85,16 @@ class StringBytes {
                                           enum encoding encoding,
                                           v8::Local<v8::Value>* error);
 
+  // Like Encode(), but for the contents of a view whose ArrayBuffer the
+  // caller owns and does not use afterwards. Large latin1 and ASCII results
+  // take over the ArrayBuffer's memory instead of copying it, in which case
+  // the ArrayBuffer is detached. The ASCII conversion may happen in place.
+  static v8::MaybeLocal<v8::Value> EncodeTransfer(
+      v8::Isolate* isolate,
+      v8::Local<v8::ArrayBufferView> view,
+      enum encoding encoding,
+      v8::Local<v8::Value>* error);
+
   // Warning: This reverses endianness on BE platforms, even though the
   // signature using uint16_t implies that it should not.
   // However, the brokenness is already public API and can't therefore
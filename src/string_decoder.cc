@@ -27,21 +27,14 @@ MaybeLocal<String> MakeString(Isolate* isolate,
                               size_t length,
                               enum encoding encoding) {
   Local<Value> error;
-  MaybeLocal<Value> ret;
-  if (encoding == UTF8) {
-    return String::NewFromUtf8(
-        isolate,
-        data,
-        v8::NewStringType::kNormal,
-        length);
-  } else {
-    ret = StringBytes::Encode(
-        isolate,
-        data,
-        length,
-        encoding,
-        &error);
-  }
+  // This also covers UTF-8, for which StringBytes takes care of turning
+  // ASCII-only chunks into one-byte strings without decoding them.
+  MaybeLocal<Value> ret = StringBytes::Encode(
+      isolate,
+      data,
+      length,
+      encoding,
+      &error);
 
   if (ret.IsEmpty()) {
     CHECK(!error.IsEmpty());
@@ -7,6 +7,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "node_simd.h"
 #include "util.h"
 
 #include <cstring>
@@ -76,6 +77,11 @@ class StringSearchBase {
   // to compensate for the algorithmic overhead compared to simple brute force.
   static const int kBMMinPatternLength = 8;
 
+  // Patterns of up to this many bytes are first searched for with the
+  // vectorized first/last byte filter. For longer ones, Boyer-Moore skips
+  // far enough ahead to be faster.
+  static const int kVectorizedMaxPatternLength = 32;
+
   // Store for the BoyerMoore(Horspool) bad char shift table.
   int bad_char_shift_table_[kUC16AlphabetSize];
   // Store for the BoyerMoore good suffix shift table.
@@ -110,6 +116,11 @@ class StringSearch : private StringSearchBase {
   }
 
   size_t Search(Vector subject, size_t index) {
+    if (sizeof(Char) == 1 && pattern_.length() > 1 &&
+        pattern_.length() <= kVectorizedMaxPatternLength &&
+        VectorizedSearch(subject, &index)) {
+      return index;
+    }
     switch (strategy_) {
       case kBoyerMooreHorspool:
         return BoyerMooreHorspoolSearch(subject, index);
@@ -141,6 +152,7 @@ class StringSearch : private StringSearchBase {
 
  private:
   typedef size_t (StringSearch::*SearchFunction)(Vector, size_t);
+  bool VectorizedSearch(Vector subject, size_t* index);
   size_t SingleCharSearch(Vector subject, size_t start_index);
   size_t LinearSearch(Vector subject, size_t start_index);
   size_t InitialSearch(Vector subject, size_t start_index);
@@ -285,6 +297,53 @@ inline size_t FindFirstCharacter(Vector<const uint8_t> pattern,
   return subject.forward() ? raw_pos : (subj_len - raw_pos - 1);
 }
 
+//---------------------------------------------------------------------
+// Vectorized Search
+//---------------------------------------------------------------------
+
+// Looks for byte patterns with the SIMD kernels. Returns true if a match was
+// found; otherwise, advances `*index` past the positions that have been ruled
+// out so that the regular strategy only needs to check the rest.
+template <typename Char>
+bool StringSearch<Char>::VectorizedSearch(
+    Vector subject,
+    size_t* index) {
+  const size_t pattern_length = pattern_.length();
+  if (subject.length() < pattern_length ||
+      *index > subject.length() - pattern_length) {
+    return false;
+  }
+
+  const char* haystack = reinterpret_cast<const char*>(subject.start());
+  const char* needle = reinterpret_cast<const char*>(pattern_.start());
+  size_t pos;
+  if (subject.forward()) {
+    const size_t start = *index;
+    const bool found = simd::IndexOf(haystack + start,
+                                     subject.length() - start,
+                                     needle,
+                                     pattern_length,
+                                     &pos);
+    *index += pos;
+    return found;
+  }
+
+  // In a backward vector, index i stands for the match that ends i bytes
+  // before the end of the memory range, so searching from `*index` means
+  // looking for the last match in the memory that comes before that.
+  const size_t end = subject.length() - (*index);
+  if (simd::LastIndexOf(haystack,
+                        end,
+                        needle,
+                        pattern_length,
+                        &pos)) {
+    *index = subject.length() - pattern_length - pos;
+    return true;
+  }
+  *index += pos;
+  return false;
+}
+
 //---------------------------------------------------------------------
 // Single Character Pattern Search Strategy
 //---------------------------------------------------------------------
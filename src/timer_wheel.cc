@@ -0,0 +1,157 @@
+#include "timer_wheel.h"
+#include "memory_tracker-inl.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+namespace {
+
+inline unsigned CountTrailingZeros64(uint64_t value) {
+#ifdef _MSC_VER
+  unsigned long index;  // NOLINT(runtime/int)
+  _BitScanForward64(&index, value);
+  return index;
+#else
+  return __builtin_ctzll(value);
+#endif
+}
+
+// The bits of the slots after |from| up to and including |to|.
+inline uint64_t SlotRange(size_t from, size_t to) {
+  uint64_t up_to = to + 1 >= 64 ? ~uint64_t{0} : (uint64_t{1} << (to + 1)) - 1;
+  uint64_t after = from + 1 >= 64 ? ~uint64_t{0} :
+                                    (uint64_t{1} << (from + 1)) - 1;
+  return up_to & ~after;
+}
+
+}  // anonymous namespace
+
+void TimerWheel::Schedule(int64_t key, uint64_t expiry) {
+  Entry* entry = &entries_[key];
+  Detach(entry);
+  entry->key = key;
+  entry->expiry = expiry;
+  entry->sequence = sequence_++;
+  Place(entry);
+}
+
+void TimerWheel::Unschedule(int64_t key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return;
+  Detach(&it->second);
+  entries_.erase(it);
+}
+
+void TimerWheel::Place(Entry* entry) {
+  if (entry->expiry <= now_) {
+    entry->level = kDue;
+    due_.PushBack(entry);
+    return;
+  }
+
+  // The highest level on which the expiry time and the current time differ.
+  uint64_t diff = entry->expiry ^ now_;
+  size_t level = 0;
+  while (level + 1 < kLevels && (diff >> ((level + 1) * kBits)) != 0)
+    level++;
+  size_t slot = (entry->expiry >> (level * kBits)) & kMask;
+  entry->level = level;
+  entry->slot = slot;
+  slots_[level][slot].PushBack(entry);
+  occupied_[level] |= uint64_t{1} << slot;
+}
+
+void TimerWheel::Detach(Entry* entry) {
+  entry->node.Remove();
+  if (entry->level < kLevels &&
+      slots_[entry->level][entry->slot].IsEmpty()) {
+    occupied_[entry->level] &= ~(uint64_t{1} << entry->slot);
+  }
+  entry->level = kUnplaced;
+}
+
+void TimerWheel::TakeSlots(size_t level, uint64_t slots, EntryList* list) {
+  slots &= occupied_[level];
+  occupied_[level] &= ~slots;
+  while (slots != 0) {
+    size_t slot = CountTrailingZeros64(slots);
+    slots &= slots - 1;
+    while (Entry* entry = slots_[level][slot].PopFront())
+      list->PushBack(entry);
+  }
+}
+
+void TimerWheel::Advance(uint64_t now) {
+  if (now <= now_)
+    return;
+
+  // The entries on each level share the time above that level with now_, and
+  // have a slot index above that of now_. If now shares that time as well,
+  // only the slots up to its index have been passed, and the levels above
+  // are not affected. Otherwise, everything on the level has expired.
+  EntryList pending;
+  for (size_t level = 0; level < kLevels; level++) {
+    size_t shift = level * kBits;
+    size_t from = (now_ >> shift) & kMask;
+    size_t to = (now >> shift) & kMask;
+    bool same_block = shift + kBits >= 64 ||
+                      (now_ >> (shift + kBits)) == (now >> (shift + kBits));
+    if (same_block) {
+      TakeSlots(level, SlotRange(from, to), &pending);
+      break;
+    }
+    TakeSlots(level, ~uint64_t{0}, &pending);
+  }
+
+  now_ = now;
+  while (Entry* entry = pending.PopFront())
+    Place(entry);
+}
+
+const std::vector<int64_t>& TimerWheel::GetDue() {
+  due_entries_.clear();
+  for (Entry* entry : due_)
+    due_entries_.push_back(entry);
+  std::sort(due_entries_.begin(), due_entries_.end(),
+            [](const Entry* a, const Entry* b) {
+    if (a->expiry != b->expiry)
+      return a->expiry < b->expiry;
+    return a->sequence < b->sequence;
+  });
+
+  due_keys_.clear();
+  for (const Entry* entry : due_entries_)
+    due_keys_.push_back(entry->key);
+  return due_keys_;
+}
+
+uint64_t TimerWheel::NextExpiry() const {
+  if (!due_.IsEmpty())
+    return now_;
+
+  // Everything on a level expires before anything on the levels above it,
+  // and within a level the slots are ordered by time. All occupied slots
+  // come after the slot of now_.
+  for (size_t level = 0; level < kLevels; level++) {
+    if (occupied_[level] == 0)
+      continue;
+    size_t slot = CountTrailingZeros64(occupied_[level]);
+    uint64_t expiry = kNever;
+    for (const Entry* entry : slots_[level][slot])
+      expiry = std::min(expiry, entry->expiry);
+    return expiry;
+  }
+  return kNever;
+}
+
+void TimerWheel::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("entries", entries_.size() * sizeof(Entry));
+  tracker->TrackFieldWithSize("due_entries",
+                              due_entries_.capacity() * sizeof(Entry*));
+  tracker->TrackField("due_keys", due_keys_);
+}
+
+}  // namespace node
@@ -0,0 +1,99 @@
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "memory_tracker.h"
+#include "util.h"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace node {
+
+// A hierarchical timing wheel that keeps track of when each of the JS timer
+// lists expires. A list is identified by the duration of its timers, and
+// expiry times are in milliseconds, relative to Environment::timer_base().
+//
+// Each of the kLevels levels has kSlots slots. An entry is put on the lowest
+// level on which its expiry time and the current time of the wheel only differ
+// in the slot index, so that adding, moving and removing an entry takes
+// constant time. Each level has a bitmap of its non-empty slots, so that
+// advancing the wheel and finding the next expiry time skip empty slots
+// without looking at them. Entries move down at most once per level, until
+// they are due.
+class TimerWheel : public MemoryRetainer {
+ public:
+  static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+  TimerWheel() = default;
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Adds the list with the key |key|, or moves it if it is already known.
+  void Schedule(int64_t key, uint64_t expiry);
+  void Unschedule(int64_t key);
+
+  // Makes all lists that expire at or before |now| due. They stay due until
+  // they are scheduled again or removed.
+  void Advance(uint64_t now);
+
+  // Returns the keys of the due lists, in the order in which they expire.
+  // Lists with the same expiry time are ordered by when they were last
+  // scheduled. The result is only valid until the next call.
+  const std::vector<int64_t>& GetDue();
+
+  // Returns the earliest expiry time of all lists, or kNever.
+  uint64_t NextExpiry() const;
+
+  inline bool empty() const { return entries_.empty(); }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(TimerWheel)
+  SET_SELF_SIZE(TimerWheel)
+
+ private:
+  static constexpr size_t kBits = 6;
+  static constexpr size_t kSlots = 1 << kBits;
+  static constexpr uint64_t kMask = kSlots - 1;
+  static constexpr size_t kLevels = (64 + kBits - 1) / kBits;
+
+  // The level of entries that are due, or not placed at all.
+  static constexpr uint8_t kDue = kLevels;
+  static constexpr uint8_t kUnplaced = kLevels + 1;
+
+  struct Entry {
+    ListNode<Entry> node;
+    int64_t key;
+    uint64_t expiry;
+    uint64_t sequence;
+    uint8_t level = kUnplaced;
+    uint8_t slot = 0;
+  };
+  typedef ListHead<Entry, &Entry::node> EntryList;
+
+  void Place(Entry* entry);
+  void Detach(Entry* entry);
+  void TakeSlots(size_t level, uint64_t slots, EntryList* list);
+
+  // The time up to which the wheel has been advanced.
+  uint64_t now_ = 0;
+  uint64_t sequence_ = 0;
+  EntryList slots_[kLevels][kSlots];
+  // Bit n is set if slots_[level][n] is not empty.
+  uint64_t occupied_[kLevels] = {};
+  EntryList due_;
+  std::unordered_map<int64_t, Entry> entries_;
+
+  // Kept around so that GetDue() does not allocate on every call.
+  std::vector<Entry*> due_entries_;
+  std::vector<int64_t> due_keys_;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMER_WHEEL_H_
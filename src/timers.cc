@@ -30,9 +30,20 @@ void GetLibuvNow(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(env->GetNow());
 }
 
-void ScheduleTimer(const FunctionCallbackInfo<Value>& args) {
+void ScheduleTimerList(const FunctionCallbackInfo<Value>& args) {
   auto env = Environment::GetCurrent(args);
-  env->ScheduleTimer(args[0]->IntegerValue(env->context()).FromJust());
+  int64_t msecs = args[0]->IntegerValue(env->context()).FromJust();
+  int64_t expiry = args[1]->IntegerValue(env->context()).FromJust();
+  env->ScheduleTimerList(msecs, expiry > 0 ? expiry : 0);
+}
+
+void UnscheduleTimerList(const FunctionCallbackInfo<Value>& args) {
+  auto env = Environment::GetCurrent(args);
+  env->UnscheduleTimerList(args[0]->IntegerValue(env->context()).FromJust());
+}
+
+void ApplyTimerListUpdates(const FunctionCallbackInfo<Value>& args) {
+  Environment::GetCurrent(args)->ApplyTimerListUpdates();
 }
 
 void ToggleTimerRef(const FunctionCallbackInfo<Value>& args) {
@@ -51,13 +62,21 @@ void Initialize(Local<Object> target,
 
   env->SetMethod(target, "getLibuvNow", GetLibuvNow);
   env->SetMethod(target, "setupTimers", SetupTimers);
-  env->SetMethod(target, "scheduleTimer", ScheduleTimer);
+  env->SetMethod(target, "scheduleTimerList", ScheduleTimerList);
+  env->SetMethod(target, "unscheduleTimerList", UnscheduleTimerList);
+  env->SetMethod(target, "applyTimerListUpdates", ApplyTimerListUpdates);
   env->SetMethod(target, "toggleTimerRef", ToggleTimerRef);
   env->SetMethod(target, "toggleImmediateRef", ToggleImmediateRef);
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "immediateInfo"),
               env->immediate_info()->fields().GetJSArray()).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "dueTimerLists"),
+              env->timer_list_info()->due().GetJSArray()).Check();
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "timerListUpdates"),
+              env->timer_list_info()->updates().GetJSArray()).Check();
 }
 
 
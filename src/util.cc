@@ -186,6 +186,39 @@ double GetCurrentTimeInMicroseconds() {
   return kMicrosecondsPerSecond * tv.tv_sec + tv.tv_usec;
 }
 
+int ReadFileSync(std::string* result, const char* path) {
+  uv_fs_t req;
+  uv_file file = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (file < 0) {
+    return file;
+  }
+
+  int err = uv_fs_fstat(nullptr, &req, file, nullptr);
+  size_t size = static_cast<size_t>(req.statbuf.st_size);
+  uv_fs_req_cleanup(&req);
+
+  if (err == 0) {
+    result->resize(size);
+    size_t offset = 0;
+    while (offset < size) {
+      uv_buf_t buf = uv_buf_init(&(*result)[offset],
+                                 static_cast<unsigned int>(size - offset));
+      int n = uv_fs_read(nullptr, &req, file, &buf, 1, offset, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (n <= 0) {
+        err = n < 0 ? n : UV_EIO;
+        break;
+      }
+      offset += n;
+    }
+  }
+
+  uv_fs_close(nullptr, &req, file, nullptr);
+  uv_fs_req_cleanup(&req);
+  return err;
+}
+
 int WriteFileSync(const char* path, uv_buf_t buf) {
   uv_fs_t req;
   int fd = uv_fs_open(nullptr,
@@ -0,0 +1,40 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const { AsyncLocalStorage, AsyncResource } = require('async_hooks');
+const { internalBinding } = require('internal/test/binding');
+
+const { async_hook_fields, constants } = internalBinding('async_wrap');
+
+const asyncLocalStorage = new AsyncLocalStorage();
+const before = new AsyncResource('BEFORE');
+
+asyncLocalStorage.run('store', common.mustCall(async () => {
+  // Stores are propagated without enabling any async hooks.
+  assert.strictEqual(async_hook_fields[constants.kTotals], 0);
+
+  before.runInAsyncScope(common.mustCall(() => {
+    assert.strictEqual(asyncLocalStorage.getStore(), undefined);
+  }));
+
+  // Resources that are created in C++.
+  fs.stat(__filename, common.mustCall(() => {
+    assert.strictEqual(asyncLocalStorage.getStore(), 'store');
+
+    // Entering a store from a callback does not leak out of it.
+    asyncLocalStorage.enterWith('inner');
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(asyncLocalStorage.getStore(), 'inner');
+    }));
+  }));
+  setImmediate(common.mustCall(() => {
+    assert.strictEqual(asyncLocalStorage.getStore(), 'store');
+  }));
+
+  await fs.promises.stat(__filename);
+  assert.strictEqual(asyncLocalStorage.getStore(), 'store');
+}));
+
+assert.strictEqual(asyncLocalStorage.getStore(), undefined);
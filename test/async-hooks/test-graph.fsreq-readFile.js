@@ -18,9 +18,7 @@ function onexit() {
   hooks.disable();
   verifyGraph(
     hooks,
-    [ { type: 'FSREQCALLBACK', id: 'fsreq:1', triggerAsyncId: null },
-      { type: 'FSREQCALLBACK', id: 'fsreq:2', triggerAsyncId: 'fsreq:1' },
-      { type: 'FSREQCALLBACK', id: 'fsreq:3', triggerAsyncId: 'fsreq:2' },
-      { type: 'FSREQCALLBACK', id: 'fsreq:4', triggerAsyncId: 'fsreq:3' } ]
+    // Small files are read by a single request.
+    [ { type: 'FSREQCALLBACK', id: 'fsreq:1', triggerAsyncId: null } ]
   );
 }
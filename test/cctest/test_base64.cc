@@ -1,7 +1,9 @@
 #include "base64.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -125,3 +127,61 @@ TEST(Base64Test, Decode) {
        "dCBjdXBpZGF0YXQgbm9uIHByb2lkZW50LCBzdW50IGluIGN1bHBhIHF1aSBvZmZpY2lh\n"
        "IGRlc2VydW50IG1vbGxpdCBhbmltIGlkIGVzdCBsYWJvcnVtLg", text);
 }
+
+TEST(Base64Test, RoundTrip) {
+  // Long enough inputs to exercise the vectorized code paths, with every
+  // possible remainder for the scalar code that finishes up.
+  std::string input;
+  for (size_t i = 0; i < 1024; i++)
+    input.push_back(static_cast<char>((i * 7919) >> 3));
+
+  for (size_t len = 0; len <= input.size(); len += (len < 128 ? 1 : 61)) {
+    std::string encoded(node::base64_encoded_size(len), '\0');
+    base64_encode(input.data(), len, &encoded[0], encoded.size());
+
+    std::string decoded(len, '\0');
+    EXPECT_EQ(len, base64_decode(&decoded[0], decoded.size(),
+                                 encoded.data(), encoded.size()));
+    EXPECT_EQ(input.substr(0, len), decoded);
+
+    // URL-safe alphabet, without padding.
+    std::string url = encoded;
+    std::replace(url.begin(), url.end(), '+', '-');
+    std::replace(url.begin(), url.end(), '/', '_');
+    url.erase(url.find_last_not_of('=') + 1);
+    std::fill(decoded.begin(), decoded.end(), '\0');
+    EXPECT_EQ(len, base64_decode(&decoded[0], decoded.size(),
+                                 url.data(), url.size()));
+    EXPECT_EQ(input.substr(0, len), decoded);
+
+    // MIME-style line breaks.
+    std::string wrapped;
+    for (size_t i = 0; i < encoded.size(); i += 76)
+      wrapped += encoded.substr(i, 76) + "\r\n";
+    std::fill(decoded.begin(), decoded.end(), '\0');
+    EXPECT_EQ(len, base64_decode(&decoded[0], decoded.size(),
+                                 wrapped.data(), wrapped.size()));
+    EXPECT_EQ(input.substr(0, len), decoded);
+  }
+}
+
+TEST(Base64Test, DecodeIntoShortBuffer) {
+  const std::string encoded(400, 'A');
+  for (size_t len = 0; len < 64; len++) {
+    std::string decoded(len + 32, '\x55');
+    EXPECT_EQ(len, base64_decode(&decoded[0], len,
+                                 encoded.data(), encoded.size()));
+    EXPECT_EQ(std::string(len, '\0'), decoded.substr(0, len));
+    EXPECT_EQ(std::string(32, '\x55'), decoded.substr(len));
+  }
+}
+
+TEST(Base64Test, DecodeStopsAtJunk) {
+  std::string encoded(200, 'A');
+  encoded[150] = '=';
+  std::string decoded(150, '\x55');
+  EXPECT_EQ(112u, base64_decode(&decoded[0], decoded.size(),
+                                encoded.data(), encoded.size()));
+  EXPECT_EQ(std::string(112, '\0'), decoded.substr(0, 112));
+  EXPECT_EQ(std::string(38, '\x55'), decoded.substr(112));
+}
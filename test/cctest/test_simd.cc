@@ -0,0 +1,133 @@
+#include "node_simd.h"
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using node::simd::AsciiPrefixLength;
+using node::simd::HexDecode;
+using node::simd::HexEncode;
+using node::simd::IndexOf;
+using node::simd::LastIndexOf;
+using node::simd::Utf8Length;
+
+// The kernels only process a prefix of their input, so these tests check that
+// whatever they do process is correct and that they never write past the
+// part of the output they report.
+
+static std::string TestBytes(size_t len) {
+  std::string bytes;
+  for (size_t i = 0; i < len; i++)
+    bytes.push_back(static_cast<char>(i * 7919 >> 3));
+  return bytes;
+}
+
+TEST(SimdTest, HexEncode) {
+  for (size_t len = 0; len < 300; len++) {
+    const std::string input = TestBytes(len);
+    std::string hex(2 * len + 1, '#');
+    const size_t consumed = HexEncode(input.data(), len, &hex[0]);
+    ASSERT_LE(consumed, len);
+    for (size_t i = 0; i < consumed; i++) {
+      char expected[3];
+      snprintf(expected, sizeof(expected), "%02x",
+               static_cast<uint8_t>(input[i]));
+      EXPECT_EQ(expected, hex.substr(2 * i, 2));
+    }
+    EXPECT_EQ('#', hex[2 * consumed]);
+  }
+}
+
+TEST(SimdTest, HexDecode) {
+  const char digits[] = "0123456789abcdefABCDEF";
+  std::string hex;
+  for (size_t i = 0; i < 600; i++)
+    hex.push_back(digits[i * 31 % 22]);
+
+  for (size_t len = 0; len < 300; len++) {
+    std::string bytes(len + 1, '#');
+    const size_t written = HexDecode(&bytes[0], len, hex.data(), hex.size());
+    ASSERT_LE(written, len);
+    for (size_t i = 0; i < written; i++) {
+      EXPECT_EQ(std::stoul(hex.substr(2 * i, 2), nullptr, 16),
+                static_cast<uint8_t>(bytes[i]));
+    }
+    EXPECT_EQ('#', bytes[written]);
+  }
+}
+
+TEST(SimdTest, HexDecodeStopsAtInvalidPair) {
+  for (size_t bad = 0; bad < 200; bad++) {
+    std::string hex(200, 'f');
+    hex[bad] = 'g';
+    std::string bytes(101, '#');
+    const size_t written = HexDecode(&bytes[0], 100, hex.data(), hex.size());
+    EXPECT_LE(written, bad / 2);
+    EXPECT_EQ(std::string(written, '\xff'), bytes.substr(0, written));
+    EXPECT_EQ('#', bytes[written]);
+  }
+}
+
+TEST(SimdTest, AsciiPrefixLength) {
+  for (size_t len = 0; len < 300; len++) {
+    const std::string ascii(len, 'a');
+    // Without any non-ASCII byte the whole input is a candidate, but the
+    // vectorized scan may leave the last partial block to its caller.
+    EXPECT_LE(AsciiPrefixLength(ascii.data(), len), len);
+  }
+  for (size_t bad = 0; bad < 200; bad++) {
+    std::string input(200, 'a');
+    input[bad] = '\x80';
+    EXPECT_LE(AsciiPrefixLength(input.data(), input.size()), bad);
+  }
+}
+
+TEST(SimdTest, Utf8Length) {
+  std::u16string input;
+  size_t expected = 0;
+  for (size_t i = 0; i < 1000; i++) {
+    EXPECT_EQ(expected, Utf8Length(
+        reinterpret_cast<const uint16_t*>(input.data()), input.size()));
+    switch (i % 5) {
+      case 0: input += u'a'; expected += 1; break;
+      case 1: input += u'\u00e9'; expected += 2; break;
+      case 2: input += u'\u20ac'; expected += 3; break;
+      // A surrogate pair, i.e. a single four-byte character.
+      case 3: input += u"\U0001F600"; expected += 4; break;
+      // A lone surrogate, which is encoded as U+FFFD.
+      case 4: input += static_cast<char16_t>(0xd800); expected += 3; break;
+    }
+  }
+}
+
+TEST(SimdTest, IndexOf) {
+  for (size_t needle_length = 2; needle_length <= 32; needle_length++) {
+    const std::string needle = "<" + std::string(needle_length - 2, '-') + ">";
+    for (size_t at = 0; at < 100; at++) {
+      std::string haystack(200, '-');
+      haystack.replace(at, needle_length, needle);
+      // A near miss in front of the match.
+      if (at > needle_length)
+        haystack[at - needle_length] = '<';
+
+      size_t pos;
+      if (IndexOf(haystack.data(), haystack.size(), needle.data(),
+                  needle_length, &pos)) {
+        EXPECT_EQ(at, pos);
+      } else {
+        EXPECT_LE(pos, at);
+      }
+      if (LastIndexOf(haystack.data(), haystack.size(), needle.data(),
+                      needle_length, &pos)) {
+        EXPECT_EQ(at, pos);
+      } else {
+        EXPECT_LE(pos, haystack.size() - needle_length - at);
+      }
+    }
+  }
+}
+
+TEST(SimdTest, ImplementationName) {
+  EXPECT_NE(nullptr, node::simd::GetImplementationName());
+}
@@ -18,6 +18,7 @@ const expectedModules = new Set([
   'Internal Binding fs',
   'Internal Binding fs_dir',
   'Internal Binding inspector',
+  'Internal Binding module_bundle',
   'Internal Binding module_wrap',
   'Internal Binding native_module',
   'Internal Binding options',
@@ -50,6 +51,7 @@ const expectedModules = new Set([
   'NativeModule internal/modules/run_main',
   'NativeModule internal/modules/cjs/helpers',
   'NativeModule internal/modules/cjs/loader',
+  'NativeModule internal/modules/cjs/module_bundle',
   'NativeModule internal/modules/esm/create_dynamic_module',
   'NativeModule internal/modules/esm/get_format',
   'NativeModule internal/modules/esm/get_source',
@@ -61,7 +63,6 @@ const expectedModules = new Set([
   'NativeModule internal/modules/esm/translators',
   'NativeModule internal/process/esm_loader',
   'NativeModule internal/options',
-  'NativeModule internal/priority_queue',
   'NativeModule internal/process/execution',
   'NativeModule internal/process/per_thread',
   'NativeModule internal/process/promises',
@@ -104,6 +105,7 @@ if (!common.isMainThread) {
   expectedModules.add('NativeModule internal/streams/state');
   expectedModules.add('NativeModule internal/worker');
   expectedModules.add('NativeModule internal/worker/io');
+  expectedModules.add('NativeModule internal/worker/ring_channel');
   expectedModules.add('NativeModule stream');
   expectedModules.add('NativeModule worker_threads');
 }
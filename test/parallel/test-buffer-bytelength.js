@@ -82,6 +82,13 @@ assert.strictEqual(Buffer.byteLength('hello world', ''), 11);
 // It should also be assumed with unrecognized encoding
 assert.strictEqual(Buffer.byteLength('hello world', 'abc'), 11);
 assert.strictEqual(Buffer.byteLength('ßœ∑≈', 'unkn0wn enc0ding'), 10);
+// Long two-byte strings are measured in chunks, which must not split
+// surrogate pairs. Lone surrogates count as U+FFFD.
+for (const offset of [1022, 1023, 1024, 2047]) {
+  const str = 'é'.repeat(offset) + '𠱸\ud800x\udc00';
+  assert.strictEqual(Buffer.byteLength(str), 2 * offset + 4 + 3 + 1 + 3);
+  assert.strictEqual(Buffer.byteLength(str), Buffer.from(str).length);
+}
 
 // base64
 assert.strictEqual(Buffer.byteLength('aGVsbG8gd29ybGQ=', 'base64'), 11);
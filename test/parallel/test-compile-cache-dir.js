@@ -0,0 +1,104 @@
+'use strict';
+
+// Verify that --compile-cache-dir writes the code cache of CommonJS and ES
+// modules, that later runs consume it, and that a changed file does not run
+// stale code.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+const cacheDir = path.join(tmpdir.path, 'cache');
+const cjs = path.join(tmpdir.path, 'main.js');
+const dep = path.join(tmpdir.path, 'dep.js');
+const esm = path.join(tmpdir.path, 'main.mjs');
+
+fs.writeFileSync(cjs, 'console.log(require("./dep.js")(1));');
+fs.writeFileSync(dep, 'module.exports = (x) => x + 1;');
+fs.writeFileSync(esm, 'import dep from "./dep.js"; console.log(dep(2));');
+
+function run(file) {
+  const child = spawnSync(process.execPath, [
+    `--compile-cache-dir=${cacheDir}`,
+    file,
+  ], {
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+    encoding: 'utf8',
+  });
+  assert.strictEqual(child.status, 0, child.stderr);
+  return child;
+}
+
+function cacheFiles() {
+  const [versionDir, ...rest] = fs.readdirSync(cacheDir);
+  assert.deepStrictEqual(rest, []);
+  return fs.readdirSync(path.join(cacheDir, versionDir));
+}
+
+{
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '2\n');
+  assert.match(child.stderr, /\[compile cache\] wrote .+: ok/);
+  assert.strictEqual(cacheFiles().length, 2);
+}
+
+{
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '2\n');
+  assert.match(child.stderr, /\[compile cache\] read \d+ bytes/);
+  assert.doesNotMatch(child.stderr, /rejected|wrote/);
+}
+
+// A cache file that was created for another module is not used, even though
+// it has the name that this module's cache would have.
+{
+  const versionDir = path.join(cacheDir, fs.readdirSync(cacheDir)[0]);
+  const [first, second] = cacheFiles().map((f) => path.join(versionDir, f));
+  const contents = fs.readFileSync(first);
+  fs.copyFileSync(second, first);
+  fs.writeFileSync(second, contents);
+
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '2\n');
+  assert.match(child.stderr, /was created for a different module/);
+  assert.doesNotMatch(child.stderr, /read \d+ bytes/);
+  assert.strictEqual(cacheFiles().length, 2);
+}
+
+{
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '2\n');
+  assert.doesNotMatch(child.stderr, /different module|wrote/);
+}
+
+{
+  const child = run(esm);
+  assert.strictEqual(child.stdout, '3\n');
+  assert.strictEqual(cacheFiles().length, 3);
+}
+
+{
+  const child = run(esm);
+  assert.strictEqual(child.stdout, '3\n');
+  assert.doesNotMatch(child.stderr, /rejected|wrote/);
+}
+
+// A modified module is compiled from source, and its cache is replaced.
+fs.writeFileSync(dep, 'module.exports = (x) => x * 10;');
+{
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '10\n');
+  assert.match(child.stderr, /was created for different code/);
+  assert.strictEqual(cacheFiles().length, 3);
+}
+
+{
+  const child = run(cjs);
+  assert.strictEqual(child.stdout, '10\n');
+  assert.doesNotMatch(child.stderr, /different code|wrote/);
+}
@@ -0,0 +1,153 @@
+'use strict';
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { COPYFILE_EXCL } = fs.constants;
+
+tmpdir.refresh();
+
+let count = 0;
+
+// Creates a tree with enough files in one directory to span several batches,
+// and returns the number of entries in it, including the root.
+function makeTree() {
+  const root = path.join(tmpdir.path, `copytree-${count++}`);
+  fs.mkdirSync(path.join(root, 'a', 'b', 'c'), { recursive: true });
+  fs.mkdirSync(path.join(root, 'empty'));
+  for (let i = 0; i < 600; i++)
+    fs.writeFileSync(path.join(root, 'a', `file-${i}`), `${i}`);
+  fs.writeFileSync(path.join(root, 'a', 'b', 'c', 'deep'), 'deep');
+  fs.writeFileSync(path.join(root, 'big'), Buffer.alloc(1024 * 1024, 'x'));
+  fs.chmodSync(path.join(root, 'big'), 0o640);
+  let entries = 607;
+  if (common.canCreateSymLink()) {
+    fs.symlinkSync(path.join('a', 'b'), path.join(root, 'link'));
+    entries++;
+  }
+  return { root, entries };
+}
+
+function assertSameTree(src, dest) {
+  const srcStats = fs.lstatSync(src);
+  const destStats = fs.lstatSync(dest);
+  if (srcStats.isSymbolicLink()) {
+    assert(destStats.isSymbolicLink());
+    assert.strictEqual(fs.readlinkSync(dest), fs.readlinkSync(src));
+  } else if (srcStats.isDirectory()) {
+    assert(destStats.isDirectory());
+    const names = fs.readdirSync(src).sort();
+    assert.deepStrictEqual(fs.readdirSync(dest).sort(), names);
+    for (const name of names)
+      assertSameTree(path.join(src, name), path.join(dest, name));
+  } else {
+    assert(destStats.isFile());
+    assert.deepStrictEqual(fs.readFileSync(dest), fs.readFileSync(src));
+    if (!common.isWindows)
+      assert.strictEqual(destStats.mode, srcStats.mode);
+  }
+}
+
+{
+  const { root, entries } = makeTree();
+  const dest = `${root}-copy`;
+  assert.strictEqual(fs.copyTreeSync(root, dest), entries);
+  assertSameTree(root, dest);
+
+  // Copying again overwrites what is there.
+  fs.writeFileSync(path.join(dest, 'big'), 'changed');
+  assert.strictEqual(fs.copyTreeSync(root, dest, { concurrency: 1 }), entries);
+  assertSameTree(root, dest);
+
+  // Unless COPYFILE_EXCL is given.
+  assert.throws(() => fs.copyTreeSync(root, dest, { mode: COPYFILE_EXCL }), {
+    code: 'EEXIST',
+  });
+}
+
+{
+  const { root, entries } = makeTree();
+  const dest = `${root}-copy`;
+  fs.copyTree(root, dest, common.mustCall((err, copied) => {
+    assert.ifError(err);
+    assert.strictEqual(copied, entries);
+    assertSameTree(root, dest);
+
+    // The copy can be removed again, also in parallel.
+    fs.rmdir(dest, { recursive: true }, common.mustCall((err) => {
+      assert.ifError(err);
+      assert(!fs.existsSync(dest));
+    }));
+  }));
+}
+
+{
+  const { root, entries } = makeTree();
+  const dest = `${root}-copy`;
+  fs.promises.copyTree(root, dest, { concurrency: 16 })
+    .then(common.mustCall((copied) => {
+      assert.strictEqual(copied, entries);
+      assertSameTree(root, dest);
+      return fs.promises.rmdir(dest, { recursive: true });
+    }))
+    .then(common.mustCall(() => {
+      assert(!fs.existsSync(dest));
+    }));
+}
+
+// Errors carry the path that could not be copied.
+{
+  const missing = path.join(tmpdir.path, 'copytree-missing');
+  const dest = path.join(tmpdir.path, 'copytree-missing-copy');
+  assert.throws(() => fs.copyTreeSync(missing, dest), {
+    code: 'ENOENT',
+    path: missing,
+  });
+  fs.copyTree(missing, dest, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.path, missing);
+  }));
+  assert.rejects(fs.promises.copyTree(missing, dest), {
+    code: 'ENOENT',
+    path: missing,
+  }).then(common.mustCall());
+
+  const file = path.join(tmpdir.path, 'copytree-file');
+  fs.writeFileSync(file, '');
+  assert.throws(() => fs.copyTreeSync(file, dest), { code: 'ENOTDIR' });
+}
+
+// A tree cannot be copied into itself.
+{
+  const { root } = makeTree();
+  for (const dest of [root, path.join(root, 'a', 'copy')]) {
+    assert.throws(() => fs.copyTreeSync(root, dest), {
+      code: 'ERR_INVALID_ARG_VALUE',
+    });
+  }
+}
+
+{
+  const src = path.join(tmpdir.path, 'copytree-src');
+  const dest = path.join(tmpdir.path, 'copytree-dest');
+  [false, 1, 'test', () => {}].forEach((options) => {
+    assert.throws(() => fs.copyTreeSync(src, dest, options), {
+      code: 'ERR_INVALID_ARG_TYPE',
+    });
+  });
+  [0, -1, 1.5, 2 ** 32].forEach((concurrency) => {
+    assert.throws(() => {
+      fs.copyTree(src, dest, { concurrency }, common.mustNotCall());
+    }, {
+      code: 'ERR_OUT_OF_RANGE',
+    });
+  });
+  assert.throws(() => fs.copyTreeSync(src, dest, { mode: 8 }), {
+    code: 'ERR_OUT_OF_RANGE',
+  });
+  assert.throws(() => fs.copyTree(src, dest), {
+    code: 'ERR_INVALID_CALLBACK',
+  });
+}
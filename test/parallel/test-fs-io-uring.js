@@ -0,0 +1,111 @@
+// Flags: --experimental-fs-io-uring --expose-internals
+'use strict';
+
+// The operations that --experimental-fs-io-uring covers must behave the same,
+// whether they end up in io_uring or, where that is not available, on the
+// threadpool.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { internalBinding } = require('internal/test/binding');
+
+tmpdir.refresh();
+
+const binding = internalBinding('fs');
+assert.strictEqual(typeof binding.useIoUring(true), 'boolean');
+if (!common.isLinux)
+  assert.strictEqual(binding.useIoUring(true), false);
+
+const filename = path.join(tmpdir.path, 'io-uring.txt');
+const missing = path.join(tmpdir.path, 'missing.txt');
+
+fs.open(filename, 'w+', common.mustCall((err, fd) => {
+  assert.ifError(err);
+  const data = Buffer.from('hello io_uring');
+
+  fs.write(fd, data, 0, data.length, 0, common.mustCall((err, written) => {
+    assert.ifError(err);
+    assert.strictEqual(written, data.length);
+
+    // A vectored write at the current position.
+    const parts = [Buffer.from(' and'), Buffer.from(' more')];
+    fs.writev(fd, parts, common.mustCall((err, written) => {
+      assert.ifError(err);
+      assert.strictEqual(written, 9);
+
+      fs.fsync(fd, common.mustCall((err) => {
+        assert.ifError(err);
+        fs.fdatasync(fd, common.mustCall((err) => {
+          assert.ifError(err);
+
+          const buffer = Buffer.alloc(64);
+          fs.read(fd, buffer, 0, buffer.length, 6, common.mustCall((err, n) => {
+            assert.ifError(err);
+            assert.strictEqual(buffer.toString('utf8', 0, n),
+                               'io_uring and more');
+
+            fs.fstat(fd, common.mustCall((err, stats) => {
+              assert.ifError(err);
+              assert.strictEqual(stats.size, 23);
+              assert(stats.isFile());
+              assert.deepStrictEqual(stats, fs.fstatSync(fd));
+
+              fs.close(fd, common.mustCall(assert.ifError));
+            }));
+          }));
+        }));
+      }));
+    }));
+  }));
+}));
+
+// Many concurrent requests, more than fit into the rings at once.
+for (let i = 0; i < 300; i++) {
+  fs.stat(__filename, common.mustCall((err, stats) => {
+    assert.ifError(err);
+    assert.strictEqual(stats.ino, fs.statSync(__filename).ino);
+  }));
+}
+
+fs.stat(missing, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'stat');
+  assert.strictEqual(err.path, missing);
+}));
+
+fs.lstat(missing, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'lstat');
+}));
+
+fs.close(2 ** 30, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'EBADF');
+  assert.strictEqual(err.syscall, 'close');
+}));
+
+fs.open(missing, 'r', common.mustCall((err) => {
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'open');
+  assert.strictEqual(err.path, missing);
+}));
+
+(async () => {
+  const filehandle = await fs.promises.open(__filename, 'r');
+  const { bytesRead, buffer } =
+    await filehandle.read(Buffer.alloc(13), 0, 13, 0);
+  assert.strictEqual(bytesRead, 13);
+  assert.strictEqual(buffer.toString(), '// Flags: --e');
+  const stats = await filehandle.stat();
+  assert.strictEqual(stats.size, fs.statSync(__filename).size);
+  await filehandle.close();
+})().then(common.mustCall());
+
+// Turning io_uring off again only affects later requests.
+fs.stat(__filename, common.mustCall((err) => {
+  assert.ifError(err);
+  binding.useIoUring(false);
+  fs.stat(__filename, common.mustCall(assert.ifError));
+}));
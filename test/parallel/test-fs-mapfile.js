@@ -0,0 +1,83 @@
+'use strict';
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { Worker } = require('worker_threads');
+
+tmpdir.refresh();
+
+const data = Buffer.alloc(3 * 4096 + 17);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 13) % 256;
+const filename = path.join(tmpdir.path, 'mapfile');
+fs.writeFileSync(filename, data);
+
+for (const advice of [undefined, 'normal', 'sequential', 'random',
+                      'willneed']) {
+  const sab = fs.mapFileSync(filename, { advice });
+  assert(sab instanceof SharedArrayBuffer);
+  assert.deepStrictEqual(Buffer.from(sab), data);
+}
+
+fs.mapFile(filename, common.mustCall((err, sab) => {
+  assert.ifError(err);
+  assert(sab instanceof SharedArrayBuffer);
+  assert.deepStrictEqual(Buffer.from(sab), data);
+
+  // Writes stay in memory and do not reach the file.
+  new Uint8Array(sab)[0] = data[0] + 1;
+  assert.deepStrictEqual(fs.readFileSync(filename), data);
+}));
+
+fs.promises.mapFile(filename, { advice: 'random' }).then(common.mustCall(
+  (sab) => assert.deepStrictEqual(Buffer.from(sab), data)));
+
+// Workers share the mapping.
+{
+  const sab = fs.mapFileSync(filename);
+  const worker = new Worker(`
+    const { parentPort, workerData } = require('worker_threads');
+    const view = new Uint8Array(workerData);
+    let sum = 0;
+    for (let i = 0; i < view.length; i++)
+      sum += view[i];
+    view[1] = 42;
+    parentPort.postMessage(sum);
+  `, { eval: true, workerData: sab });
+  worker.on('message', common.mustCall((sum) => {
+    assert.strictEqual(sum, data.reduce((a, b) => a + b, 0));
+    assert.strictEqual(new Uint8Array(sab)[1], 42);
+  }));
+}
+
+{
+  const empty = path.join(tmpdir.path, 'mapfile-empty');
+  fs.writeFileSync(empty, '');
+  assert.strictEqual(fs.mapFileSync(empty).byteLength, 0);
+}
+
+{
+  const missing = path.join(tmpdir.path, 'mapfile-missing');
+  assert.throws(() => fs.mapFileSync(missing),
+                { code: 'ENOENT', syscall: 'open', path: missing });
+  fs.mapFile(missing, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(err.path, missing);
+  }));
+}
+
+if (!common.isWindows) {
+  assert.throws(() => fs.mapFileSync(tmpdir.path),
+                { code: 'EISDIR', syscall: 'mmap' });
+}
+
+assert.throws(() => fs.mapFileSync(filename, { advice: 'never' }),
+              { code: 'ERR_INVALID_OPT_VALUE' });
+assert.throws(() => fs.mapFileSync(filename, 'random'),
+              { code: 'ERR_INVALID_ARG_TYPE' });
+assert.throws(() => fs.mapFile(filename),
+              { code: 'ERR_INVALID_CALLBACK' });
@@ -0,0 +1,58 @@
+'use strict';
+const common = require('../common');
+
+// Large latin1 and ASCII results of fs.readFile() can take over the memory
+// of the buffer that the file was read into. Verify that they still decode
+// correctly, including data that needs converting or copying.
+
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+const len = 2 * 1024 * 1024 + 3;
+const ascii = Buffer.alloc(len, 'the quick brown fox\n');
+const binary = Buffer.allocUnsafe(len);
+for (let i = 0; i < len; i++)
+  binary[i] = (i * 7) & 0xff;
+const utf8 = Buffer.from('ünïcödé '.repeat(len / 8));
+
+const files = { ascii, binary, utf8 };
+for (const name of Object.keys(files))
+  fs.writeFileSync(path.join(tmpdir.path, name), files[name]);
+
+const cases = [
+  ['ascii', 'utf8'],
+  ['ascii', 'latin1'],
+  ['binary', 'latin1'],
+  ['binary', 'binary'],
+  ['binary', 'ascii'],
+  ['binary', 'utf8'],
+  ['binary', 'hex'],
+  ['utf8', 'utf8'],
+  ['utf8', 'UTF-8'],
+  ['utf8', 'ucs2'],
+];
+
+for (const [name, encoding] of cases) {
+  const file = path.join(tmpdir.path, name);
+  const expected = files[name].toString(encoding);
+
+  assert.strictEqual(fs.readFileSync(file, encoding), expected);
+  assert.strictEqual(fs.readFileSync(file, { encoding }), expected);
+
+  fs.readFile(file, encoding, common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, expected);
+  }));
+
+  fs.promises.readFile(file, encoding).then(common.mustCall((data) => {
+    assert.strictEqual(data, expected);
+  }));
+}
+
+// The string's memory is reported as external memory.
+const latin1 = fs.readFileSync(path.join(tmpdir.path, 'binary'), 'latin1');
+assert(process.memoryUsage().external >= latin1.length);
@@ -0,0 +1,83 @@
+'use strict';
+
+// fs.readFile() reads small regular files in a single native job and hands
+// everything else to the chunked reader. Both must give the same results.
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+const kJobMaxSize = 512 * 1024;
+const encodings = [undefined, 'utf8', 'latin1', 'ascii', 'hex', 'base64',
+                   'ucs2'];
+
+for (const size of [1, 1000, kJobMaxSize - 1, kJobMaxSize, kJobMaxSize + 1]) {
+  const data = Buffer.alloc(size);
+  for (let i = 0; i < size; i++)
+    data[i] = (i * 7) % 256;
+  const filename = path.join(tmpdir.path, `readfile-job-${size}`);
+  fs.writeFileSync(filename, data);
+
+  for (const encoding of encodings) {
+    fs.readFile(filename, encoding, common.mustCall((err, result) => {
+      assert.ifError(err);
+      if (encoding === undefined)
+        assert.deepStrictEqual(result, data);
+      else
+        assert.strictEqual(result, data.toString(encoding));
+    }));
+  }
+}
+
+// Empty files.
+{
+  const filename = path.join(tmpdir.path, 'readfile-job-empty');
+  fs.writeFileSync(filename, '');
+  fs.readFile(filename, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, Buffer.alloc(0));
+  }));
+  fs.readFile(filename, 'utf8', common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.strictEqual(result, '');
+  }));
+}
+
+// A file descriptor is read from its current position and left open.
+{
+  const filename = path.join(tmpdir.path, 'readfile-job-fd');
+  fs.writeFileSync(filename, 'hello world');
+  const fd = fs.openSync(filename, 'r');
+  fs.readSync(fd, Buffer.alloc(6), 0, 6, null);
+  fs.readFile(fd, 'utf8', common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.strictEqual(result, 'world');
+    fs.fstatSync(fd);
+    fs.closeSync(fd);
+  }));
+}
+
+{
+  const filename = path.join(tmpdir.path, 'readfile-job-missing');
+  fs.readFile(filename, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(err.path, filename);
+  }));
+}
+
+fs.readFile(tmpdir.path, common.mustCall((err) => {
+  assert.strictEqual(err.code, 'EISDIR');
+}));
+
+if (common.isLinux) {
+  // The procfs files claim to be empty, so they are read in chunks.
+  fs.readFile('/proc/self/status', 'utf8', common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert(result.startsWith('Name:'));
+  }));
+}
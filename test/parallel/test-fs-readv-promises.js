@@ -0,0 +1,96 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs').promises;
+const tmpdir = require('../common/tmpdir');
+const expected = 'ümlaut. Лорем 運務ホソモ指及 आपको करने विकास 紙読決多密所 أضف';
+const expectedBuff = Buffer.from(expected);
+
+tmpdir.refresh();
+
+const filename = path.join(tmpdir.path, 'readv_promises.txt');
+
+(async () => {
+  await fs.writeFile(filename, expectedBuff);
+  const handle = await fs.open(filename, 'r');
+
+  // filehandle.readv() with a position.
+  {
+    const bufferArr = [Buffer.alloc(10), Buffer.alloc(expectedBuff.length)];
+    const { bytesRead, buffers } = await handle.readv(bufferArr, 0);
+    assert.strictEqual(bytesRead, expectedBuff.length);
+    assert.strictEqual(buffers, bufferArr);
+    assert(Buffer.concat(bufferArr).slice(0, bytesRead).equals(expectedBuff));
+  }
+
+  // filehandle.readv() without a position.
+  {
+    const bufferArr = [Buffer.alloc(4), Buffer.alloc(4)];
+    let { bytesRead } = await handle.readv(bufferArr);
+    assert.strictEqual(bytesRead, 8);
+    assert(Buffer.concat(bufferArr).equals(expectedBuff.slice(0, 8)));
+    ({ bytesRead } = await handle.readv(bufferArr));
+    assert.strictEqual(bytesRead, 8);
+    assert(Buffer.concat(bufferArr).equals(expectedBuff.slice(8, 16)));
+  }
+
+  // filehandle.readBatch() reads every range and leaves the file position
+  // alone.
+  {
+    const positions = [0, 20, expectedBuff.length - 2, expectedBuff.length];
+    const bufferArr = [
+      Buffer.alloc(5),
+      new Uint8Array(30),
+      Buffer.alloc(10),
+      Buffer.alloc(3),
+    ];
+    const { bytesRead, buffers } =
+      await handle.readBatch(bufferArr, positions);
+    assert.deepStrictEqual(bytesRead, [5, 30, 2, 0]);
+    assert.strictEqual(buffers, bufferArr);
+    for (let i = 0; i < positions.length; i++) {
+      assert.deepStrictEqual(
+        Buffer.from(bufferArr[i]).slice(0, bytesRead[i]),
+        expectedBuff.slice(positions[i], positions[i] + bytesRead[i]));
+    }
+
+    const next = [Buffer.alloc(4)];
+    await handle.readv(next);
+    assert(next[0].equals(expectedBuff.slice(16, 20)));
+  }
+
+  // A large batch of small reads.
+  {
+    const positions = [];
+    const bufferArr = [];
+    for (let i = 0; i < 1000; i++) {
+      positions.push(i % expectedBuff.length);
+      bufferArr.push(Buffer.alloc(1));
+    }
+    const { bytesRead } = await handle.readBatch(bufferArr, positions);
+    assert.strictEqual(bytesRead.length, 1000);
+    for (let i = 0; i < 1000; i++) {
+      assert.strictEqual(bytesRead[i], 1);
+      assert.strictEqual(bufferArr[i][0], expectedBuff[positions[i]]);
+    }
+  }
+
+  assert.deepStrictEqual(await handle.readBatch([], []),
+                         { bytesRead: [], buffers: [] });
+
+  await assert.rejects(handle.readBatch([Buffer.alloc(1)], [0, 1]),
+                       { code: 'ERR_INVALID_ARG_VALUE' });
+  await assert.rejects(handle.readBatch([Buffer.alloc(1)], [-1]),
+                       { code: 'ERR_OUT_OF_RANGE' });
+  await assert.rejects(handle.readBatch([Buffer.alloc(1)], 0),
+                       { code: 'ERR_INVALID_ARG_TYPE' });
+  await assert.rejects(handle.readBatch(['abc'], [0]),
+                       { code: 'ERR_INVALID_ARG_TYPE' });
+
+  await handle.close();
+
+  await assert.rejects(handle.readBatch([Buffer.alloc(1)], [0]),
+                       { code: 'EBADF', syscall: 'read' });
+})().then(common.mustCall());
@@ -0,0 +1,94 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const path = require('path');
+const fs = require('fs');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const expected = 'ümlaut. Лорем 運務ホソモ指及 आपको करने विकास 紙読決多密所 أضف';
+const expectedBuff = Buffer.from(expected);
+const expectedLength = expectedBuff.length;
+
+const filename = path.join(tmpdir.path, 'readv.txt');
+fs.writeFileSync(filename, expectedBuff);
+
+const allocateEmptyBuffers = (combinedLength) => {
+  const bufferArr = [];
+  // Allocate two buffers, each half the size of expectedBuff
+  bufferArr[0] = Buffer.alloc(Math.floor(combinedLength / 2));
+  bufferArr[1] = Buffer.alloc(combinedLength - bufferArr[0].length);
+
+  return bufferArr;
+};
+
+// fs.readv with an array of buffers and a position
+{
+  const fd = fs.openSync(filename, 'r');
+  const bufferArr = allocateEmptyBuffers(expectedLength);
+
+  fs.readv(fd, bufferArr, 0, common.mustCall((err, bytesRead, buffers) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(buffers, bufferArr);
+    assert.strictEqual(bytesRead, expectedLength);
+    assert(Buffer.concat(bufferArr).equals(expectedBuff));
+    fs.closeSync(fd);
+  }));
+}
+
+// fs.readv without a position reads from the current position
+{
+  const fd = fs.openSync(filename, 'r');
+  const bufferArr = allocateEmptyBuffers(expectedLength);
+
+  fs.readv(fd, bufferArr, common.mustCall((err, bytesRead, buffers) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(buffers, bufferArr);
+    assert.strictEqual(bytesRead, expectedLength);
+    assert(Buffer.concat(bufferArr).equals(expectedBuff));
+
+    // The file position has moved to the end of the file.
+    fs.readv(fd, bufferArr, common.mustCall((err, bytesRead) => {
+      assert.ifError(err);
+      assert.strictEqual(bytesRead, 0);
+      fs.closeSync(fd);
+    }));
+  }));
+}
+
+// fs.readvSync
+{
+  const fd = fs.openSync(filename, 'r');
+  const bufferArr = allocateEmptyBuffers(expectedLength);
+
+  assert.strictEqual(fs.readvSync(fd, bufferArr, 0), expectedLength);
+  assert(Buffer.concat(bufferArr).equals(expectedBuff));
+
+  const short = [Buffer.alloc(5)];
+  assert.strictEqual(fs.readvSync(fd, short, expectedLength - 3), 3);
+  assert(short[0].slice(0, 3).equals(expectedBuff.slice(-3)));
+  fs.closeSync(fd);
+}
+
+// Invalid arguments
+{
+  const fd = fs.openSync(filename, 'r');
+  [null, 'abc', [1, 2], {}].forEach((buffers) => {
+    assert.throws(
+      () => fs.readv(fd, buffers, null, common.mustNotCall()),
+      { code: 'ERR_INVALID_ARG_TYPE', name: 'TypeError' }
+    );
+    assert.throws(
+      () => fs.readvSync(fd, buffers, null),
+      { code: 'ERR_INVALID_ARG_TYPE', name: 'TypeError' }
+    );
+  });
+  fs.closeSync(fd);
+
+  assert.throws(
+    () => fs.readvSync('abc', [Buffer.alloc(1)]),
+    { code: 'ERR_INVALID_ARG_TYPE', name: 'TypeError' }
+  );
+}
@@ -0,0 +1,113 @@
+'use strict';
+
+const common = require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+const root = path.join(tmpdir.path, 'walk');
+const files = [
+  'a.txt',
+  'b/c.txt',
+  'b/d/e.txt',
+  'b/d/f/g.txt',
+  'h/i.txt',
+];
+const dirs = ['b', 'b/d', 'b/d/f', 'h', 'j'];
+for (const dir of dirs)
+  fs.mkdirSync(path.join(root, dir), { recursive: true });
+for (const file of files)
+  fs.writeFileSync(path.join(root, file), file);
+for (let i = 0; i < 100; i++)
+  fs.writeFileSync(path.join(root, 'j', `${i}`), '');
+
+const expected = [...files, ...dirs];
+for (let i = 0; i < 100; i++)
+  expected.push(`j/${i}`);
+const native = (name) => name.split('/').join(path.sep);
+
+async function collect(dir, options) {
+  const entries = [];
+  for await (const dirent of fs.walk(dir, options))
+    entries.push(dirent);
+  return entries;
+}
+
+(async () => {
+  for (const bufferSize of [1, 7, 1024]) {
+    const entries = await collect(root, { bufferSize });
+    const names = entries.map((dirent) => dirent.name);
+    assert.deepStrictEqual(names.slice().sort(),
+                           expected.map(native).sort());
+
+    const seen = new Set();
+    for (const dirent of entries) {
+      assert(dirent instanceof fs.Dirent);
+      assert.strictEqual(dirent.stats, undefined);
+      const stats = fs.lstatSync(path.join(root, dirent.name));
+      assert.strictEqual(dirent.isDirectory(), stats.isDirectory());
+      assert.strictEqual(dirent.isFile(), stats.isFile());
+      // Directories come before their contents.
+      const parent = path.dirname(dirent.name);
+      assert(parent === '.' || seen.has(parent));
+      seen.add(dirent.name);
+    }
+  }
+
+  for (const dirent of await collect(root, { withStats: true })) {
+    const stats = fs.lstatSync(path.join(root, dirent.name));
+    assert(dirent.stats instanceof fs.Stats);
+    assert.strictEqual(dirent.stats.dev, stats.dev);
+    assert.strictEqual(dirent.stats.rdev, stats.rdev);
+    assert.strictEqual(dirent.stats.ino, stats.ino);
+    assert.strictEqual(dirent.stats.size, stats.size);
+    assert.strictEqual(dirent.stats.mode, stats.mode);
+    assert.strictEqual(dirent.stats.mtimeMs, stats.mtimeMs);
+  }
+
+  for (const dirent of await collect(root, { withStats: true, bigint: true }))
+    assert.strictEqual(typeof dirent.stats.size, 'bigint');
+
+  {
+    const entries = await collect(Buffer.from(root), { encoding: 'buffer' });
+    assert.strictEqual(entries.length, expected.length);
+    assert(entries.every((dirent) => Buffer.isBuffer(dirent.name)));
+  }
+
+  // Breaking out of the loop early is fine.
+  for await (const dirent of fs.walk(root, { bufferSize: 2 })) {
+    assert(dirent);
+    break;
+  }
+
+  if (!common.isWindows) {
+    // Symbolic links are not followed.
+    const link = path.join(tmpdir.path, 'walk-link');
+    fs.mkdirSync(link);
+    fs.symlinkSync(root, path.join(link, 'to-root'));
+    const entries = await collect(link);
+    assert.strictEqual(entries.length, 1);
+    assert.strictEqual(entries[0].name, 'to-root');
+    assert(entries[0].isSymbolicLink());
+  }
+
+  {
+    const entries = await collect(path.join(root, 'b', 'd', 'f'));
+    assert.strictEqual(entries.length, 1);
+    assert.strictEqual(entries[0].name, 'g.txt');
+    assert(entries[0].isFile());
+  }
+
+  const missing = path.join(tmpdir.path, 'walk-missing');
+  await assert.rejects(collect(missing),
+                       { code: 'ENOENT', syscall: 'opendir' });
+  await assert.rejects(collect(path.join(root, 'a.txt')),
+                       { code: 'ENOTDIR', syscall: 'opendir' });
+
+  assert.throws(() => fs.walk(root, { bufferSize: 0 }),
+                { code: 'ERR_OUT_OF_RANGE' });
+  assert.throws(() => fs.walk(42), { code: 'ERR_INVALID_ARG_TYPE' });
+})().then(common.mustCall());
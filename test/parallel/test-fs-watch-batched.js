@@ -0,0 +1,78 @@
+'use strict';
+
+const common = require('../common');
+
+if (common.isIBMi)
+  common.skip('IBMi does not support `fs.watch()`');
+
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+const recursive = common.isLinux || common.isOSX || common.isWindows;
+
+{
+  const root = path.join(tmpdir.path, 'watch-batched');
+  fs.mkdirSync(root);
+  const file = path.join(root, 'file.txt');
+  fs.writeFileSync(file, '');
+
+  const expected = new Set(['file.txt', 'new.txt']);
+  if (recursive)
+    expected.add(path.join('sub', 'nested.txt'));
+  const seen = new Set();
+
+  const watcher = fs.watchBatched(root, { recursive, delay: 20 });
+  watcher.on('change', common.mustCallAtLeast((changes, overflow) => {
+    assert.strictEqual(typeof overflow, 'boolean');
+    assert(Array.isArray(changes));
+    const filenames = new Set();
+    for (const { eventType, filename } of changes) {
+      assert(eventType === 'rename' || eventType === 'change');
+      assert.strictEqual(typeof filename, 'string');
+      // Changes are coalesced per filename within a batch.
+      assert(!filenames.has(filename));
+      filenames.add(filename);
+      seen.add(filename);
+    }
+    if ([...expected].every((filename) => seen.has(filename)))
+      watcher.close();
+  }, 1));
+  watcher.on('close', common.mustCall());
+
+  setTimeout(() => {
+    for (let i = 0; i < 100; i++)
+      fs.appendFileSync(file, `${i}\n`);
+    fs.writeFileSync(path.join(root, 'new.txt'), 'new');
+    if (recursive) {
+      fs.mkdirSync(path.join(root, 'sub'));
+      fs.writeFileSync(path.join(root, 'sub', 'nested.txt'), 'nested');
+    }
+  }, common.platformTimeout(100));
+}
+
+{
+  const missing = path.join(tmpdir.path, 'watch-batched-missing');
+  assert.throws(() => fs.watchBatched(missing), {
+    code: 'ENOENT',
+    syscall: 'watch',
+    filename: missing,
+  });
+}
+
+{
+  const watcher = fs.watchBatched(tmpdir.path, { persistent: false });
+  assert.strictEqual(watcher.unref(), watcher);
+  assert.strictEqual(watcher.ref(), watcher);
+  watcher.close();
+  watcher.close();
+
+  [-1, 1.5, '10', null].forEach((delay) => {
+    assert.throws(() => fs.watchBatched(tmpdir.path, { delay }), {
+      code: /^ERR_(OUT_OF_RANGE|INVALID_ARG_TYPE)$/,
+    });
+  });
+}
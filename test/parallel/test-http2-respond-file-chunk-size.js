@@ -0,0 +1,91 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const fixtures = require('../common/fixtures');
+const assert = require('assert');
+const async_hooks = require('async_hooks');
+const http2 = require('http2');
+const fs = require('fs');
+
+// Checks that the chunkSize option of respondWithFD() and respondWithFile()
+// is validated, and determines how much data each read from the file takes.
+
+const fname = fixtures.path('person-large.jpg');
+const data = fs.readFileSync(fname);
+
+// Every read from the file is made through a new FSREQCALLBACK resource.
+let reads = 0;
+async_hooks.createHook({
+  init(id, type) {
+    if (type === 'FSREQCALLBACK')
+      reads++;
+  }
+}).enable();
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  const chunkSize = +headers['x-chunk-size'] || undefined;
+  const fd = fs.openSync(fname, 'r');
+  stream.on('close', () => fs.closeSync(fd));
+  stream.respondWithFD(fd, {}, { chunkSize });
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+
+  function request(chunkSize, callback) {
+    const req = client.request({ 'x-chunk-size': `${chunkSize || ''}` });
+    const chunks = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), data);
+      callback();
+    }));
+    req.end();
+  }
+
+  const chunkSize = 4096;
+  reads = 0;
+  request(chunkSize, common.mustCall(() => {
+    assert(reads >= Math.ceil(data.length / chunkSize), `${reads} reads`);
+
+    reads = 0;
+    request(undefined, common.mustCall(() => {
+      assert(reads <= Math.ceil(data.length / 65536) + 1, `${reads} reads`);
+      client.close();
+      server.close();
+    }));
+  }));
+}));
+
+{
+  const invalidServer = http2.createServer();
+  invalidServer.on('stream', common.mustCall((stream) => {
+    for (const chunkSize of [0, -1, 1.5, 2 ** 31, '1024', null, NaN]) {
+      for (const method of ['respondWithFD', 'respondWithFile']) {
+        assert.throws(() => stream[method](0, {}, { chunkSize }), {
+          code: 'ERR_INVALID_OPT_VALUE',
+          name: 'TypeError',
+          message: `The value "${String(chunkSize)}" is invalid ` +
+                   'for option "chunkSize"'
+        });
+      }
+    }
+    stream.respond();
+    stream.end();
+  }));
+
+  invalidServer.listen(0, common.mustCall(() => {
+    const client =
+      http2.connect(`http://localhost:${invalidServer.address().port}`);
+    const req = client.request();
+    req.resume();
+    req.on('end', common.mustCall(() => {
+      client.close();
+      invalidServer.close();
+    }));
+    req.end();
+  }));
+}
@@ -0,0 +1,53 @@
+'use strict';
+
+// Verify that --module-bundle refuses files that it cannot start up from.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+function header(nodeVersion) {
+  return Buffer.concat([
+    Buffer.from('NODEBNDL'),
+    u32(1),
+    u32(Buffer.byteLength(nodeVersion)),
+    Buffer.from(nodeVersion),
+  ]);
+}
+
+function u32(value) {
+  const buf = Buffer.alloc(4);
+  buf.writeUInt32LE(value);
+  return buf;
+}
+
+function check(file, expected) {
+  const child = spawnSync(process.execPath, [
+    `--module-bundle=${file}`,
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.status, 9);
+  assert.strictEqual(child.stdout, '');
+  assert.match(child.stderr, expected);
+}
+
+check(path.join(tmpdir.path, 'missing.bundle'), /Cannot read module bundle/);
+
+const garbage = path.join(tmpdir.path, 'garbage.bundle');
+fs.writeFileSync(garbage, 'this is not a module bundle');
+check(garbage, /Not a Node\.js module bundle/);
+
+const mismatch = path.join(tmpdir.path, 'mismatch.bundle');
+fs.writeFileSync(mismatch, header('v0.0.0'));
+check(mismatch, /was built by Node\.js v0\.0\.0, which does not match/);
+
+const truncated = path.join(tmpdir.path, 'truncated.bundle');
+fs.writeFileSync(truncated, Buffer.concat([
+  header(process.version),
+  u32(1000),
+]));
+check(truncated, /Module bundle is malformed/);
@@ -0,0 +1,121 @@
+'use strict';
+
+// Verify that --build-module-bundle writes the modules that the entry point
+// loads to the --module-bundle file, and that starting up from the bundle runs
+// the entry point with the resolutions and the unchanged sources taken from
+// the bundle.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+function run(args) {
+  return spawnSync(process.execPath, args, {
+    env: { ...process.env, NODE_DEBUG_NATIVE: 'MODULE_BUNDLE' },
+    encoding: 'utf8',
+  });
+}
+
+const bundle = path.join(tmpdir.path, 'app.bundle');
+const entry = path.join(tmpdir.path, 'entry.js');
+const lib = path.join(tmpdir.path, 'lib.js');
+const data = path.join(tmpdir.path, 'data.json');
+
+fs.writeFileSync(lib, 'module.exports = { value: 21 };');
+fs.writeFileSync(data, '{ "name": "from-json" }');
+fs.writeFileSync(entry, `
+const { value } = require('./lib');
+const { name } = require('./data');
+console.log(JSON.stringify({
+  answer: value * 2,
+  name,
+  argv: process.argv.slice(2),
+  filename: __filename,
+  main: require.main === module,
+}));
+`);
+const entryPath = fs.realpathSync(entry);
+
+{
+  const child = run([`--module-bundle=${bundle}`, '--build-module-bundle',
+                     entry]);
+  assert.strictEqual(child.stderr, '');
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(JSON.parse(child.stdout).answer, 42);
+  assert(fs.existsSync(bundle));
+}
+
+// Requests are not resolved again: ./data now resolves to data.js, but the
+// bundle keeps using data.json.
+fs.writeFileSync(path.join(tmpdir.path, 'data.js'),
+                 'module.exports = { name: "from-js" };');
+
+{
+  const child = run([entry]);
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(JSON.parse(child.stdout).name, 'from-js');
+}
+
+{
+  const child = run([`--module-bundle=${bundle}`, 'a', 'b']);
+  assert.strictEqual(child.stderr, '');
+  assert.strictEqual(child.status, 0);
+  assert.deepStrictEqual(JSON.parse(child.stdout), {
+    answer: 42,
+    name: 'from-json',
+    argv: ['a', 'b'],
+    filename: entryPath,
+    main: true,
+  });
+}
+
+// A file that has changed since the bundle was built is read from disk.
+fs.writeFileSync(lib, 'module.exports = { value: 500 };');
+
+{
+  const child = run([`--module-bundle=${bundle}`]);
+  assert.match(child.stderr, /\[module bundle\] .*lib\.js has changed/);
+  assert.strictEqual(child.status, 0);
+  assert.strictEqual(JSON.parse(child.stdout).answer, 1000);
+}
+
+// So is a file that is gone, which fails to load.
+fs.unlinkSync(data);
+
+{
+  const child = run([`--module-bundle=${bundle}`]);
+  assert.match(child.stderr, /\[module bundle\] .*data\.json has changed/);
+  assert.match(child.stderr, /ENOENT/);
+  assert.notStrictEqual(child.status, 0);
+}
+
+// A failing entry point leaves an existing file untouched.
+const failing = path.join(tmpdir.path, 'failing.js');
+const failingBundle = path.join(tmpdir.path, 'failing.bundle');
+fs.writeFileSync(failingBundle, 'previous contents');
+for (const code of [
+  'throw new Error("sync")',
+  'Promise.reject(new Error("rejection"))',
+  'queueMicrotask(() => { throw new Error("microtask"); })',
+  'process.exitCode = 3',
+]) {
+  fs.writeFileSync(failing, code);
+  const child = run([
+    `--module-bundle=${failingBundle}`, '--build-module-bundle', failing,
+  ]);
+  assert.notStrictEqual(child.status, 0, code);
+  assert.strictEqual(fs.readFileSync(failingBundle, 'utf8'),
+                     'previous contents');
+}
+
+{
+  const child = run(['--build-module-bundle', entry]);
+  assert.strictEqual(child.status, 9);
+  assert.match(child.stderr,
+               /--build-module-bundle requires --module-bundle/);
+}
@@ -0,0 +1,101 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { createHistogram } = require('perf_hooks');
+const { Worker } = require('worker_threads');
+
+{
+  const h = createHistogram();
+  assert.strictEqual(h.exceeds, 0);
+  // More values than fit into one batch.
+  for (let i = 1; i <= 1000; i++)
+    h.record(i);
+  assert.strictEqual(h.min, 1);
+  assert.strictEqual(h.max, 1000);
+  assert.strictEqual(h.mean, 500.5);
+  assert.strictEqual(h.percentile(50), 500);
+  assert(h.percentiles.size > 0);
+
+  const first = h.snapshot({ reset: true });
+  assert.strictEqual(first.max, 1000);
+  assert.strictEqual(h.max, 0);
+  h.record(7);
+  const second = h.snapshot();
+  assert.strictEqual(second.min, 7);
+  assert.strictEqual(second.max, 7);
+  // Snapshots are copies.
+  assert.strictEqual(first.max, 1000);
+  assert.strictEqual(h.max, 7);
+
+  h.reset();
+  assert.strictEqual(h.max, 0);
+}
+
+{
+  const h = createHistogram({ lowest: 1, highest: 100, figures: 1 });
+  h.record(20);
+  h.record(1000);
+  assert.strictEqual(h.max, 20);
+  assert.strictEqual(h.exceeds, 1);
+  assert.strictEqual(h.snapshot().exceeds, 1);
+}
+
+{
+  const h = createHistogram();
+  h.recordDelta();
+  h.recordDelta();
+  assert(h.min > 0);
+}
+
+[null, 'a', 1].forEach((i) => {
+  assert.throws(() => createHistogram(i), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
+[{ lowest: 0 }, { lowest: 1.5 }, { lowest: 10, highest: 19 },
+ { figures: 0 }, { figures: 6 }].forEach((i) => {
+  assert.throws(() => createHistogram(i), {
+    code: 'ERR_INVALID_OPT_VALUE'
+  });
+});
+assert.throws(() => createHistogram({ buffer: new ArrayBuffer(8) }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => createHistogram({ buffer: new SharedArrayBuffer(8) }), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+[-1, 1.5, 'a'].forEach((i) => {
+  assert.throws(() => createHistogram().record(i), {
+    code: typeof i === 'number' ? 'ERR_INVALID_ARG_VALUE' :
+      'ERR_INVALID_ARG_TYPE'
+  });
+});
+
+{
+  // Values recorded on other threads are merged into the same histogram.
+  const h = createHistogram();
+  h.record(1);
+  const count = 4;
+  let exited = 0;
+  for (let i = 0; i < count; i++) {
+    const w = new Worker(`
+      const { createHistogram } = require('perf_hooks');
+      const { workerData } = require('worker_threads');
+      const h = createHistogram({ buffer: workerData });
+      for (let i = 0; i < 300; i++)
+        h.record(1000);
+    `, { eval: true, workerData: h.buffer });
+    w.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+      if (++exited < count) return;
+      assert.strictEqual(h.min, 1);
+      assert.strictEqual(h.max, 1000);
+      const snapshot = h.snapshot({ reset: true });
+      assert.strictEqual(snapshot.percentile(100), 1000);
+      assert.strictEqual(snapshot.mean, (1 + count * 300 * 1000) /
+                                        (1 + count * 300));
+      assert.strictEqual(h.max, 0);
+    }));
+  }
+}
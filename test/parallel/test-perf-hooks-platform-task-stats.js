@@ -0,0 +1,32 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const { getPlatformTaskStats } = require('perf_hooks');
+
+const lanes = ['userBlocking', 'normal', 'lowPriority'];
+const fields = ['tasks', 'steals', 'waitTime', 'maxWaitTime', 'runTime'];
+
+function check(stats) {
+  assert.deepStrictEqual(Object.keys(stats), lanes);
+  for (const lane of lanes) {
+    assert.deepStrictEqual(Object.keys(stats[lane]), fields);
+    for (const field of fields) {
+      assert.strictEqual(typeof stats[lane][field], 'number');
+      assert(stats[lane][field] >= 0);
+    }
+    assert(stats[lane].steals <= stats[lane].tasks);
+    assert(stats[lane].maxWaitTime <= stats[lane].waitTime);
+  }
+  return lanes.reduce((sum, lane) => sum + stats[lane].tasks, 0);
+}
+
+const before = check(getPlatformTaskStats());
+
+// Asynchronous WebAssembly compilation runs on the worker threads.
+const bytes = fixtures.readSync('simple.wasm');
+WebAssembly.compile(bytes).then(common.mustCall(() => {
+  const after = check(getPlatformTaskStats());
+  assert(after > before, `${after} > ${before}`);
+}));
@@ -0,0 +1,39 @@
+// Flags: --experimental-fs-io-uring --expose-internals
+'use strict';
+
+// File system requests that run through io_uring rather than on the
+// threadpool have their latency recorded as well.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const {
+  startRequestLatencyTracking,
+  stopRequestLatencyTracking,
+  getRequestLatency,
+} = require('perf_hooks');
+const { internalBinding } = require('internal/test/binding');
+
+if (!internalBinding('fs').useIoUring(true))
+  common.skip('io_uring is not available');
+
+startRequestLatencyTracking();
+
+const count = 5;
+let done = 0;
+for (let i = 0; i < count; i++) {
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    if (++done < count) return;
+
+    const { FSREQCALLBACK } = getRequestLatency({ reset: true });
+    assert(FSREQCALLBACK.min > 0);
+    assert(FSREQCALLBACK.max >= FSREQCALLBACK.min);
+
+    fs.promises.stat(__filename).then(common.mustCall(() => {
+      const { FSREQPROMISE } = getRequestLatency();
+      assert(FSREQPROMISE.min > 0);
+      stopRequestLatencyTracking();
+    }));
+  }));
+}
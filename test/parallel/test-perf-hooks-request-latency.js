@@ -0,0 +1,48 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const {
+  startRequestLatencyTracking,
+  stopRequestLatencyTracking,
+  getRequestLatency,
+} = require('perf_hooks');
+
+assert.strictEqual(getRequestLatency(), undefined);
+
+[null, 'a', 1].forEach((i) => {
+  assert.throws(() => getRequestLatency(i), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
+
+// Requests that complete while tracking is not enabled are not recorded.
+fs.stat(__filename, common.mustCall((err) => {
+  assert.ifError(err);
+  startRequestLatencyTracking();
+  assert.deepStrictEqual(getRequestLatency(), {});
+
+  const count = 5;
+  let done = 0;
+  for (let i = 0; i < count; i++) {
+    fs.stat(__filename, common.mustCall((err) => {
+      assert.ifError(err);
+      if (++done < count) return;
+
+      const { FSREQCALLBACK } = getRequestLatency({ reset: true });
+      assert(FSREQCALLBACK.min > 0);
+      assert(FSREQCALLBACK.max >= FSREQCALLBACK.min);
+      assert.strictEqual(FSREQCALLBACK.exceeds, 0);
+      assert(FSREQCALLBACK.percentile(99) >= FSREQCALLBACK.min);
+      assert.deepStrictEqual(Object.keys(getRequestLatency()), []);
+
+      fs.promises.stat(__filename).then(common.mustCall(() => {
+        assert.deepStrictEqual(Object.keys(getRequestLatency()),
+                               ['FSREQPROMISE']);
+        stopRequestLatencyTracking();
+        assert.strictEqual(getRequestLatency(), undefined);
+      }));
+    }));
+  }
+}));
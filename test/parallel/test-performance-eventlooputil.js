@@ -0,0 +1,56 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance, getEventLoopPhaseTimes } = require('perf_hooks');
+
+const BUSY = 50;
+
+function spin(ms) {
+  const start = Date.now();
+  while (Date.now() - start < ms);
+}
+
+// The event loop has not started yet.
+assert.deepStrictEqual(performance.eventLoopUtilization(),
+                       { idle: 0, active: 0, utilization: 0 });
+assert.strictEqual(performance.nodeTiming.idleTime, 0);
+
+const start = getEventLoopPhaseTimes();
+assert.deepStrictEqual(Object.keys(start),
+                       ['timers', 'pollIdle', 'pollActive', 'check', 'other',
+                        'iterations']);
+for (const value of Object.values(start))
+  assert.strictEqual(value, 0);
+
+setTimeout(common.mustCall(() => {
+  // Only waiting for this timer so far.
+  const elu1 = performance.eventLoopUtilization();
+  assert(elu1.idle >= BUSY / 2, `${elu1.idle}`);
+  assert(elu1.utilization >= 0 && elu1.utilization <= 1);
+  assert.strictEqual(elu1.idle, performance.nodeTiming.idleTime);
+
+  spin(BUSY);
+  const elu2 = performance.eventLoopUtilization();
+  const delta = performance.eventLoopUtilization(elu2, elu1);
+  assert.strictEqual(delta.idle, 0);
+  assert(delta.active >= BUSY - 1, `${delta.active}`);
+  assert.strictEqual(delta.utilization, 1);
+  const sinceElu1 = performance.eventLoopUtilization(elu1);
+  assert.strictEqual(sinceElu1.idle, 0);
+  assert(sinceElu1.active >= delta.active);
+
+  const before = getEventLoopPhaseTimes();
+  assert(before.iterations > 0);
+  setImmediate(common.mustCall(() => {
+    spin(BUSY);
+    setTimeout(common.mustCall(() => {
+      const after = getEventLoopPhaseTimes();
+      // The time spent in the timer callback above, and in this immediate.
+      assert(after.timers - before.timers >= BUSY - 1, `${after.timers}`);
+      assert(after.check - before.check >= BUSY - 1, `${after.check}`);
+      assert(after.pollIdle > before.pollIdle);
+      assert(after.iterations > before.iterations);
+    }), BUSY);
+  }));
+}), BUSY);
@@ -0,0 +1,53 @@
+'use strict';
+
+// Verify that bare requests are found in any of the node_modules
+// directories above the requiring module, also when some of those
+// directories, or the packages in them, do not exist or are added later.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+tmpdir.refresh();
+
+function write(file, content) {
+  file = path.join(tmpdir.path, file);
+  fs.mkdirSync(path.dirname(file), { recursive: true });
+  fs.writeFileSync(file, content);
+}
+
+write('a/b/c/d/entry.js', `
+  exports.resolve = (request) => require.resolve(request);
+  exports.require = (request) => require(request);
+`);
+fs.mkdirSync(path.join(tmpdir.path, 'a/b/c/node_modules'));
+write('a/node_modules/foo.js', 'module.exports = "foo.js";');
+write('a/b/node_modules/bar/index.js', 'module.exports = "bar";');
+write('a/b/node_modules/bar/package.json', '{}');
+write('node_modules/@scope/pkg/lib/x.js', 'module.exports = "x";');
+write('node_modules/@scope/pkg/package.json', '{ "main": "lib/x.js" }');
+write('a/b/c/node_modules/baz.json', '{ "baz": true }');
+write('a/node_modules/dup.js', 'module.exports = "farther";');
+write('a/b/c/node_modules/dup/index.js', 'module.exports = "closer";');
+
+const entry = require(path.join(tmpdir.path, 'a/b/c/d/entry.js'));
+
+assert.strictEqual(entry.require('foo'), 'foo.js');
+assert.strictEqual(entry.require('bar'), 'bar');
+assert.strictEqual(entry.require('bar/index'), 'bar');
+assert.strictEqual(entry.require('bar/'), 'bar');
+assert.strictEqual(entry.require('@scope/pkg'), 'x');
+assert.strictEqual(entry.require('@scope/pkg/lib/x'), 'x');
+assert.deepStrictEqual(entry.require('baz'), { baz: true });
+assert.strictEqual(entry.require('dup'), 'closer');
+
+assert.throws(() => entry.resolve('missing'), { code: 'MODULE_NOT_FOUND' });
+assert.throws(() => entry.resolve('foo/sub'), { code: 'MODULE_NOT_FOUND' });
+assert.throws(() => entry.resolve('@scope/pkg/missing'),
+              { code: 'MODULE_NOT_FOUND' });
+
+// A package that is installed after a failed lookup is found by the next one.
+write('a/b/c/d/node_modules/missing/index.js', 'module.exports = "late";');
+assert.strictEqual(entry.require('missing'), 'late');
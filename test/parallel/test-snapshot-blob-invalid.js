@@ -0,0 +1,52 @@
+'use strict';
+
+// Verify that --snapshot-blob refuses files that it cannot start up from.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+function header(nodeVersion, v8Version) {
+  const fields = [Buffer.from('NODESNAP'), u32(1)];
+  for (const str of [nodeVersion, v8Version])
+    fields.push(u32(Buffer.byteLength(str)), Buffer.from(str));
+  return Buffer.concat(fields);
+}
+
+function u32(value) {
+  const buf = Buffer.alloc(4);
+  buf.writeUInt32LE(value);
+  return buf;
+}
+
+function check(file, expected) {
+  const child = spawnSync(process.execPath, [
+    `--snapshot-blob=${file}`,
+    '-e', 'console.log("started")',
+  ], { encoding: 'utf8' });
+  assert.strictEqual(child.status, 9);
+  assert.strictEqual(child.stdout, '');
+  assert.match(child.stderr, expected);
+}
+
+check(path.join(tmpdir.path, 'missing.blob'), /Cannot read snapshot blob/);
+
+const garbage = path.join(tmpdir.path, 'garbage.blob');
+fs.writeFileSync(garbage, 'this is not a snapshot');
+check(garbage, /Not a Node\.js snapshot blob/);
+
+const mismatch = path.join(tmpdir.path, 'mismatch.blob');
+fs.writeFileSync(mismatch, header('v0.0.0', '0.0.0.0'));
+check(mismatch, /was built by Node\.js v0\.0\.0 \(V8 0\.0\.0\.0\)/);
+
+const truncated = path.join(tmpdir.path, 'truncated.blob');
+fs.writeFileSync(truncated, Buffer.concat([
+  header(process.version, process.versions.v8),
+  u32(1000),
+]));
+check(truncated, /Snapshot blob is malformed/);
@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+// Timers with many different durations are kept in one list per duration.
+// Lists have to expire in order of their expiry time, also when they span
+// several levels of the timing wheel, and cleared lists must not expire.
+
+const durations = [];
+for (let i = 1; i <= 150; i++)
+  durations.push(i * 37 % 150 + 1);
+
+const fired = [];
+const timers = durations.map((ms) => {
+  return setTimeout(() => fired.push(ms), ms);
+});
+
+// Clear every third list.
+const cleared = new Set();
+for (let i = 0; i < timers.length; i += 3) {
+  clearTimeout(timers[i]);
+  cleared.add(durations[i]);
+}
+
+setTimeout(common.mustCall(() => {
+  const expected = durations.filter((ms) => !cleared.has(ms))
+                            .sort((a, b) => a - b);
+  assert.deepStrictEqual(fired, expected);
+  manyDueLists();
+}), 160);
+
+function manyDueLists() {
+  // More lists expire in one go than are passed to JS at a time, and their
+  // timers create more new lists than are queued before they are applied.
+  const count = 200;
+  const rescheduled = [];
+  const done = common.mustCall(() => {
+    assert.deepStrictEqual(rescheduled,
+                           Array.from({ length: count }, (_, i) => i + 1));
+  });
+  let ticks = 0;
+  for (let ms = 1; ms <= count; ms++) {
+    setTimeout(() => {
+      // The tick queue runs between lists, also across batches.
+      assert.strictEqual(ticks, ms - 1);
+      process.nextTick(() => ticks++);
+      setTimeout(() => {
+        if (rescheduled.push(ms) === count)
+          done();
+      }, 1000 + ms);
+    }, ms);
+  }
+  // Block the event loop until all of them are due.
+  const start = Date.now();
+  while (Date.now() - start < count + 50);
+}
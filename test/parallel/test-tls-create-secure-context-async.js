@@ -0,0 +1,91 @@
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Verify tls.createSecureContextAsync(), which builds the CA store on the
+// threadpool.
+
+const fixtures = require('../common/fixtures');
+const {
+  assert, connect, keys, tls
+} = require(fixtures.path('tls-connect'));
+
+function pemToDer(pem) {
+  const body = pem.toString()
+    .replace(/-----(BEGIN|END) CERTIFICATE-----/g, '')
+    .replace(/\s+/g, '');
+  return Buffer.from(body, 'base64');
+}
+
+function testConnect(ca) {
+  return tls.createSecureContextAsync({ ca }).then(common.mustCall((ctx) => {
+    assert(ctx instanceof tls.SecureContext);
+    connect({
+      client: {
+        servername: 'agent1',
+        secureContext: ctx,
+      },
+      server: {
+        cert: keys.agent1.cert,
+        key: keys.agent1.key,
+      },
+    }, common.mustCall((err, pair, cleanup) => {
+      assert.ifError(err);
+      return cleanup();
+    }));
+  }));
+}
+
+// PEM as string, PEM as Buffer and DER.
+testConnect(keys.agent1.ca);
+testConnect(Buffer.from(keys.agent1.ca));
+testConnect([keys.agent2.ca, pemToDer(keys.agent1.ca)]);
+// PEM preceded by text that starts with the DER SEQUENCE tag ('0' is 0x30).
+testConnect(`0 explanatory text\n${keys.agent1.ca}`);
+
+// The wrong CA does not authorize the server.
+tls.createSecureContextAsync({ ca: keys.agent2.ca })
+  .then(common.mustCall((ctx) => {
+    connect({
+      client: {
+        servername: 'agent1',
+        secureContext: ctx,
+      },
+      server: {
+        cert: keys.agent1.cert,
+        key: keys.agent1.key,
+      },
+    }, common.mustCall((err, pair, cleanup) => {
+      assert.strictEqual(err.code, 'UNABLE_TO_VERIFY_LEAF_SIGNATURE');
+      return cleanup();
+    }));
+  }));
+
+// Without `ca`, the shared root store is used.
+tls.createSecureContextAsync().then(common.mustCall((ctx) => {
+  assert(ctx instanceof tls.SecureContext);
+}));
+
+// Malformed DER is rejected.
+assert.rejects(
+  tls.createSecureContextAsync({ ca: Buffer.from([0x30, 0x03, 0x01]) }),
+  (err) => {
+    assert(err instanceof Error);
+    assert.match(err.message, /^error:[0-9A-F]+:asn1 encoding routines:/);
+    assert.match(err.message, /:ASN1_get_object:too long$/);
+    return true;
+  }
+).then(common.mustCall());
+
+assert.rejects(
+  tls.createSecureContextAsync({ ca: 42 }),
+  { code: 'ERR_INVALID_ARG_TYPE' }
+).then(common.mustCall());
+
+// Options other than `ca` are still validated after the store is built.
+assert.rejects(
+  tls.createSecureContextAsync({ ca: keys.agent1.ca, sigalgs: '' }),
+  { code: 'ERR_INVALID_OPT_VALUE' }
+).then(common.mustCall());
@@ -0,0 +1,56 @@
+'use strict';
+
+// Verify that Workers share the code cache of the modules that they load, and
+// that a module whose source code has changed is compiled from scratch.
+
+require('../common');
+const tmpdir = require('../common/tmpdir');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+tmpdir.refresh();
+
+const main = path.join(tmpdir.path, 'main.js');
+const dep = path.join(tmpdir.path, 'dep.js');
+const esm = path.join(tmpdir.path, 'worker.mjs');
+
+fs.writeFileSync(dep, 'module.exports = (x) => x + 1;');
+fs.writeFileSync(esm, 'import dep from "./dep.js"; console.log(dep(2));');
+const evalDep = `console.log(require(${JSON.stringify(dep)})(1))`;
+const changeDep =
+  `fs.writeFileSync(${JSON.stringify(dep)}, 'module.exports = (x) => x * 10;')`;
+fs.writeFileSync(main, `
+  const fs = require('fs');
+  const { Worker } = require('worker_threads');
+  const steps = [
+    () => new Worker(${JSON.stringify(evalDep)}, { eval: true }),
+    () => new Worker(${JSON.stringify(evalDep)}, { eval: true }),
+    () => new Worker(${JSON.stringify(esm)}),
+    () => new Worker(${JSON.stringify(esm)}),
+    () => {
+      ${changeDep};
+      return new Worker(${JSON.stringify(evalDep)}, { eval: true });
+    },
+  ];
+  (function next() {
+    const step = steps.shift();
+    if (step) step().on('exit', next);
+  })();
+`);
+
+const child = spawnSync(process.execPath, [main], {
+  env: { ...process.env, NODE_DEBUG_NATIVE: 'CODE_CACHE' },
+  encoding: 'utf8',
+});
+assert.strictEqual(child.status, 0, child.stderr);
+assert.strictEqual(child.stdout, '2\n2\n3\n3\n10\n');
+
+const shared = child.stderr.match(/\[compile cache\] shared \d+ bytes/g) || [];
+const used = child.stderr.match(/\[compile cache\] using shared cache/g) || [];
+// dep.js, worker.mjs and the changed dep.js are each compiled only once.
+assert.strictEqual(shared.length, 3, child.stderr);
+// The second, third and fourth Worker reuse dep.js, and the fourth one also
+// reuses worker.mjs.
+assert.strictEqual(used.length, 4, child.stderr);
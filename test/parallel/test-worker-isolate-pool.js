@@ -0,0 +1,93 @@
+// Flags: --worker-isolate-pool-size=2 --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { spawnSync } = require('child_process');
+const { Worker } = require('worker_threads');
+const { internalBinding } = require('internal/test/binding');
+const { getIsolatePoolStats } = internalBinding('worker');
+
+function getStats() {
+  const { 0: ready, 1: hits, 2: misses } = getIsolatePoolStats();
+  return { ready, hits, misses };
+}
+
+// The pool is filled on the threadpool, so wait until both Isolates are there.
+function whenReady(callback) {
+  if (getStats().ready === 2)
+    return callback();
+  setTimeout(whenReady, 10, callback);
+}
+
+whenReady(common.mustCall(() => {
+  assert.deepStrictEqual(getStats(), { ready: 2, hits: 0, misses: 0 });
+
+  // Workers work the same way whether they get an Isolate from the pool or
+  // create their own, which happens once more are started than the pool
+  // holds.
+  const count = 6;
+  const limits = [];
+  for (let i = 0; i < count; i++) {
+    const w = new Worker(`
+      const { parentPort, resourceLimits } = require('worker_threads');
+      parentPort.postMessage({ argv: process.argv.slice(2), resourceLimits });
+    `, { eval: true, argv: [i] });
+    w.on('message', common.mustCall(({ argv, resourceLimits }) => {
+      assert.deepStrictEqual(argv, [`${i}`]);
+      assert(resourceLimits.maxOldGenerationSizeMb > 0);
+      limits.push(resourceLimits);
+      if (limits.length === count)
+        limits.forEach((l) => assert.deepStrictEqual(l, limits[0]));
+    }));
+    w.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+    }));
+  }
+
+  // The two Isolates that were ready have been taken, and the replacements
+  // are still being created.
+  const stats = getStats();
+  assert.strictEqual(stats.hits + stats.misses, count);
+  assert(stats.hits >= 2, `${stats.hits} hits`);
+
+  {
+    // Workers with their own resource limits never use the pool.
+    const resourceLimits = { maxOldGenerationSizeMb: 16 };
+    const w = new Worker(`
+      const { parentPort, resourceLimits } = require('worker_threads');
+      parentPort.postMessage(resourceLimits.maxOldGenerationSizeMb);
+    `, { eval: true, resourceLimits });
+    w.on('message', common.mustCall((size) => {
+      assert.strictEqual(size, 16);
+    }));
+    const { hits, misses } = getStats();
+    assert.strictEqual(hits + misses, count);
+  }
+
+  {
+    // Workers can still be terminated before they have started running code.
+    const w = new Worker('setInterval(() => {}, 100);', { eval: true });
+    w.terminate().then(common.mustCall());
+  }
+
+  {
+    // Only the main thread has a pool.
+    const w = new Worker(`
+      const { internalBinding } = require('internal/test/binding');
+      const { parentPort } = require('worker_threads');
+      parentPort.postMessage(internalBinding('worker').getIsolatePoolStats());
+    `, { eval: true, execArgv: ['--expose-internals'] });
+    w.on('message', common.mustCall((stats) => {
+      assert.strictEqual(stats, undefined);
+    }));
+  }
+}));
+
+{
+  const child = spawnSync(process.execPath,
+                          [ '--worker-isolate-pool-size=-1', '-p', '42' ]);
+  assert.strictEqual(child.status, 9);
+  assert.strictEqual(child.signal, null);
+  assert.strictEqual(child.stderr.toString().match(/\S+/g).slice(1).join(' '),
+                     '--worker-isolate-pool-size must not be negative');
+}
@@ -0,0 +1,140 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const {
+  MessageChannel,
+  Worker,
+  receiveMessageOnPort
+} = require('worker_threads');
+
+// Primitives, and plain objects and arrays of primitives, are sent in a
+// simpler format than other values. Make sure that both formats produce the
+// same results as the structured clone algorithm.
+
+const { port1, port2 } = new MessageChannel();
+
+function roundTrip(value) {
+  port1.postMessage(value);
+  return receiveMessageOnPort(port2).message;
+}
+
+{
+  const values = [
+    undefined, null, true, false,
+    0, -1, 2 ** 31 - 1, -(2 ** 31), 2 ** 31, 0.5, NaN, Infinity, -Infinity,
+    '', 'hello world!', 'äöü', '\u{1f600}', 'x'.repeat(100000),
+    [], [1, 'two', 3.5, null, undefined, true], ['ä', '☃', ''],
+    {}, { action: 'pewpewpew', powerLevel: 9001 },
+    { 0: 'zero', 10: 'ten', a: 1, b: '☃' },
+    // Values that contain nested objects.
+    [[1], [2]], { a: { b: 'c' } }, { list: [1, 2, 3] },
+    // Values that are not plain objects.
+    new Date(0), /abc/g, new Map([[1, 2]]), new Set([1]),
+    Object(1), Object('string'), new Uint8Array([1, 2, 3]), 10n,
+  ];
+  for (const value of values) {
+    const received = roundTrip(value);
+    assert.deepStrictEqual(received, value);
+    if (typeof value === 'object' && value !== null)
+      assert.notStrictEqual(received, value);
+  }
+
+  assert(Object.is(roundTrip(-0), -0));
+  assert(Object.is(roundTrip([-0])[0], -0));
+  assert(Object.is(roundTrip({ zero: -0 }).zero, -0));
+  assert.deepStrictEqual(Object.keys(roundTrip({ b: 1, a: 2, 1: 3, 0: 4 })),
+                         ['0', '1', 'b', 'a']);
+}
+
+{
+  // Holes and other properties of arrays are kept.
+  const sparse = [1, , 3];  // eslint-disable-line no-sparse-arrays
+  const received = roundTrip(sparse);
+  assert.strictEqual(received.length, 3);
+  assert(!(1 in received));
+
+  const named = [1, 2];
+  named.extra = 'yes';
+  assert.strictEqual(roundTrip(named).extra, 'yes');
+
+  const long = [];
+  long.length = 5;
+  assert.strictEqual(roundTrip(long).length, 5);
+}
+
+{
+  // Class instances and objects without a prototype become plain objects,
+  // and only own enumerable properties are copied.
+  class Foo { constructor() { this.bar = 1; } }
+  Foo.prototype.baz = 2;
+  const foo = roundTrip(new Foo());
+  assert.strictEqual(Object.getPrototypeOf(foo), Object.prototype);
+  assert.deepStrictEqual(foo, { bar: 1 });
+
+  const noProto = Object.assign(Object.create(null), { a: 1 });
+  const received = roundTrip(noProto);
+  assert.strictEqual(Object.getPrototypeOf(received), Object.prototype);
+  assert.deepStrictEqual(received, { a: 1 });
+
+  const hidden = { visible: 1 };
+  Object.defineProperty(hidden, 'hidden', { value: 2, enumerable: false });
+  hidden[Symbol('symbol')] = 3;
+  assert.deepStrictEqual(roundTrip(hidden), { visible: 1 });
+}
+
+{
+  // Getters are invoked exactly once, also when their value is an object
+  // that the simpler format does not support.
+  for (const result of ['string', { nested: true }]) {
+    let calls = 0;
+    const object = {
+      before: 1,
+      get value() { calls++; return result; },
+      after: 2
+    };
+    assert.deepStrictEqual(roundTrip(object),
+                           { before: 1, value: result, after: 2 });
+    assert.strictEqual(calls, 1);
+
+    calls = 0;
+    const array = [1, 2];
+    Object.defineProperty(array, 1, {
+      get() { calls++; return result; },
+      enumerable: true
+    });
+    assert.deepStrictEqual(roundTrip(array), [1, result]);
+    assert.strictEqual(calls, 1);
+  }
+}
+
+{
+  // Unsupported values still throw.
+  assert.throws(() => port1.postMessage({ a: Symbol('a') }), {
+    name: 'DataCloneError'
+  });
+  assert.throws(() => port1.postMessage({ a() {} }), {
+    name: 'DataCloneError'
+  });
+  assert.strictEqual(receiveMessageOnPort(port2), undefined);
+}
+
+port1.close();
+
+{
+  // A burst of messages from another thread arrives completely and in order.
+  const count = 10000;
+  const worker = new Worker(`
+    const { parentPort } = require('worker_threads');
+    for (let i = 0; i < ${count}; i++)
+      parentPort.postMessage(i % 2 ? { i } : [i, 'x']);
+  `, { eval: true });
+
+  let expected = 0;
+  worker.on('message', common.mustCall((message) => {
+    const i = expected++;
+    assert.deepStrictEqual(message, i % 2 ? { i } : [i, 'x']);
+  }, count));
+  worker.on('exit', common.mustCall(() => {
+    assert.strictEqual(expected, count);
+  }));
+}
@@ -0,0 +1,123 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { RingChannel, Worker } = require('worker_threads');
+
+{
+  [63, 100, 2 ** 31].forEach((size) => {
+    assert.throws(() => new RingChannel(size), {
+      code: /^ERR_(OUT_OF_RANGE|INVALID_ARG_VALUE)$/
+    });
+  });
+  [undefined, '64', new ArrayBuffer(80)].forEach((value) => {
+    assert.throws(() => new RingChannel(value), {
+      code: 'ERR_INVALID_ARG_TYPE'
+    });
+  });
+  assert.throws(() => new RingChannel(new SharedArrayBuffer(64)), {
+    code: 'ERR_INVALID_ARG_VALUE'
+  });
+}
+
+{
+  // Records are returned in order, including when they wrap around the end
+  // of the ring, and writes fail while the ring is full.
+  const channel = new RingChannel(64);
+  assert.strictEqual(channel.read(), undefined);
+  assert.throws(() => channel.write(Buffer.alloc(61)), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => channel.write(42), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.strictEqual(channel.write(Buffer.alloc(60, 1)), true);
+  assert.strictEqual(channel.write(''), false);
+  assert.deepStrictEqual(channel.read(), Buffer.alloc(60, 1));
+  assert.strictEqual(channel.read(), undefined);
+
+  let written = 0;
+  let read = 0;
+  for (let i = 0; i < 1000; i++) {
+    if (channel.write(Buffer.alloc(i % 23, written & 0xff)))
+      written++;
+    if (i % 3 === 0) {
+      let record;
+      while ((record = channel.read()) !== undefined) {
+        assert(record.every((byte) => byte === (read & 0xff)));
+        read++;
+      }
+    }
+  }
+  while (channel.read() !== undefined)
+    read++;
+  assert.strictEqual(read, written);
+
+  channel.write('☃');
+  channel.write(new Uint16Array([1, 2]));
+  channel.write(new Uint8Array([1, 2, 3]).buffer);
+  assert.strictEqual(channel.read().toString(), '☃');
+  assert.deepStrictEqual(channel.read(), Buffer.from(new Uint16Array([1, 2])
+    .buffer));
+  assert.deepStrictEqual(channel.read(), Buffer.from([1, 2, 3]));
+
+  assert.strictEqual(channel.readSync(0), undefined);
+  assert.throws(() => channel.readSync(-1), { code: 'ERR_OUT_OF_RANGE' });
+}
+
+{
+  // Records written by a Worker arrive as 'message' events, in order.
+  const count = 10000;
+  const channel = new RingChannel(1024);
+  let received = 0;
+  channel.on('message', common.mustCall((record) => {
+    assert.strictEqual(record.toString(), `record ${received++}`);
+    if (received === count)
+      channel.close();
+  }, count));
+
+  new Worker(`
+    const { RingChannel, workerData } = require('worker_threads');
+    const channel = new RingChannel(workerData);
+    let i = 0;
+    (function write() {
+      while (i < ${count} && channel.write('record ' + i))
+        i++;
+      if (i < ${count})
+        setImmediate(write);
+    })();
+  `, { eval: true, workerData: channel.buffer });
+}
+
+{
+  // A Worker can block until records arrive.
+  const count = 10000;
+  const channel = new RingChannel(256);
+  const worker = new Worker(`
+    const { RingChannel, parentPort, workerData } = require('worker_threads');
+    const channel = new RingChannel(workerData);
+    let sum = 0;
+    for (let i = 0; i < ${count}; i++)
+      sum += channel.readSync().readUInt32LE(0);
+    parentPort.postMessage(sum);
+  `, { eval: true, workerData: channel.buffer });
+
+  let i = 0;
+  (function write() {
+    for (; i < count; i++) {
+      const record = Buffer.alloc(4 + i % 7);
+      record.writeUInt32LE(i);
+      if (!channel.write(record))
+        return setImmediate(write);
+    }
+  })();
+  worker.on('message', common.mustCall((sum) => {
+    assert.strictEqual(sum, count * (count - 1) / 2);
+  }));
+}
+
+{
+  // An unref()ed channel does not keep the event loop alive.
+  const channel = new RingChannel(64);
+  channel.unref();
+  channel.on('message', common.mustNotCall());
+}
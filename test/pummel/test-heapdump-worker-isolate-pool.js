@@ -0,0 +1,30 @@
+// Flags: --expose-internals --worker-isolate-pool-size=2
+'use strict';
+require('../common');
+const { validateSnapshotNodes } = require('../common/heap');
+const { internalBinding } = require('internal/test/binding');
+const { buildEmbedderGraph } = internalBinding('heap_utils');
+
+// The pool is filled in the background, so wait until it has been.
+(function waitForPool() {
+  const parked = buildEmbedderGraph()
+    .filter((node) => node.name === 'Node / WarmIsolate');
+  if (parked.length < 2)
+    return setTimeout(waitForPool, 10);
+
+  validateSnapshotNodes('Node / Environment', [
+    {
+      children: [
+        { node_name: 'Node / WorkerIsolatePool',
+          edge_name: 'worker_isolate_pool' }
+      ]
+    }
+  ], { loose: true });
+  validateSnapshotNodes('Node / WorkerIsolatePool', [
+    {
+      children: [
+        { node_name: 'Node / WarmIsolate', edge_name: 'isolate' }
+      ]
+    }
+  ]);
+})();
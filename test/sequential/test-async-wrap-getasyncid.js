@@ -129,6 +129,9 @@ if (common.hasCrypto) { // eslint-disable-line node-core/crypto-check
     testInitialized(this, 'AsyncWrap');
   }));
 
+  // CERTSTOREREQUEST is internal to createSecureContextAsync().
+  require('tls').createSecureContextAsync().then(common.mustCall());
+
   if (typeof internalBinding('crypto').scrypt === 'function') {
     crypto.scrypt('password', 'salt', 8, common.mustCall(function() {
       testInitialized(this, 'AsyncWrap');
@@ -315,3 +318,11 @@ if (process.features.inspector && common.isMainThread) {
   const handle = dirBinding.opendir('./', 'utf8', undefined, {});
   testInitialized(handle, 'DirHandle');
 }
+
+// RINGCHANNEL
+{
+  const { RingChannelWaker } = internalBinding('messaging');
+  const handle = new RingChannelWaker();
+  testInitialized(handle, 'RingChannelWaker');
+  handle.close();
+}
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -7,6 +8,7 @@
 
 #include "libplatform/libplatform.h"
 #include "node_internals.h"
+#include "node_snapshot_blob.h"
 #include "snapshot_builder.h"
 #include "util-inl.h"
 #include "v8.h"
@@ -21,17 +23,18 @@ int main(int argc, char* argv[]) {
 
   v8::V8::SetFlagsFromString("--random_seed=42");
 
-  if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <path/to/output.cc>\n";
-    return 1;
-  }
-
-  std::ofstream out;
-  out.open(argv[1], std::ios::out | std::ios::binary);
-  if (!out.is_open()) {
-    std::cerr << "Cannot open " << argv[1] << "\n";
+  // With --blob, the snapshot is written in the format that --snapshot-blob
+  // loads at runtime instead of as C++ source.
+#ifdef _WIN32
+  bool write_blob = argc == 3 && wcscmp(argv[1], L"--blob") == 0;
+#else
+  bool write_blob = argc == 3 && strcmp(argv[1], "--blob") == 0;
+#endif  // _WIN32
+  if (argc != 2 && !write_blob) {
+    std::cerr << "Usage: " << argv[0] << " [--blob] <path/to/output>\n";
     return 1;
   }
+  auto output = argv[argc - 1];
 
   int node_argc = 1;
   char argv0[] = "node";
@@ -42,13 +45,28 @@ int main(int argc, char* argv[]) {
   CHECK(!result.early_return);
   CHECK_EQ(result.exit_code, 0);
 
-  {
-    std::string snapshot =
-        node::SnapshotBuilder::Generate(result.args, result.exec_args);
+  std::string snapshot;
+  if (write_blob) {
+    node::SnapshotBlob blob;
+    node::SnapshotBuilder::Generate(&blob, result.args, result.exec_args);
+    snapshot = blob.Serialize();
+  } else {
+    snapshot = node::SnapshotBuilder::Generate(result.args, result.exec_args);
+  }
+
+  // The output is only touched once the snapshot has been created, so that
+  // a failed run does not leave a truncated file behind.
+  int exit_code = 0;
+  std::ofstream out;
+  out.open(output, std::ios::out | std::ios::binary);
+  if (out.is_open()) {
     out << snapshot;
     out.close();
+  } else {
+    std::cerr << "Cannot open " << output << "\n";
+    exit_code = 1;
   }
 
   node::TearDownOncePerProcess();
-  return 0;
+  return exit_code;
 }
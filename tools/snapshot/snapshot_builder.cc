@@ -3,6 +3,7 @@
 #include <sstream>
 #include "node_internals.h"
 #include "node_main_instance.h"
+#include "node_snapshot_blob.h"
 #include "node_v8_platform-inl.h"
 
 namespace node {
@@ -20,8 +21,10 @@ void WriteVector(std::stringstream* ss, const T* vec, size_t size) {
   }
 }
 
-std::string FormatBlob(v8::StartupData* blob,
-                       const std::vector<size_t>& isolate_data_indexes) {
+std::string FormatBlob(SnapshotBlob* snapshot) {
+  const StartupData* blob = snapshot->startup_data();
+  const std::vector<size_t>& isolate_data_indexes =
+      *snapshot->isolate_data_indexes();
   std::stringstream ss;
 
   ss << R"(#include <cstddef>
@@ -63,6 +66,14 @@ const std::vector<size_t>* NodeMainInstance::GetIsolateDataIndexes() {
 std::string SnapshotBuilder::Generate(
     const std::vector<std::string> args,
     const std::vector<std::string> exec_args) {
+  SnapshotBlob snapshot;
+  Generate(&snapshot, args, exec_args);
+  return FormatBlob(&snapshot);
+}
+
+void SnapshotBuilder::Generate(SnapshotBlob* out,
+                               const std::vector<std::string> args,
+                               const std::vector<std::string> exec_args) {
   // TODO(joyeecheung): collect external references and set it in
   // params.external_references.
   std::vector<intptr_t> external_references = {
@@ -71,7 +82,6 @@ std::string SnapshotBuilder::Generate(
   per_process::v8_platform.Platform()->RegisterIsolate(isolate,
                                                        uv_default_loop());
   std::unique_ptr<NodeMainInstance> main_instance;
-  std::string result;
 
   {
     std::vector<size_t> isolate_data_indexes;
@@ -98,11 +108,10 @@ std::string SnapshotBuilder::Generate(
     // Must be done while the snapshot creator isolate is entered i.e. the
     // creator is still alive.
     main_instance->Dispose();
-    result = FormatBlob(&blob, isolate_data_indexes);
+    out->Assign(blob, isolate_data_indexes);
     delete[] blob.data;
   }
 
   per_process::v8_platform.Platform()->UnregisterIsolate(isolate);
-  return result;
 }
 }  // namespace node
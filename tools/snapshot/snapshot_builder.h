@@ -5,10 +5,19 @@
 #include <vector>
 
 namespace node {
+class SnapshotBlob;
+
 class SnapshotBuilder {
  public:
+  // Returns C++ source code that embeds the snapshot into the binary.
   static std::string Generate(const std::vector<std::string> args,
                               const std::vector<std::string> exec_args);
+
+  // Stores the snapshot in `out`, to be written to a file that is loaded
+  // with --snapshot-blob.
+  static void Generate(SnapshotBlob* out,
+                       const std::vector<std::string> args,
+                       const std::vector<std::string> exec_args);
 };
 }  // namespace node
 